@@ -0,0 +1,48 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include "../include/AsyncBus.h"
+#include "../include/ModuleSimulator.h"
+
+// Built with make COROUTINES=1 only
+#if defined(__linux__) && defined(__cpp_impl_coroutine)
+#include <sys/socket.h>
+
+namespace {
+    AsyncTask readModule(AsyncBus& bus, uint8_t address, uint64_t& sum) {
+        const auto voltage = co_await bus.readVoltage(address, std::chrono::milliseconds(100));
+        if (voltage) sum += voltage->value;
+    }
+}
+
+// Conversations reading one module each, modules served in the same thread
+static void BM_AsyncBusConversations(benchmark::State& state) {
+    const size_t conversations = static_cast<size_t>(state.range(0));
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) != 0) {
+        state.SkipWithError("socketpair failed");
+        return;
+    }
+    CanTransport local(fds[0]);
+    CanTransport remote(fds[1]);
+    local.start();
+    remote.start();
+    ModuleSimulator::Config config;
+    config.latency = ModuleSimulator::Clock::duration::zero();
+    ModuleSimulator fleet(ProtocolType::UUgreen, 0, MODULE_ADDRESS_COUNT, config);
+    AsyncBus bus(local, ProtocolType::UUgreen);
+    uint64_t sum = 0;
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < conversations; ++i) readModule(bus, static_cast<uint8_t>(i % MODULE_ADDRESS_COUNT), sum);
+        while (bus.suspended()) {
+            fleet.serve(remote, ModuleSimulator::Clock::now());
+            bus.runOnce(0);
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * conversations);
+    state.counters["requests_per_cycle"] = benchmark::Counter(
+        static_cast<double>(bus.stats().requests), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_AsyncBusConversations)->Arg(128)->Arg(4096)->UseRealTime();
+#endif
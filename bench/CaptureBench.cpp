@@ -0,0 +1,83 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+#include "../include/CanCapture.h"
+
+namespace {
+    constexpr size_t BURST = 64;     // One recvmmsg burst of CanTransport
+
+    std::vector<can_frame> makeBurst() {
+        std::vector<can_frame> frames(BURST);
+        for (size_t i = 0; i < BURST; ++i)
+            frames[i] = make_frame(CAN_INV_EFF_FLAG | UUGREEN_MASK | (i % 128) << 14,
+                                   UUgreenConstants::PREAMBLE, UUgreenConstants::VOLTAGE_CMD, 0, 0, 0, 0, 0, byte_of(i, 0));
+        return frames;
+    }
+}
+
+// Lower bound: copying the received frames somewhere else
+static void BM_CaptureMemcpyBaseline(benchmark::State& state) {
+    const std::vector<can_frame> burst = makeBurst();
+    std::vector<can_frame> sink(BURST * 256);
+    size_t offset = 0;
+    for (auto _ : state) {
+        std::memcpy(&sink[offset], burst.data(), BURST * sizeof(can_frame));
+        offset = (offset + BURST) % sink.size();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * BURST);
+}
+BENCHMARK(BM_CaptureMemcpyBaseline);
+
+// Appending RX bursts; blocks go to /dev/null so only the capture path is timed
+static void BM_CaptureAppend(benchmark::State& state) {
+    const std::vector<can_frame> burst = makeBurst();
+    CaptureWriter writer;
+    if (!writer.open("/dev/null", ProtocolType::UUgreen)) {
+        state.SkipWithError("cannot open /dev/null");
+        return;
+    }
+    uint64_t now = 0;
+    for (auto _ : state) {
+        writer.append(burst.data(), BURST, ++now);
+    }
+    state.SetItemsProcessed(state.iterations() * BURST);
+}
+BENCHMARK(BM_CaptureAppend);
+
+// Mapped capture straight into the batch parser
+static void BM_CaptureReadParse(benchmark::State& state) {
+    constexpr size_t FRAMES = 100000;
+    char path[] = "/tmp/libmodul_bench_XXXXXX";
+    const int fd = ::mkstemp(path);
+    if (fd < 0) {
+        state.SkipWithError("cannot create capture");
+        return;
+    }
+    ::close(fd);
+    const std::vector<can_frame> burst = makeBurst();
+    CaptureWriter writer;
+    writer.open(path, ProtocolType::UUgreen);
+    for (size_t i = 0; i < FRAMES / BURST; ++i) writer.append(burst.data(), BURST, i);
+    writer.close();
+
+    CaptureReader reader;
+    reader.open(path);
+    CanParser parser;
+    TelemetryRecord records[CaptureFormat::DEFAULT_BLOCK_FRAMES];
+    size_t frames = 0;
+    for (auto _ : state) {
+        reader.rewind();
+        CaptureSpan span;
+        while (reader.next(span)) {
+            frames += span.count;
+            benchmark::DoNotOptimize(parser.parseRecords(span.frames, span.count, ProtocolType::UUgreen, records));
+        }
+    }
+    state.SetItemsProcessed(frames);
+    reader.close();
+    ::unlink(path);
+}
+BENCHMARK(BM_CaptureReadParse)->Unit(benchmark::kMillisecond);
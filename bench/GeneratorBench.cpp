@@ -0,0 +1,187 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include "../libmodul.h"
+
+namespace {
+    constexpr size_t MODULE_COUNT = 128;
+}
+
+// One virtual call per frame through the manager
+static void BM_RequestSingleFrame(benchmark::State& state, ProtocolType protocol) {
+    CanProtocolManager manager(protocol);
+    can_frame frames[MODULE_COUNT];
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < MODULE_COUNT; ++i) {
+            frames[i] = manager.generateVoltageRequest(static_cast<uint8_t>(i));
+        }
+        benchmark::DoNotOptimize(frames);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MODULE_COUNT);
+}
+BENCHMARK_CAPTURE(BM_RequestSingleFrame, UUgreen, ProtocolType::UUgreen);
+BENCHMARK_CAPTURE(BM_RequestSingleFrame, MMeet, ProtocolType::MMeet);
+
+// One virtual call per address list
+static void BM_RequestBatch(benchmark::State& state, ProtocolType protocol) {
+    CanProtocolManager manager(protocol);
+    can_frame frames[MODULE_COUNT];
+    uint8_t addresses[MODULE_COUNT];
+    for (size_t i = 0; i < MODULE_COUNT; ++i) addresses[i] = static_cast<uint8_t>(i);
+
+    for (auto _ : state) {
+        manager.generateRequestBatch(RequestType::Voltage, addresses, MODULE_COUNT, frames);
+        benchmark::DoNotOptimize(frames);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MODULE_COUNT);
+}
+BENCHMARK_CAPTURE(BM_RequestBatch, UUgreen, ProtocolType::UUgreen);
+BENCHMARK_CAPTURE(BM_RequestBatch, MMeet, ProtocolType::MMeet);
+
+// One virtual call per address range
+static void BM_RequestRange(benchmark::State& state, ProtocolType protocol) {
+    CanProtocolManager manager(protocol);
+    can_frame frames[MODULE_COUNT];
+
+    for (auto _ : state) {
+        manager.generateRequestRange(RequestType::Voltage, 0, MODULE_COUNT, frames);
+        benchmark::DoNotOptimize(frames);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MODULE_COUNT);
+}
+BENCHMARK_CAPTURE(BM_RequestRange, UUgreen, ProtocolType::UUgreen);
+BENCHMARK_CAPTURE(BM_RequestRange, MMeet, ProtocolType::MMeet);
+
+namespace {
+    enum class GeneratorCall {
+        TempRequest, CurrentCapabilityRequest, FlagsRequest, VoltageRequest, CurrentRequest,
+        LowModeSet, HighModeSet, AutoModeSet, VoltageSet, CurrentSet, Enable, Disable
+    };
+
+    template <GeneratorCall Call, typename Generator>
+    can_frame generate(Generator& generator, uint8_t address, float value) {
+        switch(Call) {
+            case GeneratorCall::TempRequest: return generator.generateTempRequest(address);
+            case GeneratorCall::CurrentCapabilityRequest: return generator.generateCurrentCapabilityRequest(address);
+            case GeneratorCall::FlagsRequest: return generator.generateFlagsRequest(address);
+            case GeneratorCall::VoltageRequest: return generator.generateVoltageRequest(address);
+            case GeneratorCall::CurrentRequest: return generator.generateCurrentRequest(address);
+            case GeneratorCall::LowModeSet: return generator.generateLowModeSet(address);
+            case GeneratorCall::HighModeSet: return generator.generateHighModeSet(address);
+            case GeneratorCall::AutoModeSet: return generator.generateAutoModeSet(address).value_or(can_frame{});
+            case GeneratorCall::VoltageSet: return generator.generateVoltageSet(address, value);
+            case GeneratorCall::CurrentSet: return generator.generateCurrentSet(address, value);
+            case GeneratorCall::Enable: return generator.generateEnable(address);
+            case GeneratorCall::Disable: return generator.generateDisable(address);
+        }
+        return can_frame{};
+    }
+}
+
+// Every generate* method on the concrete generator, no manager in between
+template <typename Generator, GeneratorCall Call>
+static void BM_Generate(benchmark::State& state) {
+    Generator generator;
+    can_frame frames[MODULE_COUNT];
+    float value = 400.0f;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value);
+        for (size_t i = 0; i < MODULE_COUNT; ++i) {
+            frames[i] = generate<Call>(generator, static_cast<uint8_t>(i), value);
+        }
+        benchmark::DoNotOptimize(frames);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MODULE_COUNT);
+}
+
+#define BENCHMARK_GENERATE(Call) \
+    BENCHMARK_TEMPLATE(BM_Generate, UUgreenFrameGenerator, GeneratorCall::Call)->Name("BM_Generate/UUgreen/" #Call); \
+    BENCHMARK_TEMPLATE(BM_Generate, MMeetFrameGenerator, GeneratorCall::Call)->Name("BM_Generate/MMeet/" #Call)
+
+BENCHMARK_GENERATE(TempRequest);
+BENCHMARK_GENERATE(CurrentCapabilityRequest);
+BENCHMARK_GENERATE(FlagsRequest);
+BENCHMARK_GENERATE(VoltageRequest);
+BENCHMARK_GENERATE(CurrentRequest);
+BENCHMARK_GENERATE(LowModeSet);
+BENCHMARK_GENERATE(HighModeSet);
+BENCHMARK_GENERATE(AutoModeSet);
+BENCHMARK_GENERATE(VoltageSet);
+BENCHMARK_GENERATE(CurrentSet);
+BENCHMARK_GENERATE(Enable);
+BENCHMARK_GENERATE(Disable);
+
+// Same voltage on every module: one set frame per address vs one broadcast frame
+static void BM_VoltageFanOutUnicast(benchmark::State& state, ProtocolType protocol) {
+    CanProtocolManager manager(protocol);
+    can_frame frames[MODULE_COUNT];
+    float value = 400.0f;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value);
+        for (size_t i = 0; i < MODULE_COUNT; ++i) {
+            frames[i] = manager.generateVoltageSet(static_cast<uint8_t>(i), value);
+        }
+        benchmark::DoNotOptimize(frames);
+        benchmark::ClobberMemory();
+    }
+    state.counters["frames_per_update"] = MODULE_COUNT;
+}
+BENCHMARK_CAPTURE(BM_VoltageFanOutUnicast, UUgreen, ProtocolType::UUgreen);
+BENCHMARK_CAPTURE(BM_VoltageFanOutUnicast, MMeet, ProtocolType::MMeet);
+
+static void BM_VoltageFanOutBroadcast(benchmark::State& state, ProtocolType protocol) {
+    CanProtocolManager manager(protocol);
+    can_frame frame;
+    float value = 400.0f;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value);
+        frame = manager.generateGroupVoltageSet(BROADCAST_GROUP, value);
+        benchmark::DoNotOptimize(frame);
+        benchmark::ClobberMemory();
+    }
+    state.counters["frames_per_update"] = 1;
+}
+BENCHMARK_CAPTURE(BM_VoltageFanOutBroadcast, UUgreen, ProtocolType::UUgreen);
+BENCHMARK_CAPTURE(BM_VoltageFanOutBroadcast, MMeet, ProtocolType::MMeet);
+
+// Setpoint encoding: float volts rounded to mV vs integer mV as is
+static void BM_VoltageSetFloat(benchmark::State& state) {
+    UUgreenFrameGenerator generator;
+    can_frame frames[MODULE_COUNT];
+    float value = 400.0f;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value);
+        for (size_t i = 0; i < MODULE_COUNT; ++i) {
+            frames[i] = generator.generateVoltageSet(static_cast<uint8_t>(i), value);
+        }
+        benchmark::DoNotOptimize(frames);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MODULE_COUNT);
+}
+BENCHMARK(BM_VoltageSetFloat);
+
+static void BM_VoltageSetMillivolts(benchmark::State& state) {
+    UUgreenFrameGenerator generator;
+    can_frame frames[MODULE_COUNT];
+    Millivolts value{400000};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value);
+        for (size_t i = 0; i < MODULE_COUNT; ++i) {
+            frames[i] = generator.generateVoltageSet(static_cast<uint8_t>(i), value);
+        }
+        benchmark::DoNotOptimize(frames);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MODULE_COUNT);
+}
+BENCHMARK(BM_VoltageSetMillivolts);
@@ -0,0 +1,79 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include "../libmodul.h"
+
+namespace {
+    constexpr size_t MODULE_COUNT = 128;
+}
+
+// Heap-allocated generator, one virtual call per frame
+static void BM_RuntimeManagerVoltageSet(benchmark::State& state, ProtocolType protocol) {
+    CanProtocolManager manager(protocol);
+    can_frame frames[MODULE_COUNT];
+    float voltage = 400.0f;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(voltage);
+        for (size_t i = 0; i < MODULE_COUNT; ++i) {
+            frames[i] = manager.generateVoltageSet(static_cast<uint8_t>(i), voltage);
+        }
+        benchmark::DoNotOptimize(frames);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MODULE_COUNT);
+}
+BENCHMARK_CAPTURE(BM_RuntimeManagerVoltageSet, UUgreen, ProtocolType::UUgreen);
+BENCHMARK_CAPTURE(BM_RuntimeManagerVoltageSet, MMeet, ProtocolType::MMeet);
+
+// Protocol fixed at compile time, frame construction inlined
+template <ProtocolType Protocol>
+static void BM_StaticManagerVoltageSet(benchmark::State& state) {
+    StaticCanProtocolManager<Protocol> manager;
+    can_frame frames[MODULE_COUNT];
+    float voltage = 400.0f;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(voltage);
+        for (size_t i = 0; i < MODULE_COUNT; ++i) {
+            frames[i] = manager.generateVoltageSet(static_cast<uint8_t>(i), voltage);
+        }
+        benchmark::DoNotOptimize(frames);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MODULE_COUNT);
+}
+BENCHMARK_TEMPLATE(BM_StaticManagerVoltageSet, ProtocolType::UUgreen);
+BENCHMARK_TEMPLATE(BM_StaticManagerVoltageSet, ProtocolType::MMeet);
+
+static void BM_RuntimeManagerTempRequest(benchmark::State& state, ProtocolType protocol) {
+    CanProtocolManager manager(protocol);
+    can_frame frames[MODULE_COUNT];
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < MODULE_COUNT; ++i) {
+            frames[i] = manager.generateTempRequest(static_cast<uint8_t>(i));
+        }
+        benchmark::DoNotOptimize(frames);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MODULE_COUNT);
+}
+BENCHMARK_CAPTURE(BM_RuntimeManagerTempRequest, UUgreen, ProtocolType::UUgreen);
+BENCHMARK_CAPTURE(BM_RuntimeManagerTempRequest, MMeet, ProtocolType::MMeet);
+
+template <ProtocolType Protocol>
+static void BM_StaticManagerTempRequest(benchmark::State& state) {
+    StaticCanProtocolManager<Protocol> manager;
+    can_frame frames[MODULE_COUNT];
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < MODULE_COUNT; ++i) {
+            frames[i] = manager.generateTempRequest(static_cast<uint8_t>(i));
+        }
+        benchmark::DoNotOptimize(frames);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MODULE_COUNT);
+}
+BENCHMARK_TEMPLATE(BM_StaticManagerTempRequest, ProtocolType::UUgreen);
+BENCHMARK_TEMPLATE(BM_StaticManagerTempRequest, ProtocolType::MMeet);
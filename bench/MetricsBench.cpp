@@ -0,0 +1,29 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "../include/Metrics.h"
+
+// Hook cost per frame; compare the parser benchmarks of `make bench` and `make bench METRICS=1`
+static void BM_MetricsCountFrame(benchmark::State& state) {
+    const can_frame frame = make_frame(CAN_INV_EFF_FLAG | UUGREEN_MASK, UUgreenConstants::PREAMBLE,
+                                       UUgreenConstants::VOLTAGE_CMD);
+    for (auto _ : state) {
+        Metrics::FrameCounter metrics(ProtocolType::UUgreen);
+        for (int i = 0; i < 64; ++i) metrics.add(ParseResult::OK, Metrics::command_key(ProtocolType::UUgreen, frame));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+    state.SetLabel(Metrics::ENABLED ? "enabled" : "compiled out");
+}
+BENCHMARK(BM_MetricsCountFrame);
+
+// Exporter side: summing the shards of this thread and retired ones
+static void BM_MetricsSnapshot(benchmark::State& state) {
+    auto snapshot = std::make_unique<Metrics::Snapshot>();
+    for (auto _ : state) {
+        Metrics::snapshot(*snapshot);
+        benchmark::DoNotOptimize(snapshot->outcomes);
+    }
+    state.SetLabel(Metrics::ENABLED ? "enabled" : "compiled out");
+}
+BENCHMARK(BM_MetricsSnapshot)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,58 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include "../include/ModuleSimulator.h"
+#include "../include/MultiBus.h"
+
+#ifdef __linux__
+#include <sys/socket.h>
+
+namespace {
+    // Voltage responses of a full bus of modules
+    size_t busResponses(ProtocolType protocol, can_frame* frames) {
+        CanProtocolManager manager(protocol);
+        ModuleSimulator::Config config;
+        config.latency = ModuleSimulator::Clock::duration::zero();
+        ModuleSimulator fleet(protocol, 0, MODULE_ADDRESS_COUNT, config);
+        can_frame requests[MODULE_ADDRESS_COUNT];
+        manager.generateRequestRange(RequestType::Voltage, 0, MODULE_ADDRESS_COUNT, requests);
+        fleet.receive(requests, MODULE_ADDRESS_COUNT, ModuleSimulator::Clock::time_point{});
+        return fleet.transmit(ModuleSimulator::Clock::time_point{}, frames, MODULE_ADDRESS_COUNT);
+    }
+}
+
+// One telemetry cycle on every bus, received, parsed and merged by the per-bus I/O threads.
+// Each bus also has a feeding transport, so scaling needs two cores per bus.
+static void BM_MultiBusIngest(benchmark::State& state) {
+    const size_t bus_count = static_cast<size_t>(state.range(0));
+    MultiBusManager buses;
+    std::vector<std::unique_ptr<CanTransport>> feeders;
+    for (size_t bus = 0; bus < bus_count; ++bus) {
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) != 0) {
+            state.SkipWithError("socketpair failed");
+            return;
+        }
+        buses.addBus(std::make_unique<CanTransport>(fds[0]), ProtocolType::UUgreen);
+        feeders.push_back(std::make_unique<CanTransport>(fds[1]));
+        feeders.back()->start();
+    }
+    buses.start();
+
+    can_frame frames[MODULE_ADDRESS_COUNT];
+    const size_t count = busResponses(ProtocolType::UUgreen, frames);
+    uint64_t expected = 0;
+
+    for (auto _ : state) {
+        for (auto& feeder : feeders) {
+            for (size_t sent = 0; sent < count;) sent += feeder->send(frames + sent, count - sent);
+        }
+        expected += count;
+        for (size_t bus = 0; bus < bus_count; ++bus) {
+            while (buses.stats(bus).frames < expected) std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count * bus_count);
+    buses.stop();
+}
+BENCHMARK(BM_MultiBusIngest)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+#endif
@@ -0,0 +1,236 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "../libmodul.h"
+
+namespace {
+    constexpr size_t FRAME_COUNT = 512;
+
+    // Mix of telemetry answers from every module, as drained from a socket
+    std::vector<can_frame> makeResponses(ProtocolType protocol) {
+        const uint8_t uugreen_cmds[] = {0x62, 0x30, 0x1E, 0x08, 0x68};
+        const uint16_t mmeet_cmds[] = {0x0231, 0x0232, 0x020B, 0x0218, 0x0235};
+        std::vector<can_frame> frames(FRAME_COUNT);
+        for (size_t i = 0; i < FRAME_COUNT; ++i) {
+            can_frame& frame = frames[i];
+            const uint32_t address = i % MODULE_ADDRESS_COUNT;
+            const uint32_t value = 1000 + static_cast<uint32_t>(i) * 7;
+            frame = make_frame(0);
+            if (protocol == ProtocolType::UUgreen) {
+                frame.can_id = UUGREEN_MASK | (address << 14);
+                frame.data[1] = uugreen_cmds[i % 5];
+            } else {
+                frame.can_id = MMEET_ID | (address << 3);
+                frame.data[2] = static_cast<uint8_t>(mmeet_cmds[i % 5] >> 8);
+                frame.data[3] = static_cast<uint8_t>(mmeet_cmds[i % 5]);
+            }
+            frame.data[4] = byte_of(value, 24);
+            frame.data[5] = byte_of(value, 16);
+            frame.data[6] = byte_of(value, 8);
+            frame.data[7] = byte_of(value, 0);
+        }
+        return frames;
+    }
+}
+
+static void BM_ParseLoop(benchmark::State& state, ProtocolType protocol) {
+    CanParser parser;
+    const auto frames = makeResponses(protocol);
+
+    for (auto _ : state) {
+        size_t parsed = 0;
+        for (const auto& frame : frames) {
+            auto [data, result] = parser.parse(frame, protocol);
+            parsed += result == ParseResult::OK;
+            benchmark::DoNotOptimize(data);
+        }
+        benchmark::DoNotOptimize(parsed);
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_COUNT);
+}
+BENCHMARK_CAPTURE(BM_ParseLoop, UUgreen, ProtocolType::UUgreen);
+BENCHMARK_CAPTURE(BM_ParseLoop, MMeet, ProtocolType::MMeet);
+
+// One outcome per run: accepted, rejected on the command, rejected on the ID
+static void BM_ParseOutcome(benchmark::State& state, ProtocolType protocol, ParseResult outcome) {
+    CanParser parser;
+    auto frames = makeResponses(protocol);
+    for (auto& frame : frames) {
+        if (outcome == ParseResult::UNKNOWN_CMD) {
+            frame.data[protocol == ProtocolType::UUgreen ? 1 : 3] = 0x99;
+        } else if (outcome == ParseResult::INVALID_FRAME) {
+            frame.can_id = 0x123;
+        }
+    }
+
+    for (auto _ : state) {
+        size_t matched = 0;
+        for (const auto& frame : frames) {
+            auto [data, result] = parser.parse(frame, protocol);
+            matched += result == outcome;
+            benchmark::DoNotOptimize(data);
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_COUNT);
+}
+BENCHMARK_CAPTURE(BM_ParseOutcome, UUgreen_Valid, ProtocolType::UUgreen, ParseResult::OK);
+BENCHMARK_CAPTURE(BM_ParseOutcome, UUgreen_UnknownCmd, ProtocolType::UUgreen, ParseResult::UNKNOWN_CMD);
+BENCHMARK_CAPTURE(BM_ParseOutcome, UUgreen_Invalid, ProtocolType::UUgreen, ParseResult::INVALID_FRAME);
+BENCHMARK_CAPTURE(BM_ParseOutcome, MMeet_Valid, ProtocolType::MMeet, ParseResult::OK);
+BENCHMARK_CAPTURE(BM_ParseOutcome, MMeet_UnknownCmd, ProtocolType::MMeet, ParseResult::UNKNOWN_CMD);
+BENCHMARK_CAPTURE(BM_ParseOutcome, MMeet_Invalid, ProtocolType::MMeet, ParseResult::INVALID_FRAME);
+
+static void BM_ParseBatch(benchmark::State& state, ProtocolType protocol) {
+    CanParser parser;
+    const auto frames = makeResponses(protocol);
+    std::vector<uint8_t> address(FRAME_COUNT), field(FRAME_COUNT);
+    std::vector<uint32_t> raw(FRAME_COUNT);
+    std::vector<ParseResult> result(FRAME_COUNT);
+    const ParsedBatch out{address.data(), field.data(), raw.data(), result.data()};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parser.parseBatch(frames.data(), FRAME_COUNT, protocol, out));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_COUNT);
+}
+BENCHMARK_CAPTURE(BM_ParseBatch, UUgreen, ProtocolType::UUgreen);
+BENCHMARK_CAPTURE(BM_ParseBatch, MMeet, ProtocolType::MMeet);
+
+static void BM_DecodeBatch(benchmark::State& state, ProtocolType protocol, DecodeKernel kernel) {
+    if (!CanParser::isDecodeKernelSupported(kernel)) {
+        state.SkipWithError("decode kernel not supported on this CPU");
+        return;
+    }
+    CanParser parser;
+    const auto frames = makeResponses(protocol);
+    std::vector<uint8_t> address(FRAME_COUNT), field(FRAME_COUNT);
+    std::vector<uint32_t> raw(FRAME_COUNT);
+    std::vector<float> value(FRAME_COUNT);
+    std::vector<ParseResult> result(FRAME_COUNT);
+    const ParsedBatch out{address.data(), field.data(), raw.data(), result.data(), value.data()};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parser.decodeBatch(frames.data(), FRAME_COUNT, protocol, out, kernel));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_COUNT);
+}
+BENCHMARK_CAPTURE(BM_DecodeBatch, UUgreen_Scalar, ProtocolType::UUgreen, DecodeKernel::Scalar);
+BENCHMARK_CAPTURE(BM_DecodeBatch, UUgreen_SSE4, ProtocolType::UUgreen, DecodeKernel::SSE4);
+BENCHMARK_CAPTURE(BM_DecodeBatch, UUgreen_AVX2, ProtocolType::UUgreen, DecodeKernel::AVX2);
+BENCHMARK_CAPTURE(BM_DecodeBatch, MMeet_Scalar, ProtocolType::MMeet, DecodeKernel::Scalar);
+BENCHMARK_CAPTURE(BM_DecodeBatch, MMeet_SSE4, ProtocolType::MMeet, DecodeKernel::SSE4);
+BENCHMARK_CAPTURE(BM_DecodeBatch, MMeet_AVX2, ProtocolType::MMeet, DecodeKernel::AVX2);
+
+namespace {
+    // UUgreen and MMeet cabinets interleaved on one segment
+    std::vector<can_frame> makeMixedResponses() {
+        const auto uugreen = makeResponses(ProtocolType::UUgreen);
+        const auto mmeet = makeResponses(ProtocolType::MMeet);
+        std::vector<can_frame> frames(FRAME_COUNT);
+        for (size_t i = 0; i < FRAME_COUNT; ++i) frames[i] = (i & 1) ? mmeet[i] : uugreen[i];
+        return frames;
+    }
+}
+
+// Try every parser until one accepts the frame
+static void BM_ParseMixedTryBoth(benchmark::State& state) {
+    CanParser parser;
+    const auto frames = makeMixedResponses();
+
+    for (auto _ : state) {
+        for (const auto& frame : frames) {
+            auto parsed = parser.parse(frame, ProtocolType::MMeet);
+            if (parsed.second == ParseResult::INVALID_FRAME) parsed = parser.parse(frame, ProtocolType::UUgreen);
+            benchmark::DoNotOptimize(parsed);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_COUNT);
+}
+BENCHMARK(BM_ParseMixedTryBoth);
+
+static void BM_ParseMixedAny(benchmark::State& state) {
+    CanParser parser;
+    const auto frames = makeMixedResponses();
+
+    for (auto _ : state) {
+        for (const auto& frame : frames) {
+            auto parsed = parser.parseAny(frame);
+            benchmark::DoNotOptimize(parsed);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_COUNT);
+}
+BENCHMARK(BM_ParseMixedAny);
+
+static void BM_ParseMixedSplitBatch(benchmark::State& state) {
+    CanParser parser;
+    const auto frames = makeMixedResponses();
+    std::vector<can_frame> uugreen(FRAME_COUNT), mmeet(FRAME_COUNT);
+    std::vector<uint8_t> address(FRAME_COUNT), field(FRAME_COUNT);
+    std::vector<uint32_t> raw(FRAME_COUNT);
+    std::vector<ParseResult> result(FRAME_COUNT);
+    const ParsedBatch out{address.data(), field.data(), raw.data(), result.data()};
+
+    for (auto _ : state) {
+        const ProtocolSplit split = parser.splitByProtocol(frames.data(), FRAME_COUNT, uugreen.data(), mmeet.data());
+        benchmark::DoNotOptimize(parser.parseBatch(uugreen.data(), split.uugreen, ProtocolType::UUgreen, out));
+        benchmark::DoNotOptimize(parser.parseBatch(mmeet.data(), split.mmeet, ProtocolType::MMeet, out));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_COUNT);
+}
+BENCHMARK(BM_ParseMixedSplitBatch);
+
+namespace {
+    // Latest voltage and current of every module, the typical consumer of parsed frames
+    struct LatestTable : TelemetryVisitor {
+        uint32_t voltage_mv[MODULE_ADDRESS_COUNT] = {};
+        uint32_t current_ma[MODULE_ADDRESS_COUNT] = {};
+        uint32_t status[MODULE_ADDRESS_COUNT] = {};
+
+        void onVoltage(uint8_t address, uint32_t mv) { voltage_mv[address] = mv; }
+        void onCurrent(uint8_t address, uint32_t ma) { current_ma[address] = ma; }
+        void onStatus(uint8_t address, uint32_t bits) { status[address] = bits; }
+    };
+}
+
+// Table update through parse(): ParsedData per frame, then copy the field out
+static void BM_TableUpdateParse(benchmark::State& state, ProtocolType protocol) {
+    CanParser parser;
+    const auto frames = makeResponses(protocol);
+    LatestTable table;
+
+    for (auto _ : state) {
+        for (const auto& frame : frames) {
+            auto [data, result] = parser.parse(frame, protocol);
+            if (result != ParseResult::OK) continue;
+            if (data->fields.test(ParsedData::VOLTAGE)) table.voltage_mv[data->address] = round_to_milli(data->voltage);
+            if (data->fields.test(ParsedData::CURRENT)) table.current_ma[data->address] = round_to_milli(data->current);
+            if (data->fields.test(ParsedData::STATUS)) table.status[data->address] = data->status;
+        }
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_COUNT);
+}
+BENCHMARK_CAPTURE(BM_TableUpdateParse, UUgreen, ProtocolType::UUgreen);
+BENCHMARK_CAPTURE(BM_TableUpdateParse, MMeet, ProtocolType::MMeet);
+
+// Same update with the handlers inlined into dispatch
+static void BM_TableUpdateDispatch(benchmark::State& state, ProtocolType protocol) {
+    CanParser parser;
+    const auto frames = makeResponses(protocol);
+    LatestTable table;
+
+    for (auto _ : state) {
+        for (const auto& frame : frames) {
+            parser.dispatch(frame, protocol, table);
+        }
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_COUNT);
+}
+BENCHMARK_CAPTURE(BM_TableUpdateDispatch, UUgreen, ProtocolType::UUgreen);
+BENCHMARK_CAPTURE(BM_TableUpdateDispatch, MMeet, ProtocolType::MMeet);
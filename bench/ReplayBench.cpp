@@ -0,0 +1,72 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include "../include/CanLogReader.h"
+
+namespace {
+    constexpr size_t LINE_COUNT = 100000;
+
+    // candump -l text of a UUgreen sweep with one foreign frame in four
+    const std::string& candumpLog() {
+        static const std::string log = [] {
+            std::string text;
+            char line[80];
+            for (size_t i = 0; i < LINE_COUNT; ++i) {
+                const unsigned id = i % 4 == 3 ? 0x18FF50E5u : 0x02200000u | (i % 128) << 14;
+                std::snprintf(line, sizeof(line), "(1700000000.%06zu) can0 %08X#12620000%08zX\n",
+                              i % 1000000, id, i);
+                text += line;
+            }
+            return text;
+        }();
+        return log;
+    }
+}
+
+// Baseline: getline and sscanf per line, as an iostream-based replay would
+static void BM_ReplayIostream(benchmark::State& state) {
+    const std::string& log = candumpLog();
+    CanParser parser;
+    for (auto _ : state) {
+        std::istringstream stream(log);
+        std::string line;
+        size_t parsed = 0;
+        while (std::getline(stream, line)) {
+            unsigned long seconds, usec;
+            char interface[16], payload[32];
+            unsigned id;
+            if (std::sscanf(line.c_str(), "(%lu.%lu) %15s %X#%31s", &seconds, &usec, interface, &id, payload) != 5)
+                continue;
+            can_frame frame = make_frame(id | CAN_EFF_FLAG);
+            for (size_t b = 0; b < 8; ++b) {
+                unsigned byte;
+                std::sscanf(payload + 2 * b, "%2X", &byte);
+                frame.data[b] = static_cast<uint8_t>(byte);
+            }
+            parsed += parser.parseRecord(frame, ProtocolType::UUgreen).second == ParseResult::OK;
+        }
+        benchmark::DoNotOptimize(parsed);
+    }
+    state.SetItemsProcessed(state.iterations() * LINE_COUNT);
+    state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK(BM_ReplayIostream)->Unit(benchmark::kMillisecond);
+
+static void BM_ReplayMapped(benchmark::State& state) {
+    const std::string& log = candumpLog();
+    CanParser parser;
+    CanLogReader reader(LogFormat::Candump);
+    reader.openBuffer(log.data(), log.size());
+    ReplayStats stats;
+    for (auto _ : state) {
+        reader.rewind();
+        stats = reader.replay(parser, ProtocolType::UUgreen,
+                              [](const TelemetryRecord* records, size_t) { benchmark::DoNotOptimize(records); });
+    }
+    state.SetItemsProcessed(state.iterations() * LINE_COUNT);
+    state.SetBytesProcessed(state.iterations() * log.size());
+    state.counters["parsed"] = static_cast<double>(stats.parsed);
+}
+BENCHMARK(BM_ReplayMapped)->Unit(benchmark::kMillisecond);
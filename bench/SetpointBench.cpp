@@ -0,0 +1,46 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include "../include/SetpointCache.h"
+
+namespace {
+    constexpr size_t SETPOINTS = 2 * MODULE_ADDRESS_COUNT;
+}
+
+// Baseline: one set frame per module and setpoint every tick
+static void BM_SetpointTickUncached(benchmark::State& state) {
+    CanProtocolManager manager(ProtocolType::UUgreen);
+    can_frame frames[SETPOINTS];
+    size_t sent = 0;
+    for (auto _ : state) {
+        size_t count = 0;
+        for (size_t address = 0; address < MODULE_ADDRESS_COUNT; ++address) {
+            frames[count++] = manager.generateVoltageSet(static_cast<uint8_t>(address), 400.0f);
+            frames[count++] = manager.generateCurrentSet(static_cast<uint8_t>(address), 20.0f);
+        }
+        benchmark::DoNotOptimize(frames);
+        sent += count;
+    }
+    state.counters["frames_per_tick"] = benchmark::Counter(static_cast<double>(sent) / state.iterations());
+}
+BENCHMARK(BM_SetpointTickUncached);
+
+// 50 Hz ticks through the cache, two modules ramping, 1 s refresh
+static void BM_SetpointTickCached(benchmark::State& state) {
+    SetpointCache cache(ProtocolType::UUgreen, std::chrono::seconds(1));
+    can_frame frames[SETPOINTS];
+    SetpointCache::Clock::time_point now{};
+    size_t sent = 0;
+    int tick = 0;
+    for (auto _ : state) {
+        for (size_t address = 0; address < MODULE_ADDRESS_COUNT; ++address) {
+            const float ramp = address < 2 ? 0.1f * static_cast<float>(tick % 1000) : 0.0f;
+            cache.setVoltage(static_cast<uint8_t>(address), 400.0f + ramp);
+            cache.setCurrent(static_cast<uint8_t>(address), 20.0f);
+        }
+        sent += cache.flush(now, frames, SETPOINTS);
+        now += std::chrono::milliseconds(20);
+        ++tick;
+    }
+    state.counters["frames_per_tick"] = benchmark::Counter(static_cast<double>(sent) / state.iterations());
+}
+BENCHMARK(BM_SetpointTickCached);
@@ -0,0 +1,58 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include "../include/ModuleSimulator.h"
+#include "../include/PollScheduler.h"
+
+namespace {
+    using Clock = ModuleSimulator::Clock;
+}
+
+// Simulator cost alone: one request per module in, one response out
+template <ProtocolType Protocol>
+static void BM_SimulatorRoundTrip(benchmark::State& state) {
+    ModuleSimulator::Config config;
+    config.latency = Clock::duration::zero();
+    ModuleSimulator simulator(Protocol, 0, MODULE_ADDRESS_COUNT, config);
+    CanProtocolManager manager(Protocol);
+    can_frame requests[MODULE_ADDRESS_COUNT];
+    can_frame responses[MODULE_ADDRESS_COUNT];
+    manager.generateRequestRange(RequestType::Voltage, 0, MODULE_ADDRESS_COUNT, requests);
+    const Clock::time_point now{};
+    for (auto _ : state) {
+        simulator.receive(requests, MODULE_ADDRESS_COUNT, now);
+        benchmark::DoNotOptimize(simulator.transmit(now, responses, MODULE_ADDRESS_COUNT));
+    }
+    state.SetItemsProcessed(state.iterations() * MODULE_ADDRESS_COUNT);
+}
+BENCHMARK_TEMPLATE(BM_SimulatorRoundTrip, ProtocolType::UUgreen)->Name("BM_SimulatorRoundTrip/UUgreen");
+BENCHMARK_TEMPLATE(BM_SimulatorRoundTrip, ProtocolType::MMeet)->Name("BM_SimulatorRoundTrip/MMeet");
+
+// Full poll sweep of the fleet: scheduler, simulator, parser and registry in simulated time
+static void BM_SimulatedFleetSweep(benchmark::State& state) {
+    const size_t modules = static_cast<size_t>(state.range(0));
+    ModuleSimulator::Config config;
+    config.latency = std::chrono::milliseconds(2);
+    config.jitter = std::chrono::milliseconds(1);
+    ModuleSimulator simulator(ProtocolType::UUgreen, 0, modules, config);
+    PollScheduler scheduler(ProtocolType::UUgreen, 32, std::chrono::milliseconds(50));
+    CanParser parser;
+    ModuleRegistry registry;
+    can_frame frames[CanTransport::BURST_CAPACITY];
+    TelemetryRecord records[CanTransport::BURST_CAPACITY];
+    Clock::time_point now{};
+
+    for (auto _ : state) {
+        scheduler.enqueueSweep(0, modules);
+        while (!scheduler.idle()) {
+            size_t count = scheduler.nextFrames(now, frames, CanTransport::BURST_CAPACITY);
+            simulator.receive(frames, count, now);
+            count = simulator.transmit(now, frames, CanTransport::BURST_CAPACITY);
+            parser.parseRecords(frames, count, ProtocolType::UUgreen, records);
+            scheduler.onResponses(records, count);
+            registry.update(records, count);
+            if (auto due = simulator.nextResponse()) now = std::max(now, *due);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * modules * REQUEST_TYPE_COUNT);
+}
+BENCHMARK(BM_SimulatedFleetSweep)->Arg(16)->Arg(MODULE_ADDRESS_COUNT);
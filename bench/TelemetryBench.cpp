@@ -0,0 +1,101 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "../libmodul.h"
+
+namespace {
+    constexpr size_t RECORD_COUNT = 4096;
+
+    ParsedData makeData(size_t i) {
+        ParsedData data;
+        data.address = static_cast<uint8_t>(i % MODULE_ADDRESS_COUNT);
+        data.voltage = 700.0f + static_cast<float>(i % 100);
+        data.current = 10.0f + static_cast<float>(i % 7);
+        data.temperature = static_cast<int16_t>(20 + i % 30);
+        data.fields.set(ParsedData::ADDR);
+        data.fields.set(ParsedData::VOLTAGE);
+        data.fields.set(ParsedData::CURRENT);
+        return data;
+    }
+}
+
+// Sum of voltage over modules reporting it, the typical dashboard scan
+static void BM_ScanParsedData(benchmark::State& state) {
+    std::vector<ParsedData> data(RECORD_COUNT);
+    for (size_t i = 0; i < RECORD_COUNT; ++i) data[i] = makeData(i);
+
+    for (auto _ : state) {
+        float total = 0.0f;
+        for (const auto& item : data) {
+            if (item.fields.test(ParsedData::VOLTAGE)) total += item.voltage;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * RECORD_COUNT);
+    state.SetBytesProcessed(state.iterations() * RECORD_COUNT * sizeof(ParsedData));
+    state.counters["record_bytes"] = sizeof(ParsedData);
+}
+BENCHMARK(BM_ScanParsedData);
+
+static void BM_ScanTelemetryRecord(benchmark::State& state) {
+    std::vector<TelemetryRecord> records(RECORD_COUNT);
+    for (size_t i = 0; i < RECORD_COUNT; ++i) records[i] = TelemetryRecord::fromParsedData(makeData(i));
+
+    for (auto _ : state) {
+        uint64_t total_mv = 0;
+        for (const auto& record : records) {
+            total_mv += record.has(ParsedData::VOLTAGE) ? record.voltage_mv : 0;
+        }
+        benchmark::DoNotOptimize(total_mv);
+    }
+    state.SetItemsProcessed(state.iterations() * RECORD_COUNT);
+    state.SetBytesProcessed(state.iterations() * RECORD_COUNT * sizeof(TelemetryRecord));
+    state.counters["record_bytes"] = sizeof(TelemetryRecord);
+}
+BENCHMARK(BM_ScanTelemetryRecord);
+
+static void BM_ParseRecords(benchmark::State& state) {
+    CanParser parser;
+    std::vector<can_frame> frames(RECORD_COUNT);
+    for (size_t i = 0; i < RECORD_COUNT; ++i) {
+        frames[i] = FrameBuilder<ProtocolType::UUgreen>::create_command_frame(
+            static_cast<uint8_t>(i % MODULE_ADDRESS_COUNT), 0x12, UUgreenConstants::VOLTAGE_CMD, 700000 + i);
+    }
+    std::vector<TelemetryRecord> records(RECORD_COUNT);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parser.parseRecords(frames.data(), RECORD_COUNT, ProtocolType::UUgreen, records.data()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * RECORD_COUNT);
+}
+BENCHMARK(BM_ParseRecords);
+
+static void BM_RegistryUpdate(benchmark::State& state) {
+    ModuleRegistry registry;
+    std::vector<TelemetryRecord> records(RECORD_COUNT);
+    for (size_t i = 0; i < RECORD_COUNT; ++i) records[i] = TelemetryRecord::fromParsedData(makeData(i));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry.update(records.data(), RECORD_COUNT));
+    }
+    state.SetItemsProcessed(state.iterations() * RECORD_COUNT);
+}
+BENCHMARK(BM_RegistryUpdate);
+
+// Snapshot of every module, as the HMI refresh does
+static void BM_RegistryReadAll(benchmark::State& state) {
+    ModuleRegistry registry;
+    for (size_t i = 0; i < ModuleRegistry::SLOT_COUNT; ++i) registry.update(TelemetryRecord::fromParsedData(makeData(i)));
+    TelemetryRecord record;
+
+    for (auto _ : state) {
+        uint64_t total_mv = 0;
+        for (size_t address = 0; address < ModuleRegistry::SLOT_COUNT; ++address) {
+            if (registry.read(static_cast<uint8_t>(address), record)) total_mv += record.voltage_mv;
+        }
+        benchmark::DoNotOptimize(total_mv);
+    }
+    state.SetItemsProcessed(state.iterations() * ModuleRegistry::SLOT_COUNT);
+}
+BENCHMARK(BM_RegistryReadAll);
@@ -0,0 +1,56 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "../include/TimingWheel.h"
+
+namespace {
+    constexpr size_t TIMER_COUNT = 10000;
+    constexpr auto TIMEOUT = std::chrono::milliseconds(100);
+}
+
+// Arm 10k request timers spread over 10 ms, then cancel all as responses arrive
+static void BM_WheelArmCancel(benchmark::State& state) {
+    TimingWheel wheel(TIMEOUT / 64, 256);
+    std::vector<TimingWheel::TimerId> ids(TIMER_COUNT);
+    const TimingWheel::Clock::time_point start{};
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < TIMER_COUNT; ++i) {
+            ids[i] = wheel.arm(start + TIMEOUT + std::chrono::microseconds(i), static_cast<uint32_t>(i));
+        }
+        for (size_t i = 0; i < TIMER_COUNT; ++i) benchmark::DoNotOptimize(wheel.cancel(ids[i]));
+    }
+    state.SetItemsProcessed(state.iterations() * TIMER_COUNT);
+}
+BENCHMARK(BM_WheelArmCancel);
+
+// Arm 10k timers, then let every one of them expire
+static void BM_WheelArmExpire(benchmark::State& state) {
+    TimingWheel::Clock::time_point now{};
+    TimingWheel wheel(TIMEOUT / 64, 256);
+    size_t expired = 0;
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < TIMER_COUNT; ++i) {
+            wheel.arm(now + TIMEOUT + std::chrono::microseconds(i), static_cast<uint32_t>(i));
+        }
+        now += TIMEOUT + std::chrono::milliseconds(20);
+        wheel.advance(now, [&](uint32_t, TimingWheel::Clock::time_point) { ++expired; });
+    }
+    benchmark::DoNotOptimize(expired);
+    state.SetItemsProcessed(state.iterations() * TIMER_COUNT);
+}
+BENCHMARK(BM_WheelArmExpire);
+
+// Advance by one tick with 10k timers outstanding and nothing due
+static void BM_WheelTickIdle(benchmark::State& state) {
+    TimingWheel::Clock::time_point now{};
+    TimingWheel wheel(TIMEOUT / 64, 256);
+    for (size_t i = 0; i < TIMER_COUNT; ++i) wheel.arm(now + std::chrono::hours(1), static_cast<uint32_t>(i));
+
+    for (auto _ : state) {
+        now += wheel.tick();
+        benchmark::DoNotOptimize(wheel.advance(now, [](uint32_t, TimingWheel::Clock::time_point) {}));
+    }
+}
+BENCHMARK(BM_WheelTickIdle);
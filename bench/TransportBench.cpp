@@ -0,0 +1,109 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <benchmark/benchmark.h>
+#include "../include/CanTransport.h"
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+    // One full poll cycle: every telemetry request to every module
+    constexpr size_t POLL_CYCLE_FRAMES = REQUEST_TYPE_COUNT * MODULE_ADDRESS_COUNT;
+
+    template <size_t Capacity>
+    size_t generatePollCycle(CanProtocolManager& manager, can_frame* frames) {
+        static_assert(Capacity >= POLL_CYCLE_FRAMES, "burst must hold a poll cycle");
+        size_t count = 0;
+        for (size_t request = 0; request < REQUEST_TYPE_COUNT; ++request) {
+            count += manager.generateRequestRange(static_cast<RequestType>(request), 0, MODULE_ADDRESS_COUNT, frames + count);
+        }
+        return count;
+    }
+}
+
+// Frames pushed through two transports over a SOCK_SEQPACKET pair
+static void BM_TransportPollCycle(benchmark::State& state, CanTransport::IoMode mode) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) != 0) {
+        state.SkipWithError("socketpair failed");
+        return;
+    }
+    CanTransport sender(fds[0], mode);
+    CanTransport receiver(fds[1], mode);
+    sender.start();
+    receiver.start();
+
+    CanProtocolManager manager(ProtocolType::UUgreen);
+    static can_frame frames[POLL_CYCLE_FRAMES];
+    static can_frame received[POLL_CYCLE_FRAMES];
+    generatePollCycle<POLL_CYCLE_FRAMES>(manager, frames);
+
+    for (auto _ : state) {
+        size_t sent = 0, total = 0;
+        while (total < POLL_CYCLE_FRAMES) {
+            sent += sender.send(frames + sent, POLL_CYCLE_FRAMES - sent);
+            total += receiver.receive(received, POLL_CYCLE_FRAMES, 100);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * POLL_CYCLE_FRAMES);
+    state.counters["syscalls_per_cycle"] = benchmark::Counter(
+        static_cast<double>(sender.stats().syscalls + receiver.stats().syscalls), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_CAPTURE(BM_TransportPollCycle, Single, CanTransport::IoMode::Single)->UseRealTime();
+BENCHMARK_CAPTURE(BM_TransportPollCycle, Batched, CanTransport::IoMode::Batched)->UseRealTime();
+
+// Synchronous poll cycle, one write()/read() per frame as in the example
+static void BM_PollCycleWriteRead(benchmark::State& state) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) != 0) {
+        state.SkipWithError("socketpair failed");
+        return;
+    }
+    CanProtocolManager manager(ProtocolType::UUgreen);
+    static can_frame frames[POLL_CYCLE_FRAMES];
+    can_frame frame;
+    size_t syscalls = 0;
+
+    for (auto _ : state) {
+        generatePollCycle<POLL_CYCLE_FRAMES>(manager, frames);
+        // Chunks of one module range keep the socket buffer from filling up
+        for (size_t first = 0; first < POLL_CYCLE_FRAMES; first += MODULE_ADDRESS_COUNT) {
+            for (size_t i = 0; i < MODULE_ADDRESS_COUNT; ++i) syscalls += ::write(fds[0], &frames[first + i], sizeof(can_frame)) > 0;
+            for (size_t i = 0; i < MODULE_ADDRESS_COUNT; ++i) syscalls += ::read(fds[1], &frame, sizeof(frame)) > 0;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * POLL_CYCLE_FRAMES);
+    state.counters["syscalls_per_cycle"] = benchmark::Counter(static_cast<double>(syscalls), benchmark::Counter::kAvgIterations);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+BENCHMARK(BM_PollCycleWriteRead);
+
+// Synchronous poll cycle, generators write into the sendmmsg buffers
+static void BM_PollCycleMmsg(benchmark::State& state) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) != 0) {
+        state.SkipWithError("socketpair failed");
+        return;
+    }
+    CanProtocolManager manager(ProtocolType::UUgreen);
+    static FrameBurst<POLL_CYCLE_FRAMES> tx;
+    static FrameBurst<MODULE_ADDRESS_COUNT> rx;
+    size_t syscalls = 0;
+
+    for (auto _ : state) {
+        tx.resize(generatePollCycle<POLL_CYCLE_FRAMES>(manager, tx.frames()));
+        for (size_t first = 0; first < POLL_CYCLE_FRAMES; first += MODULE_ADDRESS_COUNT) {
+            // Send one module range, then drain it
+            tx.resize(first + MODULE_ADDRESS_COUNT);
+            for (size_t sent = first; sent < first + MODULE_ADDRESS_COUNT; ++syscalls) sent += tx.send(fds[0], sent, 0);
+            for (size_t got = 0; got < MODULE_ADDRESS_COUNT; ++syscalls) got += rx.receive(fds[1], 0);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * POLL_CYCLE_FRAMES);
+    state.counters["syscalls_per_cycle"] = benchmark::Counter(static_cast<double>(syscalls), benchmark::Counter::kAvgIterations);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+BENCHMARK(BM_PollCycleMmsg);
+#endif
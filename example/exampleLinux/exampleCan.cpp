@@ -24,7 +24,8 @@ Important Note for Real Projects:
     from multiple nodes.
     Message Filtering: It is crucial to implement CAN ID filtering (e.g., using setsockopt 
     with CAN_RAW_FILTER) to process only relevant messages for your application. 
-    This example reads all frames on the socket.
+    This example installs a CanFilterSet for the tested module, so the kernel drops 
+    frames of other nodes before they reach the socket.
 
     Concurrency & Architecture: 
         For robust operation, a real application should separate 
@@ -54,6 +55,7 @@ Important Note for Real Projects:
 #include <linux/can.h>
 #include <linux/can/raw.h>
 #include "../../libmodul.h" 
+#include "../../include/CanFilter.h"
 
 using namespace std;
 
@@ -531,6 +533,11 @@ int main() {
         
         can_socket = open_can_socket(CAN_INTERFACE);
         cout << "CAN interface opened successfully" << endl;
+
+        CanFilterSet filters;
+        filters.add(CURRENT_PROTOCOL, DEVICE_ADDRESS, 1);
+        if (!filters.install(can_socket))
+            cerr << "Failed to install CAN filters, reading all frames" << endl;
         
         test_protocol(can_socket);
         
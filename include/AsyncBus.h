@@ -0,0 +1,249 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#pragma once
+#include "../libmodul.h"
+
+// Optional layer: needs C++20 coroutines (make COROUTINES=1), compiles to nothing otherwise
+#if defined(__linux__) && defined(__cpp_impl_coroutine)
+#include <array>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <vector>
+#include "CanTransport.h"
+#include "PollScheduler.h"
+#include "TimingWheel.h"
+
+/**
+ * @brief Detached coroutine for one module conversation
+ *
+ * Starts running when called and frees itself when it returns. It only
+ * suspends on AsyncBus awaitables, so the bus event loop resumes it.
+ */
+struct AsyncTask {
+    struct promise_type {
+        AsyncTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/**
+ * @brief Coroutine front end of one bus, for many concurrent module conversations
+ *
+ * Conversations are AsyncTask coroutines written as straight-line code:
+ * co_await bus.readVoltage(addr, timeout) sends the request and suspends
+ * until the response arrives or the timeout passes, co_await
+ * bus.setCurrent(addr, amps) suspends only while the TX queue is full.
+ * Reads of the same (address, request) share one request frame and
+ * complete together. Responses are matched like PollScheduler does and
+ * timeouts live in a TimingWheel, so thousands of suspended conversations
+ * cost no threads and no syscalls of their own.
+ *
+ * run() or runOnce() drive the bus from a single thread; conversations
+ * must be started and resumed on that thread.
+ */
+class AsyncBus {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Bus counters
+     */
+    struct Stats {
+        uint64_t requests = 0;      // Request frames queued for reads
+        uint64_t completed = 0;     // Reads resumed with a response
+        uint64_t timed_out = 0;     // Reads resumed without a response
+        uint64_t unmatched = 0;     // Valid responses no read was waiting for
+    };
+
+    /**
+     * @brief Awaitable read of one telemetry value, see read()
+     */
+    class ReadAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { _bus.wait(*this, handle); }
+        std::optional<TelemetryRecord> await_resume() const noexcept { return _result; }
+
+    private:
+        friend class AsyncBus;
+        ReadAwaiter(AsyncBus& bus, uint16_t key, Clock::duration timeout)
+            : _bus(bus), _key(key), _timeout(timeout) {}
+
+        AsyncBus& _bus;
+        uint16_t _key;
+        Clock::duration _timeout;
+        std::coroutine_handle<> _handle;
+        ReadAwaiter* _next = nullptr;       // Next read of the same key
+        TimingWheel::TimerId _timer = TimingWheel::INVALID_TIMER;
+        uint32_t _tag = 0;                  // Index in AsyncBus::_timed
+        std::optional<TelemetryRecord> _result;
+    };
+
+    /**
+     * @brief Awaitable read of one field, converted when it arrives
+     */
+    template <typename T, T (*Convert)(const TelemetryRecord&)>
+    class ValueAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { _read.await_suspend(handle); }
+        std::optional<T> await_resume() const noexcept {
+            const auto record = _read.await_resume();
+            return record ? std::optional<T>(Convert(*record)) : std::nullopt;
+        }
+
+    private:
+        friend class AsyncBus;
+        explicit ValueAwaiter(const ReadAwaiter& read) : _read(read) {}
+
+        ReadAwaiter _read;
+    };
+
+    /**
+     * @brief Awaitable transmission of one frame, see send()
+     */
+    class SendAwaiter {
+    public:
+        bool await_ready() { return _bus.try_send(_frame); }
+        void await_suspend(std::coroutine_handle<> handle) {
+            _handle = handle;
+            _bus._senders.push_back(this);
+        }
+        void await_resume() const noexcept {}
+
+    private:
+        friend class AsyncBus;
+        SendAwaiter(AsyncBus& bus, const can_frame& frame) : _bus(bus), _frame(frame) {}
+
+        AsyncBus& _bus;
+        can_frame _frame;
+        std::coroutine_handle<> _handle;
+    };
+
+    /**
+     * @brief Creating the front end of a bus
+     * @param transport Running transport of the bus, receive() is taken over by the bus
+     * @param protocol Protocol of the modules on the bus
+     */
+    AsyncBus(CanTransport& transport, ProtocolType protocol);
+
+    /**
+     * @brief Destroying the bus together with the conversations still suspended on it
+     */
+    ~AsyncBus();
+
+    AsyncBus(const AsyncBus&) = delete;
+    AsyncBus& operator=(const AsyncBus&) = delete;
+
+    /**
+     * @brief Reading one telemetry value of a module
+     * @param address Module address, masked to 7 bits
+     * @param request Telemetry to request
+     * @param timeout Time to wait for the response
+     * @return awaitable, co_await yields std::optional<TelemetryRecord>, nullopt on timeout
+     */
+    ReadAwaiter read(uint8_t address, RequestType request, Clock::duration timeout) {
+        return {*this, key_of(address, request), timeout};
+    }
+
+    /**
+     * @brief Reading module voltage, co_await yields std::optional<Millivolts>
+     */
+    auto readVoltage(uint8_t address, Clock::duration timeout) {
+        return ValueAwaiter<Millivolts, voltage_of>(read(address, RequestType::Voltage, timeout));
+    }
+
+    /**
+     * @brief Reading module current, co_await yields std::optional<Milliamps>
+     */
+    auto readCurrent(uint8_t address, Clock::duration timeout) {
+        return ValueAwaiter<Milliamps, current_of>(read(address, RequestType::Current, timeout));
+    }
+
+    /**
+     * @brief Reading module temperature, co_await yields std::optional<int32_t> in 0.001 degC
+     */
+    auto readTemperature(uint8_t address, Clock::duration timeout) {
+        return ValueAwaiter<int32_t, temperature_of>(read(address, RequestType::Temp, timeout));
+    }
+
+    /**
+     * @brief Reading module status flags, co_await yields std::optional<uint32_t>
+     */
+    auto readFlags(uint8_t address, Clock::duration timeout) {
+        return ValueAwaiter<uint32_t, status_of>(read(address, RequestType::Flags, timeout));
+    }
+
+    /**
+     * @brief Queueing a frame, suspending while the TX queue is full
+     * @param frame Frame to send, frames leave in the order they were awaited
+     * @return awaitable, resumes once the frame is queued on the transport
+     */
+    SendAwaiter send(const can_frame& frame) { return {*this, frame}; }
+
+    SendAwaiter setVoltage(uint8_t address, float voltage) { return send(_manager.generateVoltageSet(address, voltage)); }
+    SendAwaiter setVoltage(uint8_t address, Millivolts voltage) { return send(_manager.generateVoltageSet(address, voltage)); }
+    SendAwaiter setCurrent(uint8_t address, float current) { return send(_manager.generateCurrentSet(address, current)); }
+    SendAwaiter setCurrent(uint8_t address, Milliamps current) { return send(_manager.generateCurrentSet(address, current)); }
+    SendAwaiter enable(uint8_t address) { return send(_manager.generateEnable(address)); }
+    SendAwaiter disable(uint8_t address) { return send(_manager.generateDisable(address)); }
+
+    /**
+     * @brief One turn of the event loop: queue held frames, take responses, expire reads, resume
+     * @param timeout_ms Longest wait for a response, cut to the next read deadline; 0 to poll,
+     *        -1 to wait for the next deadline only
+     * @return size_t Number of conversations resumed
+     */
+    size_t runOnce(int timeout_ms);
+
+    /**
+     * @brief Running the event loop until no conversation is suspended on the bus
+     */
+    void run();
+
+    /**
+     * @brief Conversations suspended on the bus
+     * @return size_t Reads waiting for a response plus sends waiting for the TX queue
+     */
+    size_t suspended() const { return _waiting + _senders.size(); }
+
+    Stats stats() const { return _stats; }
+
+private:
+    static uint16_t key_of(uint8_t address, RequestType request) {
+        return static_cast<uint16_t>((address & (MODULE_ADDRESS_COUNT - 1)) * REQUEST_TYPE_COUNT
+                                     + static_cast<size_t>(request) % REQUEST_TYPE_COUNT);
+    }
+    static Millivolts voltage_of(const TelemetryRecord& record) { return {record.voltage_mv}; }
+    static Milliamps current_of(const TelemetryRecord& record) { return {record.current_ma}; }
+    static int32_t temperature_of(const TelemetryRecord& record) { return record.temperature_mdeg; }
+    static uint32_t status_of(const TelemetryRecord& record) { return record.status; }
+
+    void wait(ReadAwaiter& read, std::coroutine_handle<> handle);
+    bool try_send(const can_frame& frame);
+    void flush_held();
+    void complete(const TelemetryRecord& record);
+    void expire(uint32_t tag);
+    size_t resume_ready();
+
+    CanTransport& _transport;
+    ProtocolType _protocol;
+    CanProtocolManager _manager;
+    CanParser _parser;
+    TimingWheel _wheel;
+
+    std::array<ReadAwaiter*, PollScheduler::KEY_COUNT> _reads{};  // Reads waiting per key, newest first
+    std::vector<ReadAwaiter*> _timed;           // Read per timer tag
+    std::vector<uint32_t> _free_tags;
+    std::vector<can_frame> _held;               // Request frames the TX queue had no room for
+    std::vector<SendAwaiter*> _senders;         // Sends waiting for the TX queue, oldest first
+    std::vector<std::coroutine_handle<>> _ready;
+    size_t _waiting = 0;
+    Stats _stats;
+};
+
+#endif
@@ -0,0 +1,179 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#pragma once
+#include <memory>
+#include "../libmodul.h"
+
+/**
+ * @brief Binary capture file layout
+ *
+ * A 64-byte file header, then blocks of up to block_frames frames. Each
+ * block is a 16-byte block header, the frames as raw can_frame records,
+ * then one nanosecond timestamp per frame. Frames of a block are contiguous
+ * and bit-identical to what the socket returned, so a mapped block is a
+ * ready can_frame array for CanParser.
+ */
+namespace CaptureFormat {
+    constexpr char MAGIC[8] = {'P', 'M', 'C', 'A', 'P', 'T', 'R', '\0'};
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t DEFAULT_BLOCK_FRAMES = 256;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t frame_size;        // sizeof(can_frame) of the writer
+        uint32_t protocol;          // ProtocolType of the captured bus
+        uint32_t block_frames;      // Largest frame count of a block
+        uint64_t created_ns;        // Wall clock at open, ns since the epoch
+        uint8_t reserved[32];
+    };
+    static_assert(sizeof(FileHeader) == 64, "File header is 64 bytes");
+
+    struct BlockHeader {
+        uint32_t count;             // Frames in this block
+        uint32_t reserved;
+        uint64_t first_ns;          // Timestamp of the first frame
+    };
+    static_assert(sizeof(BlockHeader) == 16, "Block header is 16 bytes");
+
+    /**
+     * @brief Size of a block on disk
+     * @param count Frames in the block
+     * @return size_t bytes
+     */
+    constexpr size_t block_size(size_t count) {
+        return sizeof(BlockHeader) + count * (sizeof(can_frame) + sizeof(uint64_t));
+    }
+}
+
+/**
+ * @brief Append-only writer of binary captures, cheap enough for the RX path
+ *
+ * Frames are copied into an in-memory block; a full block goes to the file
+ * in one writev. Appending is a copy of each frame and its timestamp.
+ * Not thread-safe: append from the thread that receives.
+ */
+class CaptureWriter {
+public:
+    CaptureWriter() = default;
+    ~CaptureWriter() { close(); }
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    /**
+     * @brief Creating or truncating a capture file
+     * @param path File path
+     * @param protocol Protocol recorded in the file header
+     * @param block_frames Frames per block, at least 1
+     * @return bool false if the file cannot be created
+     */
+    bool open(const char* path, ProtocolType protocol, uint32_t block_frames = CaptureFormat::DEFAULT_BLOCK_FRAMES);
+
+    /**
+     * @brief Appending received frames with one timestamp, e.g. one recvmmsg burst
+     * @param frames Frames to append
+     * @param count Number of frames
+     * @param timestamp_ns Receive time in ns
+     * @return bool false if a block write failed; the writer is closed then
+     */
+    bool append(const can_frame* frames, size_t count, uint64_t timestamp_ns);
+
+    /**
+     * @brief Appending frames with a timestamp each
+     * @param frames Frames to append
+     * @param timestamps_ns Receive time of each frame in ns
+     * @param count Number of frames
+     * @return bool false if a block write failed; the writer is closed then
+     */
+    bool append(const can_frame* frames, const uint64_t* timestamps_ns, size_t count);
+
+    bool append(const can_frame& frame, uint64_t timestamp_ns) { return append(&frame, 1, timestamp_ns); }
+
+    /**
+     * @brief Writing the pending partial block
+     * @return bool false if the write failed
+     */
+    bool flush();
+
+    /**
+     * @brief Flushing and closing the file
+     * @return bool false if the final flush failed
+     */
+    bool close();
+
+    bool isOpen() const { return _fd >= 0; }
+    uint64_t framesWritten() const { return _frames_written; }
+
+private:
+    bool write_block();
+
+    int _fd = -1;
+    uint32_t _block_frames = 0;
+    uint32_t _pending = 0;
+    std::unique_ptr<can_frame[]> _frames;
+    std::unique_ptr<uint64_t[]> _timestamps;
+    uint64_t _frames_written = 0;
+};
+
+/**
+ * @brief One block of a mapped capture, pointing into the mapping
+ */
+struct CaptureSpan {
+    const can_frame* frames = nullptr;
+    const uint64_t* timestamps_ns = nullptr;
+    size_t count = 0;
+};
+
+/**
+ * @brief Zero-copy reader of binary captures
+ *
+ * The file is memory-mapped read-only; spans point straight into the
+ * mapping and stay valid until close(). A block cut short by a crash of
+ * the writer ends the capture and is reported by truncated().
+ */
+class CaptureReader {
+public:
+    CaptureReader() = default;
+    ~CaptureReader() { close(); }
+
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    /**
+     * @brief Mapping a capture file
+     * @param path File path
+     * @return bool false if the file cannot be mapped or its header does not match this build
+     */
+    bool open(const char* path);
+
+    /**
+     * @brief Unmapping the file, invalidating all spans
+     */
+    void close();
+
+    /**
+     * @brief Next block of frames
+     * @param span Output span into the mapping
+     * @return bool false at the end of the capture
+     */
+    bool next(CaptureSpan& span);
+
+    /**
+     * @brief Starting over from the first block
+     */
+    void rewind() { _offset = sizeof(CaptureFormat::FileHeader); _truncated = false; }
+
+    bool isOpen() const { return _data != nullptr; }
+    ProtocolType protocol() const { return _protocol; }
+    uint64_t createdNs() const { return _created_ns; }
+    bool truncated() const { return _truncated; }
+
+private:
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+    size_t _offset = 0;
+    uint32_t _block_frames = 0;
+    ProtocolType _protocol = ProtocolType::UUgreen;
+    uint64_t _created_ns = 0;
+    bool _truncated = false;
+};
@@ -0,0 +1,65 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#pragma once
+#include <array>
+#include "../libmodul.h"
+
+#ifdef __linux__
+/**
+ * @brief Kernel-side receive filter for module responses
+ *
+ * Builds the CAN_RAW_FILTER list that passes the response IDs of the chosen
+ * protocols and address ranges, so frames of other nodes on the bus (BMS,
+ * charger controllers) are dropped in the kernel instead of waking the
+ * reader. Each address range becomes the fewest aligned (id, mask) blocks
+ * on the address bits of the response ID.
+ *
+ * The filter is exact on the ID fields the parser checks and on the address
+ * range; DLC and command bytes are still checked by the parser. Only
+ * extended data frames pass. UUgreen only checks one ID bit, so its filter
+ * also passes MMeet responses of the same address bits.
+ */
+class CanFilterSet {
+public:
+    static constexpr size_t MAX_FILTERS = 32;
+
+    /**
+     * @brief Adding the responses of a range of modules
+     * @param protocol Type protocol of the modules
+     * @param first_address First module address (0x00-0x7F)
+     * @param count Number of consecutive addresses, clipped at MAX_ADDRESS
+     * @return bool false if the filters do not fit, nothing is added then
+     */
+    bool add(ProtocolType protocol, uint8_t first_address = 0, size_t count = MODULE_ADDRESS_COUNT);
+
+    void clear() { _size = 0; }
+
+    const can_filter* data() const { return _filters.data(); }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    /**
+     * @brief Whether the kernel would deliver a frame with this ID
+     * @param can_id CAN ID including flags
+     * @return bool true if any filter matches
+     */
+    bool accepts(canid_t can_id) const;
+
+    /**
+     * @brief Installing the filters on a raw CAN socket
+     * @param fd CAN_RAW socket
+     * @return bool false if setsockopt fails; an empty set receives nothing
+     */
+    bool install(int fd) const;
+
+    /**
+     * @brief Restoring the default filter that receives every frame
+     * @param fd CAN_RAW socket
+     * @return bool false if setsockopt fails
+     */
+    static bool acceptAll(int fd);
+
+private:
+    std::array<can_filter, MAX_FILTERS> _filters{};
+    size_t _size = 0;
+};
+#endif
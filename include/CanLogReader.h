@@ -0,0 +1,120 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#pragma once
+#include <chrono>
+#include "../libmodul.h"
+
+/**
+ * @brief Text log formats understood by CanLogReader
+ */
+enum class LogFormat {
+    Auto,       // Decided per line: '(' starts a candump line, anything else is tried as ASC
+    Candump,    // candump -l: "(1436509052.249713) can0 12345678#0102030405060708"
+    Asc         // Vector ASC: "   0.010000 1  18FF50E5x   Rx   d 8 01 02 03 04 05 06 07 08"
+};
+
+/**
+ * @brief Counters of a replay run
+ */
+struct ReplayStats {
+    uint64_t frames = 0;        // Frames read from the log
+    uint64_t parsed = 0;        // Frames parsed with ParseResult::OK
+    uint64_t skipped = 0;       // Lines that are not classic CAN frames (headers, CAN FD, errors)
+    uint64_t bytes = 0;         // Log bytes consumed
+    double seconds = 0.0;       // Wall time of the run
+
+    double framesPerSecond() const { return seconds > 0.0 ? frames / seconds : 0.0; }
+};
+
+/**
+ * @brief Streaming reader of candump and ASC text logs
+ *
+ * The log is memory-mapped and scanned in place: frames are decoded straight
+ * from the mapped text into the caller's buffer, with no per-line allocation
+ * or copy. The same text gives the same frames on every run, so a log in a
+ * string literal is a deterministic frame source for tests.
+ */
+class CanLogReader {
+public:
+    static constexpr size_t REPLAY_BATCH = 256;
+
+    explicit CanLogReader(LogFormat format = LogFormat::Auto) : _format(format) {}
+    ~CanLogReader() { close(); }
+
+    CanLogReader(const CanLogReader&) = delete;
+    CanLogReader& operator=(const CanLogReader&) = delete;
+
+    /**
+     * @brief Memory-mapping a log file
+     * @param path Log file path
+     * @return bool false if the file cannot be opened or mapped
+     */
+    bool open(const char* path);
+
+    /**
+     * @brief Reading a log that is already in memory, e.g. a test fixture
+     * @param text Log text, must outlive the reader
+     * @param size Length of text in bytes
+     */
+    void openBuffer(const char* text, size_t size);
+
+    /**
+     * @brief Unmapping the log
+     */
+    void close();
+
+    /**
+     * @brief Starting over from the first line
+     */
+    void rewind();
+
+    /**
+     * @brief Decoding the next frames
+     * @param frames Output frames
+     * @param max_frames Room in frames
+     * @param timestamps_us Optional output of log timestamps in microseconds, room for max_frames
+     * @return size_t Number of frames decoded, 0 at the end of the log
+     */
+    size_t read(can_frame* frames, size_t max_frames, uint64_t* timestamps_us = nullptr);
+
+    /**
+     * @brief Replaying the rest of the log through the batch record parser
+     * @param parser Parser to use
+     * @param protocol Type protocol for interpretation
+     * @param sink Called as sink(const TelemetryRecord*, size_t) per batch;
+     *        records of rejected frames have no fields, as from parseRecords
+     * @return ReplayStats counters and timing of this run
+     */
+    template <typename Sink>
+    ReplayStats replay(const CanParser& parser, ProtocolType protocol, Sink&& sink) {
+        const auto start = std::chrono::steady_clock::now();
+        const uint64_t skipped = _skipped;
+        const size_t offset = _cursor - _begin;
+        can_frame frames[REPLAY_BATCH];
+        TelemetryRecord records[REPLAY_BATCH];
+        ReplayStats stats;
+
+        while (size_t count = read(frames, REPLAY_BATCH)) {
+            stats.frames += count;
+            stats.parsed += parser.parseRecords(frames, count, protocol, records);
+            sink(static_cast<const TelemetryRecord*>(records), count);
+        }
+        stats.skipped = _skipped - skipped;
+        stats.bytes = (_cursor - _begin) - offset;
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+
+    bool isOpen() const { return _begin != nullptr; }
+    size_t size() const { return _end - _begin; }
+    uint64_t skippedLines() const { return _skipped; }
+
+private:
+    LogFormat _format;
+    const char* _begin = nullptr;
+    const char* _end = nullptr;
+    const char* _cursor = nullptr;
+    void* _mapping = nullptr;   // Set when the log is mmap'ed, not for openBuffer
+    size_t _mapping_size = 0;
+    uint64_t _skipped = 0;
+    bool _hex_ids = true;       // ASC "base dec" switches IDs to decimal
+};
@@ -0,0 +1,335 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#pragma once
+#include <atomic>
+#include <array>
+#include <functional>
+#include <memory>
+#include <thread>
+#include "../libmodul.h"
+#include "CanFilter.h"
+
+/**
+ * @brief Lock-free single-producer single-consumer ring of fixed capacity
+ *
+ * One thread pushes, one other thread pops. Head and tail live on separate
+ * cache lines and each side caches the other's index, so the common path
+ * touches no shared line.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /**
+     * @brief Pushing items, producer side
+     * @param items Items to push
+     * @param count Number of items
+     * @return size_t Number of items pushed, less than count when the ring is full
+     */
+    size_t push(const T* items, size_t count) {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (Capacity - (tail - _head_cache) < count)
+            _head_cache = _head.load(std::memory_order_acquire);
+        const size_t free = Capacity - (tail - _head_cache);
+        const size_t pushed = count < free ? count : free;
+        for (size_t i = 0; i < pushed; ++i) _items[(tail + i) & (Capacity - 1)] = items[i];
+        _tail.store(tail + pushed, std::memory_order_release);
+        return pushed;
+    }
+
+    /**
+     * @brief Pushing one item, producer side
+     * @param item Item to push
+     * @return bool false if the ring is full
+     */
+    bool push(const T& item) { return push(&item, 1) == 1; }
+
+    /**
+     * @brief Popping items, consumer side
+     * @param items Output for popped items
+     * @param max_count Room in items
+     * @return size_t Number of items popped
+     */
+    size_t pop(T* items, size_t max_count) {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (_tail_cache - head < max_count)
+            _tail_cache = _tail.load(std::memory_order_acquire);
+        const size_t available = _tail_cache - head;
+        const size_t popped = max_count < available ? max_count : available;
+        for (size_t i = 0; i < popped; ++i) items[i] = _items[(head + i) & (Capacity - 1)];
+        _head.store(head + popped, std::memory_order_release);
+        return popped;
+    }
+
+    /**
+     * @brief Popping one item, consumer side
+     * @param item Output item
+     * @return bool false if the ring is empty
+     */
+    bool pop(T& item) { return pop(&item, 1) == 1; }
+
+    /**
+     * @brief Approximate number of queued items, exact from either side's own thread
+     * @return size_t count
+     */
+    size_t size() const {
+        return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    alignas(64) std::atomic<size_t> _head{0};   // Written by consumer
+    size_t _tail_cache = 0;                     // Consumer's view of _tail
+    alignas(64) std::atomic<size_t> _tail{0};   // Written by producer
+    size_t _head_cache = 0;                     // Producer's view of _head
+    alignas(64) std::array<T, Capacity> _items{};
+};
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+/**
+ * @brief Frame buffer wired to mmsghdr/iovec arrays for sendmmsg/recvmmsg
+ *
+ * Generators write straight into frames(), then one syscall moves the whole
+ * burst. Message headers point into the object, so it is neither copyable
+ * nor movable.
+ */
+template <size_t Capacity>
+class FrameBurst {
+public:
+    FrameBurst() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            _iov[i].iov_base = &_frames[i];
+            _iov[i].iov_len = sizeof(can_frame);
+            _msgs[i].msg_hdr.msg_iov = &_iov[i];
+            _msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+    }
+
+    FrameBurst(const FrameBurst&) = delete;
+    FrameBurst& operator=(const FrameBurst&) = delete;
+
+    can_frame* frames() { return _frames.data(); }
+    const can_frame* frames() const { return _frames.data(); }
+    size_t size() const { return _count; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    /**
+     * @brief Setting the number of valid frames, e.g. after generating into frames()
+     * @param count Number of frames, clamped to capacity
+     */
+    void resize(size_t count) { _count = count < Capacity ? count : Capacity; }
+
+    /**
+     * @brief Sending frames [first, size()) with one sendmmsg call
+     * @param fd Socket descriptor
+     * @param first Index of the first frame to send
+     * @param flags sendmmsg flags
+     * @return int Number of frames sent, -1 with errno on error
+     */
+    int send(int fd, size_t first = 0, int flags = MSG_DONTWAIT) {
+        if (first >= _count) return 0;
+        return ::sendmmsg(fd, &_msgs[first], static_cast<unsigned>(_count - first), flags);
+    }
+
+    /**
+     * @brief Receiving up to capacity() frames with one recvmmsg call, replacing the contents
+     * @param fd Socket descriptor
+     * @param flags recvmmsg flags
+     * @return int Number of frames received, -1 with errno on error
+     * @note Messages that are not exactly one frame (e.g. zero-length at end of stream) are dropped
+     */
+    int receive(int fd, int flags = MSG_DONTWAIT) {
+        const int received = ::recvmmsg(fd, _msgs.data(), static_cast<unsigned>(Capacity), flags, nullptr);
+        _count = 0;
+        for (int i = 0; i < received; ++i) {
+            if (_msgs[i].msg_len != sizeof(can_frame)) continue;
+            if (_count != static_cast<size_t>(i)) _frames[_count] = _frames[i];
+            ++_count;
+        }
+        return received < 0 ? received : static_cast<int>(_count);
+    }
+
+private:
+    std::array<can_frame, Capacity> _frames{};
+    std::array<iovec, Capacity> _iov{};
+    std::array<mmsghdr, Capacity> _msgs{};
+    size_t _count = 0;
+};
+
+/**
+ * @brief Event-driven SocketCAN transport with a dedicated I/O thread
+ *
+ * The I/O thread waits in epoll on the socket and a wakeup eventfd. It
+ * drains every readable frame into the RX queue and flushes the TX queue as
+ * the socket accepts frames. The application sends from one thread and
+ * receives from one thread without locks or blocking syscalls on the bus.
+ * With a receive handler set, received bursts are consumed on the I/O
+ * thread itself and never queued.
+ */
+class CanTransport {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 4096;
+    static constexpr size_t BURST_CAPACITY = 64;
+
+    /**
+     * @brief How the I/O thread talks to the socket
+     */
+    enum class IoMode {
+        Single,     // One read/write syscall per frame
+        Batched     // recvmmsg/sendmmsg of up to BURST_CAPACITY frames per syscall
+    };
+
+    // Receives the frames of one socket burst on the I/O thread
+    using ReceiveHandler = std::function<void(const can_frame* frames, size_t count)>;
+
+    /**
+     * @brief Transport counters, read with stats()
+     */
+    struct Stats {
+        uint64_t rx_frames = 0;     // Frames read from the socket
+        uint64_t tx_frames = 0;     // Frames written to the socket
+        uint64_t rx_dropped = 0;    // Frames lost because the RX queue was full
+        uint64_t tx_errors = 0;     // Frames the socket rejected
+        uint64_t wakeups = 0;       // epoll_wait returns of the I/O thread
+        uint64_t syscalls = 0;      // Socket read/write/recvmmsg/sendmmsg calls
+    };
+
+    /**
+     * @brief Wrapping an open CAN socket (or any frame-per-message socket)
+     * @param fd Socket descriptor, owned and closed by the transport
+     * @param mode Socket I/O mode of the I/O thread
+     */
+    explicit CanTransport(int fd, IoMode mode = IoMode::Batched);
+    ~CanTransport();
+
+    CanTransport(const CanTransport&) = delete;
+    CanTransport& operator=(const CanTransport&) = delete;
+
+    /**
+     * @brief Opening a raw CAN socket bound to an interface
+     * @param interface Interface name, e.g. "can0" or "vcan0"
+     * @param mode Socket I/O mode of the I/O thread
+     * @return std::unique_ptr<CanTransport> transport, nullptr if the interface cannot be opened
+     */
+    static std::unique_ptr<CanTransport> open(const char* interface, IoMode mode = IoMode::Batched);
+
+    /**
+     * @brief Starting the I/O thread
+     * @param cpu CPU to pin the I/O thread to, -1 to let the scheduler place it
+     * @return bool false if the transport is invalid, already running or cannot be pinned
+     */
+    bool start(int cpu = -1);
+
+    /**
+     * @brief Stopping and joining the I/O thread, queued TX frames stay queued
+     */
+    void stop();
+
+    bool isRunning() const { return _running.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Queueing frames for transmission, single producer thread
+     * @param frames Frames to send
+     * @param count Number of frames
+     * @return size_t Number of frames queued, less than count when the TX queue is full
+     */
+    size_t send(const can_frame* frames, size_t count);
+
+    /**
+     * @brief Queueing one frame for transmission, single producer thread
+     * @param frame Frame to send
+     * @return bool false when the TX queue is full
+     */
+    bool send(const can_frame& frame) { return send(&frame, 1) == 1; }
+
+    /**
+     * @brief Taking received frames, single consumer thread
+     * @param frames Output for received frames
+     * @param max_frames Room in frames
+     * @param timeout_ms Time to wait for the first frame, 0 to poll, -1 to wait forever
+     * @return size_t Number of frames received
+     */
+    size_t receive(can_frame* frames, size_t max_frames, int timeout_ms = 0);
+
+    /**
+     * @brief Taking received frames parsed straight into records, single consumer thread
+     * @param parser Parser to use
+     * @param protocol Type protocol for interpretation
+     * @param records Output records, room for max_records
+     * @param max_records Room in records
+     * @param timeout_ms Time to wait for the first frame, 0 to poll, -1 to wait forever
+     * @return size_t Number of frames taken; records of rejected frames have no fields
+     */
+    size_t receiveRecords(const CanParser& parser, ProtocolType protocol,
+                          TelemetryRecord* records, size_t max_records, int timeout_ms = 0);
+
+    /**
+     * @brief Handing received frames to a callback on the I/O thread instead of the RX queue
+     *
+     * The handler runs on the I/O thread for every burst read from the
+     * socket, so it must not block. receive() stays empty while it is set.
+     * @param handler Called with each burst, empty to use the RX queue again
+     * @note Set before start()
+     */
+    void setReceiveHandler(ReceiveHandler handler) { _rx_handler = std::move(handler); }
+
+    /**
+     * @brief Installing kernel receive filters on the socket, safe while running
+     * @param filters Filters to install, see CanFilterSet
+     * @return bool false if the socket is not a CAN_RAW socket or setsockopt fails
+     */
+    bool setFilters(const CanFilterSet& filters) { return filters.install(_fd); }
+
+    /**
+     * @brief Snapshot of the transport counters
+     * @return Stats counters
+     */
+    Stats stats() const;
+
+    int fd() const { return _fd; }
+    IoMode ioMode() const { return _mode; }
+
+private:
+    void run();
+    void drain_socket();
+    void drain_socket_batched();
+    bool flush_tx();
+    bool flush_tx_batched();
+    void update_interest(bool want_writable);
+    bool wait_rx(int timeout_ms);
+    void deliver(const can_frame* frames, size_t count);
+
+    int _fd = -1;
+    IoMode _mode;
+    int _epoll_fd = -1;
+    int _tx_event = -1;     // Wakes the I/O thread: frames queued or stop requested
+    int _rx_event = -1;     // Wakes the consumer: frames received
+
+    std::thread _thread;
+    ReceiveHandler _rx_handler;
+    std::atomic<bool> _running{false};
+    std::atomic<bool> _tx_signalled{false};
+    bool _want_writable = false;
+    bool _hung_up = false;  // Socket removed from epoll after EPOLLHUP
+    bool _tx_pending = false;
+    can_frame _tx_frame{};  // Frame the socket refused with EAGAIN, sent first
+    size_t _tx_sent = 0;    // Frames of _tx_burst already accepted by the socket
+
+    std::atomic<uint64_t> _rx_frames{0};
+    std::atomic<uint64_t> _tx_frames{0};
+    std::atomic<uint64_t> _rx_dropped{0};
+    std::atomic<uint64_t> _tx_errors{0};
+    std::atomic<uint64_t> _wakeups{0};
+    std::atomic<uint64_t> _syscalls{0};
+
+    SpscQueue<can_frame, QUEUE_CAPACITY> _tx_queue;
+    SpscQueue<can_frame, QUEUE_CAPACITY> _rx_queue;
+    FrameBurst<BURST_CAPACITY> _tx_burst;
+    FrameBurst<BURST_CAPACITY> _rx_burst;
+};
+
+#endif
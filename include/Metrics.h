@@ -0,0 +1,209 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include "../libmodul.h"
+
+/**
+ * @brief Hot-path counters and latency histograms
+ *
+ * Built with LIBMODUL_METRICS defined (make METRICS=1), the parser counts
+ * ParseResult outcomes per protocol and frames per command key and times
+ * its batch calls, and PollScheduler records the request to response
+ * latency of every module. Each thread writes a shard of its own with
+ * relaxed loads and stores, so recording takes no lock and no atomic
+ * read-modify-write; snapshot() sums the shards and the totals of threads
+ * that have exited. Without the define the hooks are empty inline
+ * functions and snapshots stay zero.
+ */
+namespace Metrics {
+#ifdef LIBMODUL_METRICS
+    constexpr bool ENABLED = true;
+#else
+    constexpr bool ENABLED = false;
+#endif
+
+    constexpr size_t PROTOCOL_COUNT = 2;
+    constexpr size_t RESULT_COUNT = 3;
+    constexpr size_t COMMAND_KEYS = 256;
+
+    /**
+     * @brief Log-linear bucket layout of the histograms, as in HdrHistogram
+     *
+     * Values below SUB_COUNT get a bucket each; every power of two above
+     * is split into SUB_COUNT buckets, so a bucket is at most 1/8 of its
+     * value wide. Values of 2^MAX_BITS and more share the last bucket.
+     */
+    namespace Buckets {
+        constexpr unsigned SUB_BITS = 3;
+        constexpr unsigned SUB_COUNT = 1u << SUB_BITS;
+        constexpr unsigned MAX_BITS = 32;
+        constexpr size_t COUNT = (MAX_BITS - SUB_BITS + 1) * SUB_COUNT;
+
+        constexpr size_t index(uint64_t value) {
+            if (value < SUB_COUNT) return static_cast<size_t>(value);
+            if (value >> MAX_BITS) return COUNT - 1;
+            const unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(value));
+            return (msb - SUB_BITS + 1) * SUB_COUNT + ((value >> (msb - SUB_BITS)) & (SUB_COUNT - 1));
+        }
+
+        // Smallest value counted in a bucket
+        constexpr uint64_t lower(size_t bucket) {
+            if (bucket < SUB_COUNT) return bucket;
+            return uint64_t(SUB_COUNT + bucket % SUB_COUNT) << (bucket / SUB_COUNT - 1);
+        }
+
+        // Largest value counted in a bucket
+        constexpr uint64_t upper(size_t bucket) {
+            return bucket + 1 < COUNT ? lower(bucket + 1) - 1 : UINT64_MAX;
+        }
+    }
+
+    /**
+     * @brief Histogram copied out of the shards
+     */
+    struct Histogram {
+        std::array<uint64_t, Buckets::COUNT> counts{};
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+
+        void record(uint64_t value) {
+            ++counts[Buckets::index(value)];
+            ++count;
+            sum += value;
+            if (value > max) max = value;
+        }
+
+        double mean() const { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+
+        /**
+         * @brief Value below which a share of the samples lies
+         * @param quantile Share in [0, 1], e.g. 0.99
+         * @return uint64_t upper bound of the bucket holding that sample, at most max; 0 when empty
+         */
+        uint64_t percentile(double quantile) const;
+    };
+
+    /**
+     * @brief Totals of all threads at one point in time
+     */
+    struct Snapshot {
+        // Frames per ParseResult, indexed [ProtocolType][ParseResult]
+        std::array<std::array<uint64_t, RESULT_COUNT>, PROTOCOL_COUNT> outcomes{};
+        // Frames with a valid ID per command key (UUgreen data[1], MMeet data[3]; key 0 also holds foreign MMeet commands)
+        std::array<std::array<uint64_t, COMMAND_KEYS>, PROTOCOL_COUNT> commands{};
+        Histogram parse_ns;                                     // Batch parse time per frame, ns
+        std::array<Histogram, MODULE_ADDRESS_COUNT> latency_us; // Request to response latency per module, us
+
+        uint64_t frames(ProtocolType protocol, ParseResult result) const {
+            return outcomes[static_cast<size_t>(protocol)][static_cast<size_t>(result)];
+        }
+    };
+
+    /**
+     * @brief Summing the shards of all threads
+     * @param out Snapshot to fill; reused by exporters, it is about 250 KiB
+     * @note Counters keep running, exporters report differences between snapshots
+     */
+    void snapshot(Snapshot& out);
+
+    /**
+     * @brief Dispatch table key of a frame, as used by the parser
+     */
+    inline uint8_t command_key(ProtocolType protocol, const can_frame& frame) {
+        return protocol == ProtocolType::MMeet
+            ? (frame.data[2] == MMEET_TELEMETRY_CMD_HIGH ? frame.data[3] : 0)
+            : frame.data[1];
+    }
+
+#ifdef LIBMODUL_METRICS
+    namespace detail {
+        using Counter = std::atomic<uint64_t>;
+
+        // Single writer: a plain load and store instead of a locked add
+        inline void bump(Counter& counter, uint64_t amount = 1) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        struct HistogramCells {
+            std::array<Counter, Buckets::COUNT> counts;
+            Counter sum;
+            Counter max;
+
+            void record(uint64_t value) {
+                bump(counts[Buckets::index(value)]);
+                bump(sum, value);
+                if (value > max.load(std::memory_order_relaxed)) max.store(value, std::memory_order_relaxed);
+            }
+        };
+
+        struct Shard {
+            Counter outcomes[PROTOCOL_COUNT][RESULT_COUNT];
+            Counter commands[PROTOCOL_COUNT][COMMAND_KEYS];
+            HistogramCells parse_ns;
+            HistogramCells latency_us[MODULE_ADDRESS_COUNT];
+        };
+
+        // Shard of the calling thread, registered on first use
+        Shard& shard();
+    }
+
+    /**
+     * @brief Counting the frames of one parse call on the calling thread's shard
+     */
+    class FrameCounter {
+    public:
+        explicit FrameCounter(ProtocolType protocol)
+            : _shard(detail::shard()), _protocol(static_cast<size_t>(protocol)) {}
+
+        void add(ParseResult result, uint8_t key) {
+            detail::bump(_shard.outcomes[_protocol][static_cast<size_t>(result)]);
+            if (result != ParseResult::INVALID_FRAME) detail::bump(_shard.commands[_protocol][key]);
+        }
+
+    private:
+        detail::Shard& _shard;
+        size_t _protocol;
+    };
+
+    /**
+     * @brief Timing one batch parse call, recorded as ns per frame on destruction
+     */
+    class BatchTimer {
+    public:
+        explicit BatchTimer(size_t frames) : _frames(frames), _start(std::chrono::steady_clock::now()) {}
+        ~BatchTimer() {
+            if (!_frames) return;
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - _start).count();
+            detail::shard().parse_ns.record(static_cast<uint64_t>(elapsed) / _frames);
+        }
+        BatchTimer(const BatchTimer&) = delete;
+        BatchTimer& operator=(const BatchTimer&) = delete;
+
+    private:
+        size_t _frames;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    inline void record_latency(uint8_t address, std::chrono::steady_clock::duration latency) {
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+        detail::shard().latency_us[address & (MODULE_ADDRESS_COUNT - 1)].record(us > 0 ? static_cast<uint64_t>(us) : 0);
+    }
+#else
+    class FrameCounter {
+    public:
+        explicit FrameCounter(ProtocolType) {}
+        void add(ParseResult, uint8_t) {}
+    };
+
+    class BatchTimer {
+    public:
+        explicit BatchTimer(size_t) {}
+    };
+
+    inline void record_latency(uint8_t, std::chrono::steady_clock::duration) {}
+#endif
+}
@@ -0,0 +1,162 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#pragma once
+#include <chrono>
+#include <optional>
+#include <random>
+#include <vector>
+#include "../libmodul.h"
+#ifdef __linux__
+#include "CanTransport.h"
+#endif
+
+/**
+ * @brief Virtual UUgreen or MMeet modules for load and control-path testing
+ *
+ * Decodes the request and control frames our generators emit, keeps the
+ * setpoints, mode and enable state of each module and answers telemetry
+ * requests with response frames CanParser accepts. Responses are held back
+ * by a configurable latency and jitter, can be dropped at random, and
+ * offline modules stay silent. The simulator does no I/O and takes the
+ * time from the caller, so it works as an in-process loopback or, through
+ * serve(), on a CAN socket such as vcan.
+ *
+ * Telemetry is plausible rather than physical: an enabled module outputs
+ * its voltage and current setpoints, temperature rises with current and
+ * the status word has bit 0 set while the output is off.
+ *
+ * Group and broadcast control frames reach every online module of the
+ * group (see setGroup()); group telemetry requests are not answered.
+ */
+class ModuleSimulator {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Mode : uint8_t { Low, High, Auto };
+
+    /**
+     * @brief Behaviour of the simulated bus
+     */
+    struct Config {
+        Clock::duration latency = std::chrono::milliseconds(1);    // Request to response delay
+        Clock::duration jitter = Clock::duration::zero();          // Uniform extra delay, up to this
+        double drop_rate = 0.0;                                     // Probability a response is lost
+        uint32_t seed = 1;                                          // Seed of jitter and drops
+    };
+
+    /**
+     * @brief State of one simulated module
+     */
+    struct ModuleState {
+        uint32_t voltage_set_mv = 0;
+        uint32_t current_set_ma = 0;
+        Mode mode = Mode::Low;
+        bool enabled = false;
+        bool online = true;
+        uint8_t group = 0;          // Group of generateGroup* frames, BROADCAST_GROUP reaches all
+    };
+
+    /**
+     * @brief Simulator counters
+     */
+    struct Stats {
+        uint64_t requests = 0;      // Telemetry requests addressed to a simulated module
+        uint64_t controls = 0;      // Control frames applied, a group frame counts once
+        uint64_t responses = 0;     // Response frames handed out by transmit() or sent by serve()
+        uint64_t dropped = 0;       // Responses lost to drop_rate
+        uint64_t ignored = 0;       // Frames for offline or unknown modules, or not decodable
+    };
+
+    /**
+     * @brief Creating a fleet of modules on consecutive addresses
+     * @param protocol Protocol the modules speak
+     * @param first_address Address of the first module
+     * @param count Number of modules, clamped to the address space
+     * @param config Latency, jitter and drop behaviour
+     */
+    ModuleSimulator(ProtocolType protocol, uint8_t first_address, size_t count, Config config);
+    ModuleSimulator(ProtocolType protocol, uint8_t first_address, size_t count)
+        : ModuleSimulator(protocol, first_address, count, Config{}) {}
+
+    /**
+     * @brief Handing frames from the controller to the modules
+     * @param frames Frames seen on the bus
+     * @param count Number of frames
+     * @param now Current time, responses are due at now + latency
+     * @return size_t Number of frames a simulated module acted on
+     */
+    size_t receive(const can_frame* frames, size_t count, Clock::time_point now);
+
+    /**
+     * @brief Taking the responses that are due
+     * @param now Current time
+     * @param frames Output for response frames
+     * @param max_frames Room in frames
+     * @return size_t Number of responses, oldest due first
+     */
+    size_t transmit(Clock::time_point now, can_frame* frames, size_t max_frames);
+
+    /**
+     * @brief Time the next response becomes due
+     * @return std::optional<Clock::time_point> due time, nullopt if nothing is pending
+     */
+    std::optional<Clock::time_point> nextResponse() const;
+
+    /**
+     * @brief Taking a module off the bus or bringing it back
+     * @param address Module address
+     * @param online false to silence the module
+     * @return bool false if the address is not simulated
+     */
+    bool setOnline(uint8_t address, bool online);
+
+    /**
+     * @brief Assigning a module to a group
+     * @param address Module address
+     * @param group Group number as carried in group frames
+     * @return bool false if the address is not simulated
+     */
+    bool setGroup(uint8_t address, uint8_t group);
+
+    /**
+     * @brief Current state of a module
+     * @param address Module address
+     * @return std::optional<ModuleState> state, nullopt if the address is not simulated
+     */
+    std::optional<ModuleState> state(uint8_t address) const;
+
+    size_t pending() const { return _pending.size(); }
+    Stats stats() const { return _stats; }
+
+#ifdef __linux__
+    /**
+     * @brief Moving frames between a CAN transport and the modules, one step
+     * @param bus Running transport on the simulated bus
+     * @param now Current time
+     * @return size_t Number of responses sent
+     */
+    size_t serve(CanTransport& bus, Clock::time_point now);
+#endif
+
+private:
+    struct Pending {
+        Clock::time_point due;
+        uint64_t sequence;          // Keeps equal due times in request order
+        can_frame frame;
+    };
+
+    bool decode(const can_frame& frame, uint8_t& address, uint16_t& command, uint32_t& value, bool& group) const;
+    bool apply_group(uint8_t group, uint16_t command, uint32_t value);
+    bool apply_control(ModuleState& module, uint16_t command, uint32_t value) const;
+    can_frame make_response(uint8_t address, const ModuleState& module, RequestType request) const;
+    void push_pending(Pending pending);
+    Pending pop_pending();
+
+    ProtocolType _protocol;
+    uint8_t _first_address;
+    Config _config;
+    std::vector<ModuleState> _modules;
+    std::vector<Pending> _pending;  // Min-heap on (due, sequence)
+    uint64_t _sequence = 0;
+    std::mt19937 _random;
+    Stats _stats;
+};
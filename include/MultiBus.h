@@ -0,0 +1,143 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "../libmodul.h"
+#include "CanTransport.h"
+
+#ifdef __linux__
+
+/**
+ * @brief Several CAN interfaces, each with its own pinned I/O thread, parser and registry
+ *
+ * Every bus is a CanTransport whose I/O thread parses received bursts and
+ * folds them into the bus's own ModuleRegistry shard, so a frame never
+ * leaves the thread that read it and buses share no writable state. Any
+ * thread reads modules or aggregates across buses through the registries'
+ * seqlocks, without a global lock.
+ *
+ * Buses are added before start(); the set of buses is fixed while running.
+ */
+class MultiBusManager {
+public:
+    static constexpr size_t MAX_BUSES = 16;
+
+    /**
+     * @brief Totals over the modules that have reported, see totals()
+     */
+    struct Totals {
+        size_t modules = 0;         // Modules with at least one field
+        uint64_t current_ma = 0;    // Sum of output currents, mA
+        uint64_t power_mw = 0;      // Sum of voltage * current, mW
+    };
+
+    /**
+     * @brief Ingest counters of one bus
+     */
+    struct BusStats {
+        uint64_t frames = 0;        // Frames parsed on the bus
+        uint64_t rejected = 0;      // Frames that were not a telemetry response of the bus protocol
+    };
+
+    MultiBusManager() = default;
+    ~MultiBusManager();
+
+    MultiBusManager(const MultiBusManager&) = delete;
+    MultiBusManager& operator=(const MultiBusManager&) = delete;
+
+    /**
+     * @brief Adding a bus over an existing transport
+     * @param transport Transport of the bus, not yet started
+     * @param protocol Protocol of the modules on the bus
+     * @param cpu CPU to pin the bus I/O thread to, -1 to let the scheduler place it
+     * @return int Bus index, -1 if running, full or the transport is null
+     */
+    int addBus(std::unique_ptr<CanTransport> transport, ProtocolType protocol, int cpu = -1);
+
+    /**
+     * @brief Adding a bus on a CAN interface
+     * @param interface Interface name, e.g. "can0"
+     * @param protocol Protocol of the modules on the bus
+     * @param cpu CPU to pin the bus I/O thread to, -1 to let the scheduler place it
+     * @param mode Socket I/O mode of the I/O thread
+     * @return int Bus index, -1 if the interface cannot be opened or the bus cannot be added
+     */
+    int open(const char* interface, ProtocolType protocol, int cpu = -1,
+             CanTransport::IoMode mode = CanTransport::IoMode::Batched);
+
+    /**
+     * @brief Starting the I/O thread of every bus
+     * @return bool false if already running or a bus fails to start; then none is running
+     */
+    bool start();
+
+    /**
+     * @brief Stopping and joining every I/O thread
+     */
+    void stop();
+
+    bool isRunning() const { return _running; }
+    size_t busCount() const { return _buses.size(); }
+
+    /**
+     * @brief Queueing frames on a bus, single producer thread per bus
+     * @param bus Bus index
+     * @param frames Frames to send
+     * @param count Number of frames
+     * @return size_t Number of frames queued, 0 for an unknown bus
+     */
+    size_t send(size_t bus, const can_frame* frames, size_t count);
+
+    /**
+     * @brief Reading a consistent snapshot of a module on a bus
+     * @param bus Bus index
+     * @param address Module address, masked to 7 bits
+     * @param record Output snapshot
+     * @return bool true if the module has reported at least one field
+     */
+    bool read(size_t bus, uint8_t address, TelemetryRecord& record) const;
+
+    /**
+     * @brief Summing the modules of one bus
+     * @param bus Bus index
+     * @return Totals totals, empty for an unknown bus
+     */
+    Totals totals(size_t bus) const;
+
+    /**
+     * @brief Summing the modules of every bus, each slot read without locking
+     * @return Totals totals
+     */
+    Totals totals() const;
+
+    /**
+     * @brief Ingest counters of a bus
+     * @param bus Bus index
+     * @return BusStats counters, zero for an unknown bus
+     */
+    BusStats stats(size_t bus) const;
+
+    const ModuleRegistry& registry(size_t bus) const { return _buses[bus]->registry; }
+    CanTransport& transport(size_t bus) { return *_buses[bus]->transport; }
+    ProtocolType protocol(size_t bus) const { return _buses[bus]->protocol; }
+
+private:
+    // Written by the bus I/O thread only, on its own cache lines
+    struct alignas(64) Bus {
+        std::unique_ptr<CanTransport> transport;
+        ProtocolType protocol;
+        int cpu;
+        CanParser parser;
+        ModuleRegistry registry;
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> rejected{0};
+    };
+
+    static void ingest(Bus& bus, const can_frame* frames, size_t count);
+
+    std::vector<std::unique_ptr<Bus>> _buses;
+    bool _running = false;
+};
+
+#endif
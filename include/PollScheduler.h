@@ -0,0 +1,171 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#pragma once
+#include <chrono>
+#include <vector>
+#include "../libmodul.h"
+#include "TimingWheel.h"
+
+/**
+ * @brief One telemetry request to one module
+ */
+struct PollRequest {
+    uint8_t address;
+    RequestType request;
+};
+
+/**
+ * @brief Request kind answered by a telemetry field
+ * @param field ParsedData::Field of a response
+ * @return std::optional<RequestType> request, nullopt for ADDR or unknown fields
+ */
+constexpr std::optional<RequestType> request_for_field(uint8_t field) {
+    switch(field) {
+        case ParsedData::TEMP: return RequestType::Temp;
+        case ParsedData::CAPABILITY: return RequestType::CurrentCapability;
+        case ParsedData::STATUS: return RequestType::Flags;
+        case ParsedData::VOLTAGE: return RequestType::Voltage;
+        case ParsedData::CURRENT: return RequestType::Current;
+        default: return std::nullopt;
+    }
+}
+
+/**
+ * @brief Pipelined telemetry poller keeping several requests in flight
+ *
+ * Requests wait in a pending queue and are issued while fewer than
+ * max_in_flight are outstanding. A response is matched to its request by
+ * (address, request kind), the kind derived from the response command
+ * through the parser dispatch tables, so alternative response commands
+ * match too. Every request in flight arms a timer in a hashed timing
+ * wheel, a response cancels it and unanswered requests expire after the
+ * timeout. The scheduler does no I/O and takes the time from the caller.
+ */
+class PollScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t KEY_COUNT = MODULE_ADDRESS_COUNT * REQUEST_TYPE_COUNT;
+
+    /**
+     * @brief Scheduler counters
+     */
+    struct Stats {
+        uint64_t issued = 0;        // Request frames handed out by nextFrames()
+        uint64_t completed = 0;     // Requests matched by a response
+        uint64_t timed_out = 0;     // Requests expired without a response
+        uint64_t unmatched = 0;     // Valid responses with no request in flight
+    };
+
+    /**
+     * @brief Creating a scheduler for one bus
+     * @param protocol Protocol of the modules on the bus
+     * @param max_in_flight Outstanding requests allowed at once (at least 1)
+     * @param timeout Time to wait for each response
+     */
+    PollScheduler(ProtocolType protocol, size_t max_in_flight, Clock::duration timeout);
+
+    /**
+     * @brief Queueing a request
+     * @param request Module address (masked to 7 bits) and request kind
+     * @return bool false if the same request is already pending or in flight
+     */
+    bool enqueue(PollRequest request);
+
+    /**
+     * @brief Queueing every request kind for a range of modules
+     * @param first_address First module address
+     * @param count Number of modules, clamped to 128
+     * @return size_t Number of requests queued
+     */
+    size_t enqueueSweep(uint8_t first_address, size_t count);
+
+    /**
+     * @brief Issuing queued requests while the in-flight window has room
+     * @param now Current time, deadlines are armed from it
+     * @param frames Output request frames
+     * @param max_frames Room in frames
+     * @return size_t Number of frames to transmit
+     */
+    size_t nextFrames(Clock::time_point now, can_frame* frames, size_t max_frames);
+
+    /**
+     * @brief Matching a response frame to its request
+     * @param frame Received frame
+     * @return std::optional<PollRequest> completed request, nullopt if nothing matched
+     */
+    std::optional<PollRequest> onResponse(const can_frame& frame);
+
+    /**
+     * @brief Matching an already parsed response to its request
+     * @param record Record from CanParser::parseRecord(s)
+     * @return std::optional<PollRequest> completed request, nullopt if nothing matched
+     */
+    std::optional<PollRequest> onResponse(const TelemetryRecord& record);
+
+    /**
+     * @brief Matching many parsed responses, e.g. from CanTransport::receiveRecords
+     * @param records Records to match, records without fields are skipped
+     * @param count Number of records
+     * @return size_t Number of requests completed
+     */
+    size_t onResponses(const TelemetryRecord* records, size_t count);
+
+    /**
+     * @brief Matching parsed responses received at a known time
+     * @param now Receive time on the clock given to nextFrames(), for the Metrics latency;
+     *            the overloads without it read Clock::now() when metrics are enabled
+     * @return as onResponse(record) and onResponses(records, count)
+     */
+    std::optional<PollRequest> onResponse(const TelemetryRecord& record, Clock::time_point now);
+    size_t onResponses(const TelemetryRecord* records, size_t count, Clock::time_point now);
+
+    /**
+     * @brief Expiring requests whose deadline has passed
+     * @param now Current time
+     * @param timed_out Output for expired requests, nullptr to discard them
+     * @param max_timed_out Room in timed_out; further expired requests are reported by the next call
+     * @return size_t Number of expired requests written to timed_out
+     */
+    size_t expire(Clock::time_point now, PollRequest* timed_out, size_t max_timed_out);
+
+    /**
+     * @brief Time at which expire() will report the earliest request in flight
+     * @return std::optional<Clock::time_point> time for the caller's wait, nullopt if nothing is in flight
+     * @note Deadlines are tracked in 1/64 of the timeout, expiry is at most that late
+     */
+    std::optional<Clock::time_point> nextDeadline() const { return _wheel.nextExpiry(); }
+
+    size_t inFlight() const { return _in_flight; }
+    size_t pending() const { return _pending_count; }
+    bool idle() const { return _in_flight == 0 && _pending_count == 0; }
+    Stats stats() const { return _stats; }
+
+private:
+    enum class KeyState : uint8_t { Idle, Pending, InFlight };
+
+    static uint16_t key_of(uint8_t address, RequestType request) {
+        return static_cast<uint16_t>((address & (MODULE_ADDRESS_COUNT - 1)) * REQUEST_TYPE_COUNT
+                                     + static_cast<size_t>(request));
+    }
+    static PollRequest request_of(uint16_t key) {
+        return {static_cast<uint8_t>(key / REQUEST_TYPE_COUNT), static_cast<RequestType>(key % REQUEST_TYPE_COUNT)};
+    }
+    std::optional<PollRequest> complete(uint8_t address, uint8_t field, Clock::time_point now);
+
+    ProtocolType _protocol;
+    CanParser _parser;
+    size_t _max_in_flight;
+    Clock::duration _timeout;
+
+    std::array<KeyState, KEY_COUNT> _state{};
+    std::array<TimingWheel::TimerId, KEY_COUNT> _timers{};
+    std::array<Clock::time_point, KEY_COUNT> _sent{};   // Issue time, kept for Metrics latency only
+    std::array<uint16_t, KEY_COUNT> _pending{};     // Ring of keys, each key at most once
+    size_t _pending_head = 0;
+    size_t _pending_count = 0;
+
+    TimingWheel _wheel;
+    std::vector<uint16_t> _expired;     // Expired keys not yet reported by expire()
+    size_t _expired_head = 0;
+    size_t _in_flight = 0;
+    Stats _stats;
+};
@@ -0,0 +1,137 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#pragma once
+#include <array>
+#include <chrono>
+#include "../libmodul.h"
+
+/**
+ * @brief Setpoint layer over CanProtocolManager that only sends changes
+ *
+ * The control loop sets voltage and current for every module each tick;
+ * the cache encodes each value with the protocol generator and keeps the
+ * latest frame per (address, setpoint). flush() emits a frame only where
+ * the encoded value differs from the one last sent, so repeated identical
+ * setpoints stay off the bus and several updates within a tick collapse
+ * into the latest. A setpoint unchanged for refresh_period is sent again,
+ * so a module that missed a frame or restarted converges anyway.
+ */
+class SetpointCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Setpoint : uint8_t { Voltage, Current };
+    static constexpr size_t SETPOINT_COUNT = 2;
+
+    /**
+     * @brief Cache counters
+     */
+    struct Stats {
+        uint64_t updates = 0;       // setVoltage/setCurrent calls
+        uint64_t suppressed = 0;    // Updates encoding to the value already sent
+        uint64_t coalesced = 0;     // Updates replacing a change not yet flushed
+        uint64_t sent = 0;          // Frames for changed setpoints
+        uint64_t refreshed = 0;     // Frames repeating an unchanged setpoint after refresh_period
+    };
+
+    /**
+     * @brief Creating a cache for one bus
+     * @param protocol Protocol of the modules
+     * @param refresh_period Time after which an unchanged setpoint is sent again
+     */
+    SetpointCache(ProtocolType protocol, Clock::duration refresh_period);
+
+    /**
+     * @brief Staging a voltage setpoint
+     * @param module_address Device address (7 bits)
+     * @param voltage Voltage value (in V units)
+     * @return bool true if the encoded value differs from the one on the bus
+     */
+    bool setVoltage(uint8_t module_address, float voltage) {
+        return stage(module_address, Setpoint::Voltage, _manager.generateVoltageSet(module_address, voltage));
+    }
+
+    /**
+     * @brief Staging a current setpoint
+     * @param module_address Device address (7 bits)
+     * @param current Current value (in A units)
+     * @return bool true if the encoded value differs from the one on the bus
+     */
+    bool setCurrent(uint8_t module_address, float current) {
+        return stage(module_address, Setpoint::Current, _manager.generateCurrentSet(module_address, current));
+    }
+
+    /**
+     * @brief Staging a voltage setpoint in mV, without floating point
+     * @param module_address Device address (7 bits)
+     * @param voltage Voltage value (in mV units)
+     * @return bool true if the value differs from the one on the bus
+     */
+    bool setVoltage(uint8_t module_address, Millivolts voltage) {
+        return stage(module_address, Setpoint::Voltage, _manager.generateVoltageSet(module_address, voltage));
+    }
+
+    /**
+     * @brief Staging a current setpoint in mA, without floating point
+     * @param module_address Device address (7 bits)
+     * @param current Current value (in mA units)
+     * @return bool true if the value differs from the one on the bus
+     */
+    bool setCurrent(uint8_t module_address, Milliamps current) {
+        return stage(module_address, Setpoint::Current, _manager.generateCurrentSet(module_address, current));
+    }
+
+    /**
+     * @brief Frames to transmit at the end of a tick
+     * @param now Current time, refresh deadlines are measured from it
+     * @param frames Output set frames, changes first, then refreshes
+     * @param max_frames Room in frames; what does not fit goes out with the next flush
+     * @return size_t Number of frames to transmit
+     */
+    size_t flush(Clock::time_point now, can_frame* frames, size_t max_frames);
+
+    /**
+     * @brief Forgetting what was sent to a module, e.g. after it went offline
+     * @param module_address Device address
+     * @note Staged setpoints of the module are sent by the next flush
+     */
+    void invalidate(uint8_t module_address);
+
+    /**
+     * @brief Forgetting what was sent to every module
+     */
+    void invalidateAll();
+
+    /**
+     * @brief Encoded setpoint last handed out by flush()
+     * @param module_address Device address
+     * @param setpoint Voltage or current
+     * @return std::optional<can_frame> frame, nullopt if nothing was sent since the last invalidate
+     */
+    std::optional<can_frame> lastSent(uint8_t module_address, Setpoint setpoint) const;
+
+    size_t dirty() const { return _dirty_count; }
+    Stats stats() const { return _stats; }
+
+private:
+    struct Slot {
+        can_frame wanted{};                 // Latest staged frame
+        uint64_t sent_payload = 0;          // Data bytes of the frame last sent
+        Clock::time_point sent_at{};
+        bool staged = false;                // wanted holds a value
+        bool sent = false;                  // sent_payload and sent_at are valid
+        bool dirty = false;                 // wanted differs from what was sent
+    };
+
+    static size_t slot_of(uint8_t address, Setpoint setpoint) {
+        return (address & (MODULE_ADDRESS_COUNT - 1)) * SETPOINT_COUNT + static_cast<size_t>(setpoint);
+    }
+    bool stage(uint8_t address, Setpoint setpoint, const can_frame& frame);
+    void mark_sent(Slot& slot, Clock::time_point now);
+
+    CanProtocolManager _manager;
+    Clock::duration _refresh_period;
+    std::array<Slot, MODULE_ADDRESS_COUNT * SETPOINT_COUNT> _slots{};
+    size_t _dirty_count = 0;
+    Clock::time_point _next_refresh = Clock::time_point::max();  // No clean sent slot is due before this
+    Stats _stats;
+};
@@ -0,0 +1,129 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief Hashed timing wheel for many concurrent deadlines
+ *
+ * Deadlines are rounded up to whole ticks and hashed into a power-of-two
+ * ring of slots by absolute tick. Arm and cancel are O(1) through an
+ * intrusive list in a pooled node array; advance() visits only the slots
+ * of elapsed ticks. Timers never fire early and fire at most one tick late.
+ */
+class TimingWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = uint64_t;                   // Node index and generation
+    static constexpr TimerId INVALID_TIMER = 0;
+
+    /**
+     * @brief Creating an empty wheel
+     * @param tick Resolution of the wheel
+     * @param slot_count Number of slots, rounded up to a power of two
+     * @param origin Time of tick 0
+     */
+    TimingWheel(Clock::duration tick, size_t slot_count, Clock::time_point origin = Clock::time_point{});
+
+    /**
+     * @brief Arming a timer
+     * @param deadline Time at which the timer expires
+     * @param tag Caller value reported on expiry
+     * @return TimerId id for cancel()
+     */
+    TimerId arm(Clock::time_point deadline, uint32_t tag);
+
+    /**
+     * @brief Cancelling an armed timer
+     * @param id Timer returned by arm()
+     * @return bool false if the timer already expired or was cancelled
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * @brief Expiring every timer whose tick has elapsed
+     * @param now Current time
+     * @param on_expire Called as on_expire(tag, deadline) for each expired timer,
+     *        may arm and cancel timers
+     * @return size_t Number of timers expired
+     */
+    template <typename OnExpire>
+    size_t advance(Clock::time_point now, OnExpire&& on_expire) {
+        const uint64_t target = elapsed_ticks(now);
+        size_t expired = 0;
+        if (target <= _current_tick) return 0;
+
+        if (target - _current_tick >= _slots.size()) {
+            // Gap longer than a revolution: every slot holds due timers
+            _current_tick = target;
+            for (size_t slot = 0; slot < _slots.size(); ++slot) expired += fire(collect(slot, target), on_expire);
+        } else {
+            while (_current_tick < target) {
+                ++_current_tick;
+                expired += fire(collect(_current_tick & _mask, _current_tick), on_expire);
+            }
+        }
+        return expired;
+    }
+
+    /**
+     * @brief Exact deadline of the earliest armed timer
+     * @return std::optional<Clock::time_point> deadline, nullopt if no timer is armed
+     */
+    std::optional<Clock::time_point> nextDeadline() const;
+
+    /**
+     * @brief Time at which advance() will fire the earliest armed timer
+     * @return std::optional<Clock::time_point> tick boundary at or after nextDeadline(), nullopt if empty
+     */
+    std::optional<Clock::time_point> nextExpiry() const;
+
+    size_t size() const { return _armed; }
+    bool empty() const { return _armed == 0; }
+    Clock::duration tick() const { return _tick; }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+        uint32_t generation = 1;
+        uint32_t tag = 0;
+        uint64_t tick = 0;
+        Clock::time_point deadline{};
+        bool armed = false;
+    };
+
+    uint64_t elapsed_ticks(Clock::time_point now) const;
+    uint64_t deadline_tick(Clock::time_point deadline) const;
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+    uint32_t collect(size_t slot, uint64_t up_to_tick);
+
+    template <typename OnExpire>
+    size_t fire(uint32_t chain, OnExpire& on_expire) {
+        size_t fired = 0;
+        while (chain != NIL) {
+            const uint32_t index = chain;
+            chain = _nodes[index].next;
+            const uint32_t tag = _nodes[index].tag;
+            const Clock::time_point deadline = _nodes[index].deadline;
+            release(index);
+            on_expire(tag, deadline);
+            ++fired;
+        }
+        return fired;
+    }
+
+    Clock::duration _tick;
+    Clock::time_point _origin;
+    std::vector<uint32_t> _slots;   // Head node of each slot
+    uint64_t _mask;
+    uint64_t _current_tick = 0;     // Last tick processed by advance()
+    std::vector<Node> _nodes;
+    uint32_t _free = NIL;           // Free list through Node::next
+    size_t _armed = 0;
+};
@@ -1,15 +1,20 @@
 /* MIT License Copyright (c) 2025 SmartElectroni*/
 #pragma once
 #include <cstdint>
+#include <cstddef>
 #include <memory>
 #include <array>
+#include <atomic>
 #include <optional>
+#include <tuple>
 #include <bitset>
+#include <cstring>
 
 namespace {
     constexpr uint8_t CAN_INV_DLC = 8;
+    constexpr uint32_t CAN_INV_EFF_FLAG = 0x80000000;
     constexpr uint32_t UUGREEN_MASK = 0x2000000;
-    constexpr uint32_t MMEET_MASK = 0xFFFF0000;
+    constexpr uint32_t MMEET_MASK = 0x1FFF0000;     // ID bits only, frame flags are ignored
     constexpr uint32_t MMEET_ID = 0x060F0000;
 }
 
@@ -38,6 +43,608 @@ enum class ProtocolType {
     // Add other protocols as needed
 };
 
+/**
+ * @brief Telemetry request kinds (one per generate*Request method)
+ */
+enum class RequestType {
+    Temp,
+    CurrentCapability,
+    Flags,
+    Voltage,
+    Current
+};
+
+constexpr size_t REQUEST_TYPE_COUNT = 5;
+static_assert(static_cast<size_t>(RequestType::Current) + 1 == REQUEST_TYPE_COUNT, "RequestType count");
+constexpr size_t MODULE_ADDRESS_COUNT = 128;
+constexpr uint8_t BROADCAST_GROUP = 0;     // Group number of generateGroup* frames that reach every module
+
+/**
+ * @brief Rounding a value to 0.001 units, the resolution of set frames
+ * @param value Value in V or A units, negative values clamp to 0
+ * @return uint32_t value in 0.001 units, saturated to the 32-bit payload
+ */
+constexpr uint32_t round_to_milli(float value) {
+    if (!(value > 0.0f)) return 0;
+    if (value >= 4294967.0f) return UINT32_MAX;
+    return static_cast<uint32_t>(static_cast<double>(value) * 1000.0 + 0.5);
+}
+
+/**
+ * @brief Voltage setpoint in mV, encoded into set frames without floating point
+ */
+struct Millivolts {
+    uint32_t value = 0;
+
+    static constexpr Millivolts fromVolts(float volts) { return {round_to_milli(volts)}; }
+};
+
+/**
+ * @brief Current setpoint in mA, encoded into set frames without floating point
+ */
+struct Milliamps {
+    uint32_t value = 0;
+
+    static constexpr Milliamps fromAmps(float amps) { return {round_to_milli(amps)}; }
+};
+
+namespace UUgreenConstants {
+    constexpr uint8_t PREAMBLE = 0x12;
+    constexpr uint8_t CONTROL_PREFIX = 0x10;
+    
+    // cmd request
+    constexpr uint8_t TEMP_CMD = 0x1E;
+    constexpr uint8_t CURRENT_CAP_CMD = 0x68;
+    constexpr uint8_t FLAGS_CMD = 0x08;
+    constexpr uint8_t VOLTAGE_CMD = 0x62;
+    constexpr uint8_t CURRENT_CMD = 0x30;
+
+    // cmd response (alternative telemetry registers accepted by the parser)
+    constexpr uint8_t VOLTAGE_ALT_CMD = 0x00;
+    constexpr uint8_t CURRENT_ALT_CMD = 0x01;
+    
+    // cmd control
+    constexpr uint8_t MODE_SET_CMD = 0x5F;
+    constexpr uint8_t VOLTAGE_SET_CMD = 0x02;
+    constexpr uint8_t CURRENT_SET_CMD = 0x03;
+    constexpr uint8_t POWER_CTRL_CMD = 0x04;
+    
+    // mode and state
+    constexpr uint8_t LOW_MODE = 0x02;
+    constexpr uint8_t HIGH_MODE = 0x01;
+    constexpr uint8_t OFF = 0x01;
+    constexpr uint8_t ON = 0x00;
+    
+    constexpr uint32_t MASK = 0x02200000;
+    constexpr uint32_t P2P_FLAG = 0x00200000;   // Point-to-point bit of MASK; group frames carry the group in the address field
+    constexpr uint8_t MAX_ADDRESS = 0x7F;
+}
+
+namespace MMeetConstants {
+    constexpr uint8_t P2P_COMMUNICATION = 0x01;
+    constexpr uint8_t GROUP_COMMUNICATION = 0x00;
+    constexpr uint8_t BROADCAST_ADDRESS = 0xFF;    // Destination of group frames
+    constexpr uint8_t GROUP_MASK = 0x07;           // Group number in the low CAN ID bits
+    constexpr uint8_t FRAME_PREFIX = 0x01;
+    constexpr uint8_t FRAME_SUFFIX = 0xF0;
+    
+    // cmd request
+    constexpr uint16_t TEMP_CMD = 0x020B;
+    constexpr uint16_t CURRENT_CAP_CMD = 0x0235;
+    constexpr uint16_t FLAGS_CMD = 0x0218;
+    constexpr uint16_t VOLTAGE_CMD = 0x0231;
+    constexpr uint16_t CURRENT_CMD = 0x0232;
+    
+    // cmd control
+    constexpr uint16_t MODE_SET_CMD = 0x005D;
+    constexpr uint16_t VOLTAGE_SET_CMD = 0x002C;
+    constexpr uint16_t CURRENT_SET_CMD = 0x002D;
+    constexpr uint16_t POWER_CTRL_CMD = 0x0001;
+    
+    // mode and state
+    constexpr uint16_t LOW_MODE = 0x1111;
+    constexpr uint16_t HIGH_MODE = 0x2222;
+    constexpr uint16_t AUTO_MODE = 0x0000;
+    constexpr uint8_t OFF = 0x55;
+    constexpr uint8_t ON = 0xAA;
+    
+    constexpr uint32_t MASK = 0x6000000;
+    constexpr uint8_t MAX_ADDRESS = 0x7F;
+}
+
+/**
+ * @brief Builds a complete CAN frame in one aggregate initialisation
+ *
+ * Usable in constant expressions; initialising every byte at once also lets
+ * the compiler emit plain stores instead of read-modify-write sequences.
+ * @param can_id CAN ID including flags
+ * @param d0..d7 Data bytes
+ * @return CAN frame with DLC = 8
+ */
+constexpr can_frame make_frame(uint32_t can_id,
+                               uint8_t d0 = 0, uint8_t d1 = 0, uint8_t d2 = 0, uint8_t d3 = 0,
+                               uint8_t d4 = 0, uint8_t d5 = 0, uint8_t d6 = 0, uint8_t d7 = 0) {
+#ifdef __APPLE__
+    return can_frame{can_id, CAN_INV_DLC, {d0, d1, d2, d3, d4, d5, d6, d7}};
+#else
+    return can_frame{can_id, {CAN_INV_DLC}, 0, 0, 0, {d0, d1, d2, d3, d4, d5, d6, d7}};
+#endif
+}
+
+/**
+ * @brief Byte of a 32-bit value
+ * @param value Source value
+ * @param shift Bit position of the byte
+ * @return Selected byte
+ */
+constexpr uint8_t byte_of(uint32_t value, unsigned shift) {
+    return static_cast<uint8_t>(value >> shift);
+}
+
+/**
+ * @brief Compile-time frame construction for each protocol
+ *
+ * Shared by the runtime generators and StaticCanProtocolManager, so both
+ * paths always produce identical frames.
+ */
+template <ProtocolType Protocol>
+struct FrameBuilder;
+
+/**
+ * @brief Frame construction for UUgreen protocol
+ */
+template <>
+struct FrameBuilder<ProtocolType::UUgreen> {
+    static constexpr uint8_t max_address = UUgreenConstants::MAX_ADDRESS;
+    using command_type = uint8_t;
+
+    /**
+     * @brief Address bits of the CAN ID for a device
+     * @param module_address Device address
+     * @return Address shifted into its CAN ID position
+     */
+    static constexpr uint32_t address_bits(uint8_t module_address) {
+        return (module_address & UUgreenConstants::MAX_ADDRESS) << 14;
+    }
+
+    /**
+     * @brief Map request kind to protocol command code
+     * @param request Kind of request
+     * @return Command code or std::nullopt for unknown request
+     */
+    static constexpr std::optional<command_type> request_command(RequestType request) {
+        switch(request) {
+            case RequestType::Temp: return UUgreenConstants::TEMP_CMD;
+            case RequestType::CurrentCapability: return UUgreenConstants::CURRENT_CAP_CMD;
+            case RequestType::Flags: return UUgreenConstants::FLAGS_CMD;
+            case RequestType::Voltage: return UUgreenConstants::VOLTAGE_CMD;
+            case RequestType::Current: return UUgreenConstants::CURRENT_CMD;
+            default: return std::nullopt;
+        }
+    }
+
+    /**
+     * @brief CAN ID for a point-to-point frame
+     * @param module_address Device address
+     * @return CAN ID including the extended frame flag
+     */
+    static constexpr uint32_t frame_id(uint8_t module_address) {
+        return UUgreenConstants::MASK | address_bits(module_address) | CAN_INV_EFF_FLAG;
+    }
+
+    /**
+     * @brief CAN ID for a frame to a group of modules
+     * @param group Group number (0-127), BROADCAST_GROUP for every module
+     * @return CAN ID including the extended frame flag
+     */
+    static constexpr uint32_t group_frame_id(uint8_t group) {
+        return (UUgreenConstants::MASK & ~UUgreenConstants::P2P_FLAG) | address_bits(group) | CAN_INV_EFF_FLAG;
+    }
+
+    /**
+     * @brief Creates command frame for standard requests
+     * @param module_address Device address (0-127) 
+     * @param prefix Frame prefix byte (typically protocol-specific)
+     * @param command Command code to execute
+     * @param value 32-bit parameter packed big-endian into data[4-7] (default = 0)
+     * @return Configured CAN frame ready for transmission
+     */
+    static constexpr can_frame create_command_frame(uint8_t module_address, uint8_t prefix,
+                                                    uint8_t command, uint32_t value = 0) {
+        return make_frame(frame_id(module_address), prefix, command, 0, 0,
+                          byte_of(value, 24), byte_of(value, 16), byte_of(value, 8), byte_of(value, 0));
+    }
+
+    /**
+     * @brief Creates control frame for device configuration
+     * @param module_address Device address (0-127)
+     * @param command Control command code
+     * @param value Parameter value for the command, placed in data[7] (default = 0)
+     * @return Configured control CAN frame
+     */
+    static constexpr can_frame create_control_frame(uint8_t module_address, uint8_t command, uint32_t value = 0) {
+        return create_command_frame(module_address, UUgreenConstants::CONTROL_PREFIX, command, value);
+    }
+
+    /**
+     * @brief Creates request frame of the given kind
+     * @param module_address Device address (0-127)
+     * @param command Request command code
+     * @return Configured request CAN frame
+     */
+    static constexpr can_frame create_request_frame(uint8_t module_address, command_type command) {
+        return create_command_frame(module_address, UUgreenConstants::PREAMBLE, command);
+    }
+
+    // Frame generators, see ICanFrameGenerator for semantics
+
+    static constexpr can_frame generateTempRequest(uint8_t module_address) {
+        return create_request_frame(module_address, UUgreenConstants::TEMP_CMD);
+    }
+
+    static constexpr can_frame generateCurrentCapabilityRequest(uint8_t module_address) {
+        return create_request_frame(module_address, UUgreenConstants::CURRENT_CAP_CMD);
+    }
+
+    static constexpr can_frame generateFlagsRequest(uint8_t module_address) {
+        return create_request_frame(module_address, UUgreenConstants::FLAGS_CMD);
+    }
+
+    static constexpr can_frame generateVoltageRequest(uint8_t module_address) {
+        return create_request_frame(module_address, UUgreenConstants::VOLTAGE_CMD);
+    }
+
+    static constexpr can_frame generateCurrentRequest(uint8_t module_address) {
+        return create_request_frame(module_address, UUgreenConstants::CURRENT_CMD);
+    }
+
+    static constexpr can_frame generateLowModeSet(uint8_t module_address) {
+        return create_control_frame(module_address, UUgreenConstants::MODE_SET_CMD, UUgreenConstants::LOW_MODE);
+    }
+
+    static constexpr can_frame generateHighModeSet(uint8_t module_address) {
+        return create_control_frame(module_address, UUgreenConstants::MODE_SET_CMD, UUgreenConstants::HIGH_MODE);
+    }
+
+    static constexpr std::optional<can_frame> generateAutoModeSet(uint8_t module_address) {
+        (void)module_address;
+        return std::nullopt;
+    }
+
+    static constexpr can_frame generateVoltageSet(uint8_t module_address, Millivolts voltage) {
+        return create_control_frame(module_address, UUgreenConstants::VOLTAGE_SET_CMD, voltage.value);
+    }
+
+    static constexpr can_frame generateVoltageSet(uint8_t module_address, float voltage) {
+        return generateVoltageSet(module_address, Millivolts::fromVolts(voltage));
+    }
+
+    static constexpr can_frame generateCurrentSet(uint8_t module_address, Milliamps current) {
+        return create_control_frame(module_address, UUgreenConstants::CURRENT_SET_CMD, current.value);
+    }
+
+    static constexpr can_frame generateCurrentSet(uint8_t module_address, float current) {
+        return generateCurrentSet(module_address, Milliamps::fromAmps(current));
+    }
+
+    static constexpr can_frame generateEnable(uint8_t module_address) {
+        return create_control_frame(module_address, UUgreenConstants::POWER_CTRL_CMD, UUgreenConstants::ON);
+    }
+
+    static constexpr can_frame generateDisable(uint8_t module_address) {
+        return create_control_frame(module_address, UUgreenConstants::POWER_CTRL_CMD, UUgreenConstants::OFF);
+    }
+};
+
+/**
+ * @brief Frame construction for MMeet protocol
+ */
+template <>
+struct FrameBuilder<ProtocolType::MMeet> {
+    static constexpr uint8_t max_address = MMeetConstants::MAX_ADDRESS;
+    using command_type = uint16_t;
+
+    /**
+     * @brief Address bits of the CAN ID for a device
+     * @param module_address Device address
+     * @return Address shifted into its CAN ID position
+     */
+    static constexpr uint32_t address_bits(uint8_t module_address) {
+        return (module_address & MMeetConstants::MAX_ADDRESS) << 11;
+    }
+
+    /**
+     * @brief Map request kind to protocol command code
+     * @param request Kind of request
+     * @return Command code or std::nullopt for unknown request
+     */
+    static constexpr std::optional<command_type> request_command(RequestType request) {
+        switch(request) {
+            case RequestType::Temp: return MMeetConstants::TEMP_CMD;
+            case RequestType::CurrentCapability: return MMeetConstants::CURRENT_CAP_CMD;
+            case RequestType::Flags: return MMeetConstants::FLAGS_CMD;
+            case RequestType::Voltage: return MMeetConstants::VOLTAGE_CMD;
+            case RequestType::Current: return MMeetConstants::CURRENT_CMD;
+            default: return std::nullopt;
+        }
+    }
+
+    /**
+     * @brief CAN ID for a point-to-point frame
+     * @param module_address Device address
+     * @return CAN ID including the extended frame flag
+     */
+    static constexpr uint32_t frame_id(uint8_t module_address) {
+        return (MMeetConstants::MASK | MMeetConstants::P2P_COMMUNICATION << 19 | 
+                address_bits(module_address) | 0xF0 << 3 | 0x03) | CAN_INV_EFF_FLAG;
+    }
+
+    /**
+     * @brief CAN ID for a frame to a group of modules
+     * @param group Group number (0-7), BROADCAST_GROUP for every module
+     * @return CAN ID including the extended frame flag
+     */
+    static constexpr uint32_t group_frame_id(uint8_t group) {
+        return (MMeetConstants::MASK | MMeetConstants::GROUP_COMMUNICATION << 19 |
+                uint32_t(MMeetConstants::BROADCAST_ADDRESS) << 11 | 0xF0 << 3 |
+                (group & MMeetConstants::GROUP_MASK)) | CAN_INV_EFF_FLAG;
+    }
+
+    /**
+     * @brief Creates a standard MMeet protocol command frame
+     * @param module_address Device address (0x00-0x7F)
+     * @param command 16-bit MMeet command code (e.g. 0x020B for temperature)
+     * @param value 32-bit parameter value (default = 0)
+     * @return Configured CAN frame with:
+     *         - CAN ID containing module address
+     *         - First 4 data bytes set to [0x01, 0xF0, command_high, command_low]
+     *         - Value packed in data[4-7] (big-endian)
+     */
+    static constexpr can_frame create_command_frame(uint8_t module_address, uint16_t command, uint32_t value = 0) {
+        return make_frame(frame_id(module_address),
+                          MMeetConstants::FRAME_PREFIX, MMeetConstants::FRAME_SUFFIX,
+                          byte_of(command, 8), byte_of(command, 0),
+                          byte_of(value, 24), byte_of(value, 16), byte_of(value, 8), byte_of(value, 0));
+    }
+
+    /**
+     * @brief Creates a control frame for device configuration
+     * @param module_address Device address (0x00-0x7F)
+     * @param command 16-bit control command code (e.g. 0x025D for mode set)
+     * @param value 16-bit parameter value (default = 0x0000)
+     * @return Configured CAN frame with:
+     *         - Standard MMeet header
+     *         - Command bytes in data[2-3]
+     *         - Value packed in data[6-7] (big-endian)
+     */
+    static constexpr can_frame create_control_frame(uint8_t module_address, uint16_t command, uint16_t value = 0) {
+        return create_command_frame(module_address, command, value);
+    }
+
+    /**
+     * @brief Creates request frame of the given kind
+     * @param module_address Device address (0x00-0x7F)
+     * @param command Request command code
+     * @return Configured request CAN frame
+     */
+    static constexpr can_frame create_request_frame(uint8_t module_address, command_type command) {
+        return create_command_frame(module_address, command);
+    }
+
+    // Frame generators, see ICanFrameGenerator for semantics
+
+    static constexpr can_frame generateTempRequest(uint8_t module_address) {
+        return create_request_frame(module_address, MMeetConstants::TEMP_CMD);
+    }
+
+    static constexpr can_frame generateCurrentCapabilityRequest(uint8_t module_address) {
+        return create_request_frame(module_address, MMeetConstants::CURRENT_CAP_CMD);
+    }
+
+    static constexpr can_frame generateFlagsRequest(uint8_t module_address) {
+        return create_request_frame(module_address, MMeetConstants::FLAGS_CMD);
+    }
+
+    static constexpr can_frame generateVoltageRequest(uint8_t module_address) {
+        return create_request_frame(module_address, MMeetConstants::VOLTAGE_CMD);
+    }
+
+    static constexpr can_frame generateCurrentRequest(uint8_t module_address) {
+        return create_request_frame(module_address, MMeetConstants::CURRENT_CMD);
+    }
+
+    static constexpr can_frame generateLowModeSet(uint8_t module_address) {
+        return create_control_frame(module_address, MMeetConstants::MODE_SET_CMD, MMeetConstants::LOW_MODE);
+    }
+
+    static constexpr can_frame generateHighModeSet(uint8_t module_address) {
+        return create_control_frame(module_address, MMeetConstants::MODE_SET_CMD, MMeetConstants::HIGH_MODE);
+    }
+
+    static constexpr std::optional<can_frame> generateAutoModeSet(uint8_t module_address) {
+        return create_control_frame(module_address, MMeetConstants::MODE_SET_CMD, MMeetConstants::AUTO_MODE);
+    }
+
+    static constexpr can_frame generateVoltageSet(uint8_t module_address, Millivolts voltage) {
+        return create_command_frame(module_address, MMeetConstants::VOLTAGE_SET_CMD, voltage.value);
+    }
+
+    static constexpr can_frame generateVoltageSet(uint8_t module_address, float voltage) {
+        return generateVoltageSet(module_address, Millivolts::fromVolts(voltage));
+    }
+
+    static constexpr can_frame generateCurrentSet(uint8_t module_address, Milliamps current) {
+        return create_command_frame(module_address, MMeetConstants::CURRENT_SET_CMD, current.value);
+    }
+
+    static constexpr can_frame generateCurrentSet(uint8_t module_address, float current) {
+        return generateCurrentSet(module_address, Milliamps::fromAmps(current));
+    }
+
+    static constexpr can_frame generateEnable(uint8_t module_address) {
+        return create_command_frame(module_address, MMeetConstants::POWER_CTRL_CMD, MMeetConstants::ON);
+    }
+
+    static constexpr can_frame generateDisable(uint8_t module_address) {
+        return create_command_frame(module_address, MMeetConstants::POWER_CTRL_CMD, MMeetConstants::OFF);
+    }
+};
+
+/**
+ * @brief Group and broadcast variants of the control frames
+ *
+ * Same payload as the point-to-point frame, addressed with
+ * FrameBuilder<Protocol>::group_frame_id, so one frame reconfigures every
+ * module of a group instead of one frame per address.
+ */
+template <ProtocolType Protocol>
+struct GroupFrameBuilder {
+    using Builder = FrameBuilder<Protocol>;
+
+    /**
+     * @brief Readdressing a point-to-point frame to a group
+     * @param frame Frame built for any module address
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Frame with the group CAN ID
+     */
+    static constexpr can_frame to_group(can_frame frame, uint8_t group) {
+        frame.can_id = Builder::group_frame_id(group);
+        return frame;
+    }
+
+    // Frame generators, see ICanFrameGenerator for semantics
+
+    static constexpr can_frame generateGroupLowModeSet(uint8_t group) {
+        return to_group(Builder::generateLowModeSet(0), group);
+    }
+
+    static constexpr can_frame generateGroupHighModeSet(uint8_t group) {
+        return to_group(Builder::generateHighModeSet(0), group);
+    }
+
+    static constexpr std::optional<can_frame> generateGroupAutoModeSet(uint8_t group) {
+        const std::optional<can_frame> frame = Builder::generateAutoModeSet(0);
+        if (!frame) return std::nullopt;
+        return to_group(*frame, group);
+    }
+
+    static constexpr can_frame generateGroupVoltageSet(uint8_t group, Millivolts voltage) {
+        return to_group(Builder::generateVoltageSet(0, voltage), group);
+    }
+
+    static constexpr can_frame generateGroupVoltageSet(uint8_t group, float voltage) {
+        return to_group(Builder::generateVoltageSet(0, voltage), group);
+    }
+
+    static constexpr can_frame generateGroupCurrentSet(uint8_t group, Milliamps current) {
+        return to_group(Builder::generateCurrentSet(0, current), group);
+    }
+
+    static constexpr can_frame generateGroupCurrentSet(uint8_t group, float current) {
+        return to_group(Builder::generateCurrentSet(0, current), group);
+    }
+
+    static constexpr can_frame generateGroupEnable(uint8_t group) {
+        return to_group(Builder::generateEnable(0), group);
+    }
+
+    static constexpr can_frame generateGroupDisable(uint8_t group) {
+        return to_group(Builder::generateDisable(0), group);
+    }
+};
+
+/**
+ * @brief Ready-made request frames indexed by [RequestType][module address]
+ */
+using RequestFrameTable = std::array<std::array<can_frame, MODULE_ADDRESS_COUNT>, REQUEST_TYPE_COUNT>;
+
+/**
+ * @brief Build request frame table for a protocol at compile time
+ * @return Table of every request frame for every address
+ */
+template <ProtocolType Protocol>
+constexpr RequestFrameTable make_request_frame_table() {
+    using Builder = FrameBuilder<Protocol>;
+    RequestFrameTable table{};
+    for (size_t request = 0; request < REQUEST_TYPE_COUNT; ++request) {
+        const auto command = *Builder::request_command(static_cast<RequestType>(request));
+        for (size_t address = 0; address < MODULE_ADDRESS_COUNT; ++address) {
+            table[request][address] = Builder::create_request_frame(static_cast<uint8_t>(address), command);
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Compile-time request frames for a protocol
+ *
+ * Rows are contiguous per request kind, so a block of addresses can be
+ * copied straight into a send buffer.
+ */
+template <ProtocolType Protocol>
+inline constexpr RequestFrameTable REQUEST_FRAME_TABLE = make_request_frame_table<Protocol>();
+
+/**
+ * @brief Row of the request frame table for runtime-selected protocol
+ * @param protocol Protocol type
+ * @param request Kind of request
+ * @return Pointer to MODULE_ADDRESS_COUNT frames indexed by address, nullptr if unknown
+ */
+inline const can_frame* request_frames(ProtocolType protocol, RequestType request) {
+    const auto row = static_cast<size_t>(request);
+    if (row >= REQUEST_TYPE_COUNT) return nullptr;
+    switch(protocol) {
+        case ProtocolType::UUgreen: return REQUEST_FRAME_TABLE<ProtocolType::UUgreen>[row].data();
+        case ProtocolType::MMeet: return REQUEST_FRAME_TABLE<ProtocolType::MMeet>[row].data();
+        default: return nullptr;
+    }
+}
+
+/**
+ * @brief Generate request frames of one kind for a list of modules
+ * @param request Kind of request to generate
+ * @param module_addresses Device addresses
+ * @param count Number of addresses in module_addresses
+ * @param frames Caller-owned buffer with room for count frames
+ * @return Number of frames written (0 for unknown request)
+ */
+template <ProtocolType Protocol>
+size_t build_request_batch(RequestType request, const uint8_t* module_addresses,
+                           size_t count, can_frame* frames) {
+    using Builder = FrameBuilder<Protocol>;
+    const auto command = Builder::request_command(request);
+    if (!command) return 0;
+
+    // Build the frame once, then only patch the address bits per module
+    const can_frame prototype = Builder::create_request_frame(0, *command);
+    for (size_t i = 0; i < count; ++i) {
+        frames[i] = prototype;
+        frames[i].can_id |= Builder::address_bits(module_addresses[i]);
+    }
+    return count;
+}
+
+/**
+ * @brief Generate request frames of one kind for consecutive module addresses
+ * @param request Kind of request to generate
+ * @param first_address First device address
+ * @param count Number of consecutive addresses (clamped to the address space)
+ * @param frames Caller-owned buffer with room for count frames
+ * @return Number of frames written (0 for unknown request)
+ */
+template <ProtocolType Protocol>
+size_t build_request_range(RequestType request, uint8_t first_address,
+                           size_t count, can_frame* frames) {
+    const auto row = static_cast<size_t>(request);
+    if (row >= REQUEST_TYPE_COUNT || first_address >= MODULE_ADDRESS_COUNT) return 0;
+
+    const size_t available = MODULE_ADDRESS_COUNT - first_address;
+    if (count > available) count = available;
+
+    std::memcpy(frames, &REQUEST_FRAME_TABLE<Protocol>[row][first_address], count * sizeof(can_frame));
+    return count;
+}
+
 /**
  * @brief Abstract strategy for CAN frame generation
  */
@@ -104,19 +711,35 @@ public:
     /**
      * @brief Generate CAN frame for voltage setting
      * @param module_address Device address
-     * @param voltage Voltage value (in V units)
+     * @param voltage Voltage value (in V units), rounded to the nearest mV
      * @return Generated CAN frame
      */
     virtual can_frame generateVoltageSet(uint8_t module_address, float voltage) = 0;
+
+    /**
+     * @brief Generate CAN frame for voltage setting, integer path
+     * @param module_address Device address (7 bits)
+     * @param voltage Voltage value (in mV units), encoded as is
+     * @return Generated CAN frame
+     */
+    virtual can_frame generateVoltageSet(uint8_t module_address, Millivolts voltage) = 0;
     
     /**
      * @brief Generate CAN frame for current setting
      * @param module_address Device address
-     * @param current Current value (in A units)
+     * @param current Current value (in A units), rounded to the nearest mA
      * @return Generated CAN frame
      */
     virtual can_frame generateCurrentSet(uint8_t module_address, float current) = 0;
 
+    /**
+     * @brief Generate CAN frame for current setting, integer path
+     * @param module_address Device address (7 bits)
+     * @param current Current value (in mA units), encoded as is
+     * @return Generated CAN frame
+     */
+    virtual can_frame generateCurrentSet(uint8_t module_address, Milliamps current) = 0;
+
     /**
      * @brief Generate CAN frame for power ON
      * @param module_address Device address
@@ -129,15 +752,303 @@ public:
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    virtual can_frame generateDisable(uint8_t module_address) = 0;
-};
+    virtual can_frame generateDisable(uint8_t module_address) = 0;
+
+    /**
+     * @brief Generate CAN frame setting low mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    virtual can_frame generateGroupLowModeSet(uint8_t group) = 0;
+
+    /**
+     * @brief Generate CAN frame setting high mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    virtual can_frame generateGroupHighModeSet(uint8_t group) = 0;
+
+    /**
+     * @brief Generate CAN frame setting auto mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame or std::nullopt if not supported
+     */
+    virtual std::optional<can_frame> generateGroupAutoModeSet(uint8_t group) = 0;
+
+    /**
+     * @brief Generate CAN frame setting the voltage of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param voltage Voltage value (in V units)
+     * @return Generated CAN frame
+     */
+    virtual can_frame generateGroupVoltageSet(uint8_t group, float voltage) = 0;
+
+    /**
+     * @brief Generate CAN frame setting the voltage of a group of modules, integer path
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param voltage Voltage value (in mV units)
+     * @return Generated CAN frame
+     */
+    virtual can_frame generateGroupVoltageSet(uint8_t group, Millivolts voltage) = 0;
+
+    /**
+     * @brief Generate CAN frame setting the current of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param current Current value (in A units)
+     * @return Generated CAN frame
+     */
+    virtual can_frame generateGroupCurrentSet(uint8_t group, float current) = 0;
+
+    /**
+     * @brief Generate CAN frame setting the current of a group of modules, integer path
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param current Current value (in mA units)
+     * @return Generated CAN frame
+     */
+    virtual can_frame generateGroupCurrentSet(uint8_t group, Milliamps current) = 0;
+
+    /**
+     * @brief Generate CAN frame for power ON of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    virtual can_frame generateGroupEnable(uint8_t group) = 0;
+
+    /**
+     * @brief Generate CAN frame for power OFF of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    virtual can_frame generateGroupDisable(uint8_t group) = 0;
+
+    /**
+     * @brief Generate request frames of one kind for a list of modules
+     * @param request Kind of request to generate
+     * @param module_addresses Device addresses
+     * @param count Number of addresses in module_addresses
+     * @param frames Caller-owned buffer with room for count frames
+     * @return Number of frames written (0 for unknown request)
+     */
+    virtual size_t generateRequestBatch(RequestType request, const uint8_t* module_addresses,
+                                        size_t count, can_frame* frames) = 0;
+
+    /**
+     * @brief Generate request frames of one kind for consecutive module addresses
+     * @param request Kind of request to generate
+     * @param first_address First device address
+     * @param count Number of consecutive addresses (clamped to the address space)
+     * @param frames Caller-owned buffer with room for count frames
+     * @return Number of frames written (0 for unknown request)
+     */
+    virtual size_t generateRequestRange(RequestType request, uint8_t first_address,
+                                        size_t count, can_frame* frames) = 0;
+};
+
+
+
+/**
+ * @brief CAN Frame Generator for UUgreen protocol
+ */
+class UUgreenFrameGenerator final : public ICanFrameGenerator {
+public:
+
+    /**
+     * @brief Generate CAN frame for temperature reading request
+     * @param module_address Device address
+     * @return Generated CAN frame
+     */
+    can_frame generateTempRequest(uint8_t module_address) override;
+
+    /**
+     * @brief Generate CAN frame for Current capability reading request
+     * @param module_address Device address
+     * @return Generated CAN frame
+     */
+    can_frame generateCurrentCapabilityRequest(uint8_t module_address) override;
+
+    /**
+     * @brief Generate CAN frame for Flags reading request
+     * @param module_address Device address
+     * @return Generated CAN frame
+     */
+    can_frame generateFlagsRequest(uint8_t module_address) override;
+
+    /**
+     * @brief Generate CAN frame for voltage reading request
+     * @param module_address Device address
+     * @return Generated CAN frame
+     */
+    can_frame generateVoltageRequest(uint8_t module_address) override;
+    
+    /**
+     * @brief Generate CAN frame for current reading request
+     * @param module_address Device address
+     * @return Generated CAN frame
+     */
+    can_frame generateCurrentRequest(uint8_t module_address) override;
+    
+    /**
+     * @brief Generate CAN frame for set low mode request
+     * @param module_address Device address
+     * @return Generated CAN frame
+     */
+    can_frame generateLowModeSet(uint8_t module_address) override;
+
+    /**
+     * @brief Generate CAN frame for set high mode request
+     * @param module_address Device address
+     * @return Generated CAN frame
+     */
+    can_frame generateHighModeSet(uint8_t module_address) override; 
+
+    /**
+     * @brief Not supported
+     * @param module_address Device address
+     * @return std::nullopt
+     */
+    std::optional<can_frame> generateAutoModeSet(uint8_t module_address) override;
+
+    /**
+     * @brief Generate CAN frame for voltage setting
+     * @param module_address Device address
+     * @param voltage Voltage value (in V units)
+     * @return Generated CAN frame
+     */
+    can_frame generateVoltageSet(uint8_t module_address, float voltage) override;
+
+    /**
+     * @brief Generate CAN frame for voltage setting
+     * @param module_address Device address
+     * @param voltage Voltage value (in mV units)
+     * @return Generated CAN frame
+     */
+    can_frame generateVoltageSet(uint8_t module_address, Millivolts voltage) override;
+    
+    /**
+     * @brief Generate CAN frame for current setting
+     * @param module_address Device address
+     * @param current Current value (in A units)
+     * @return Generated CAN frame
+     */
+    can_frame generateCurrentSet(uint8_t module_address, float current) override;
+
+    /**
+     * @brief Generate CAN frame for current setting
+     * @param module_address Device address
+     * @param current Current value (in mA units)
+     * @return Generated CAN frame
+     */
+    can_frame generateCurrentSet(uint8_t module_address, Milliamps current) override;
+
+    /**
+     * @brief Generate CAN frame for power ON
+     * @param module_address Device address
+     * @return Generated CAN frame
+     */
+    can_frame generateEnable(uint8_t module_address) override;
+
+    /**
+     * @brief Generate CAN frame for power OFF
+     * @param module_address Device address
+     * @return Generated CAN frame
+     */
+    can_frame generateDisable(uint8_t module_address) override;
+
+    /**
+     * @brief Generate CAN frame setting low mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupLowModeSet(uint8_t group) override;
+
+    /**
+     * @brief Generate CAN frame setting high mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupHighModeSet(uint8_t group) override;
+
+    /**
+     * @brief Not supported
+     * @param group Group number
+     * @return std::nullopt
+     */
+    std::optional<can_frame> generateGroupAutoModeSet(uint8_t group) override;
+
+    /**
+     * @brief Generate CAN frame setting the voltage of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param voltage Voltage value (in V units)
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupVoltageSet(uint8_t group, float voltage) override;
+
+    /**
+     * @brief Generate CAN frame setting the voltage of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param voltage Voltage value (in mV units)
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupVoltageSet(uint8_t group, Millivolts voltage) override;
+
+    /**
+     * @brief Generate CAN frame setting the current of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param current Current value (in A units)
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupCurrentSet(uint8_t group, float current) override;
+
+    /**
+     * @brief Generate CAN frame setting the current of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param current Current value (in mA units)
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupCurrentSet(uint8_t group, Milliamps current) override;
+
+    /**
+     * @brief Generate CAN frame for power ON of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupEnable(uint8_t group) override;
+
+    /**
+     * @brief Generate CAN frame for power OFF of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupDisable(uint8_t group) override;
+
+    /**
+     * @brief Generate request frames of one kind for a list of modules
+     * @param request Kind of request to generate
+     * @param module_addresses Device addresses
+     * @param count Number of addresses in module_addresses
+     * @param frames Caller-owned buffer with room for count frames
+     * @return Number of frames written (0 for unknown request)
+     */
+    size_t generateRequestBatch(RequestType request, const uint8_t* module_addresses,
+                                size_t count, can_frame* frames) override;
 
+    /**
+     * @brief Generate request frames of one kind for consecutive module addresses
+     * @param request Kind of request to generate
+     * @param first_address First device address
+     * @param count Number of consecutive addresses (clamped to the address space)
+     * @param frames Caller-owned buffer with room for count frames
+     * @return Number of frames written (0 for unknown request)
+     */
+    size_t generateRequestRange(RequestType request, uint8_t first_address,
+                                size_t count, can_frame* frames) override;
 
+};
 
 /**
- * @brief CAN Frame Generator for UUgreen protocol
+ * @brief CAN Frame Generator for MMeet protocol
  */
-class UUgreenFrameGenerator : public ICanFrameGenerator {
+class MMeetFrameGenerator final : public ICanFrameGenerator {
 public:
 
     /**
@@ -190,9 +1101,9 @@ public:
     can_frame generateHighModeSet(uint8_t module_address) override; 
 
     /**
-     * @brief Not supported
+     * @brief Generate CAN frame for set auto mode request
      * @param module_address Device address
-     * @return std::nullopt
+     * @return Generated CAN frame
      */
     std::optional<can_frame> generateAutoModeSet(uint8_t module_address) override;
 
@@ -203,6 +1114,14 @@ public:
      * @return Generated CAN frame
      */
     can_frame generateVoltageSet(uint8_t module_address, float voltage) override;
+
+    /**
+     * @brief Generate CAN frame for voltage setting
+     * @param module_address Device address
+     * @param voltage Voltage value (in mV units)
+     * @return Generated CAN frame
+     */
+    can_frame generateVoltageSet(uint8_t module_address, Millivolts voltage) override;
     
     /**
      * @brief Generate CAN frame for current setting
@@ -212,6 +1131,14 @@ public:
      */
     can_frame generateCurrentSet(uint8_t module_address, float current) override;
 
+    /**
+     * @brief Generate CAN frame for current setting
+     * @param module_address Device address
+     * @param current Current value (in mA units)
+     * @return Generated CAN frame
+     */
+    can_frame generateCurrentSet(uint8_t module_address, Milliamps current) override;
+
     /**
      * @brief Generate CAN frame for power ON
      * @param module_address Device address
@@ -226,103 +1153,205 @@ public:
      */
     can_frame generateDisable(uint8_t module_address) override;
 
-private:
     /**
-     * @brief Init CAN frame for create request
-     * @param module_address Device address
+     * @brief Generate CAN frame setting low mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
      * @return Generated CAN frame
      */
-    can_frame init_frame (uint8_t module_address); 
-    
+    can_frame generateGroupLowModeSet(uint8_t group) override;
 
     /**
-     * @brief Creates command frame for standard requests
-     * @param module_address Device address (0-127) 
-     * @param prefix Frame prefix byte (typically protocol-specific)
-     * @param command Command code to execute
-     * @return Configured CAN frame ready for transmission
+     * @brief Generate CAN frame setting high mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
      */
-    can_frame create_command_frame(uint8_t module_address, uint8_t prefix, uint8_t command);
+    can_frame generateGroupHighModeSet(uint8_t group) override;
 
     /**
-     * @brief Creates control frame for device configuration
-     * @param module_address Device address (0-127)
-     * @param command Control command code
-     * @param value Parameter value for the command (default = 0)
-     * @return Configured control CAN frame
+     * @brief Generate CAN frame setting auto mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame or std::nullopt if not supported
+     */
+    std::optional<can_frame> generateGroupAutoModeSet(uint8_t group) override;
+
+    /**
+     * @brief Generate CAN frame setting the voltage of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param voltage Voltage value (in V units)
+     * @return Generated CAN frame
      */
-    can_frame create_control_frame(uint8_t module_address, uint8_t command, uint8_t value = 0);
+    can_frame generateGroupVoltageSet(uint8_t group, float voltage) override;
 
     /**
-     * @brief Packs 32-bit value into 4-byte array (big-endian)
-     * @param dest Pointer to destination buffer (must have 4+ bytes available)
-     * @param value 32-bit value to pack
+     * @brief Generate CAN frame setting the voltage of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param voltage Voltage value (in mV units)
+     * @return Generated CAN frame
      */
-    void pack_uint32(uint8_t* dest, uint32_t value);
-    
+    can_frame generateGroupVoltageSet(uint8_t group, Millivolts voltage) override;
+
+    /**
+     * @brief Generate CAN frame setting the current of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param current Current value (in A units)
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupCurrentSet(uint8_t group, float current) override;
+
+    /**
+     * @brief Generate CAN frame setting the current of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param current Current value (in mA units)
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupCurrentSet(uint8_t group, Milliamps current) override;
+
+    /**
+     * @brief Generate CAN frame for power ON of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupEnable(uint8_t group) override;
+
+    /**
+     * @brief Generate CAN frame for power OFF of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupDisable(uint8_t group) override;
+
+    /**
+     * @brief Generate request frames of one kind for a list of modules
+     * @param request Kind of request to generate
+     * @param module_addresses Device addresses
+     * @param count Number of addresses in module_addresses
+     * @param frames Caller-owned buffer with room for count frames
+     * @return Number of frames written (0 for unknown request)
+     */
+    size_t generateRequestBatch(RequestType request, const uint8_t* module_addresses,
+                                size_t count, can_frame* frames) override;
+
+    /**
+     * @brief Generate request frames of one kind for consecutive module addresses
+     * @param request Kind of request to generate
+     * @param first_address First device address
+     * @param count Number of consecutive addresses (clamped to the address space)
+     * @param frames Caller-owned buffer with room for count frames
+     * @return Number of frames written (0 for unknown request)
+     */
+    size_t generateRequestRange(RequestType request, uint8_t first_address,
+                                size_t count, can_frame* frames) override;
+
 };
 
 /**
- * @brief CAN Frame Generator for MMeet protocol
+ * @brief CAN Protocol Manager (Context)
  */
-class MMeetFrameGenerator : public ICanFrameGenerator {
+class CanProtocolManager {
 public:
+    /**
+     * @brief Constructor with protocol selection
+     * @param protocol Type of protocol to use
+     */
+    explicit CanProtocolManager(ProtocolType protocol) {
+        switch(protocol) {
+            case ProtocolType::UUgreen:
+                _generator = std::make_unique<UUgreenFrameGenerator>();
+                break;
+            case ProtocolType::MMeet:
+                _generator = std::make_unique<MMeetFrameGenerator>();
+                break;
+            // Add other protocols...
+        }
+    }
+    
+    /**
+     * @brief Set protocol at runtime
+     * @param protocol New protocol type
+     */
+    void setProtocol(ProtocolType protocol) {
+        switch(protocol) {
+            case ProtocolType::UUgreen:
+                _generator = std::make_unique<UUgreenFrameGenerator>();
+                break;
+            case ProtocolType::MMeet:
+                _generator = std::make_unique<MMeetFrameGenerator>();
+                break;
+            // Add other protocols...
+        }
+    }
 
     /**
      * @brief Generate CAN frame for temperature reading request
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateTempRequest(uint8_t module_address) override;
+    can_frame generateTempRequest(uint8_t module_address) {
+        return _generator->generateTempRequest(module_address);
+    }
 
     /**
      * @brief Generate CAN frame for Current capability reading request
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateCurrentCapabilityRequest(uint8_t module_address) override;
+    can_frame generateCurrentCapabilityRequest(uint8_t module_address) {
+        return _generator->generateCurrentCapabilityRequest(module_address);
+    }
 
     /**
      * @brief Generate CAN frame for Flags reading request
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateFlagsRequest(uint8_t module_address) override;
+    can_frame generateFlagsRequest(uint8_t module_address) {
+        return _generator->generateFlagsRequest(module_address);
+    }
 
     /**
      * @brief Generate CAN frame for voltage reading request
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateVoltageRequest(uint8_t module_address) override;
+    can_frame generateVoltageRequest(uint8_t module_address) {
+        return _generator->generateVoltageRequest(module_address);
+    } 
     
     /**
      * @brief Generate CAN frame for current reading request
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateCurrentRequest(uint8_t module_address) override;
+    can_frame generateCurrentRequest(uint8_t module_address) {
+        return _generator->generateCurrentRequest(module_address);
+    } 
     
     /**
      * @brief Generate CAN frame for set low mode request
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateLowModeSet(uint8_t module_address) override;
+    can_frame generateLowModeSet(uint8_t module_address) {
+        return _generator->generateLowModeSet(module_address);
+    } 
 
     /**
      * @brief Generate CAN frame for set high mode request
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateHighModeSet(uint8_t module_address) override; 
+    can_frame generateHighModeSet(uint8_t module_address) {
+        return _generator->generateHighModeSet(module_address);
+    } 
 
     /**
      * @brief Generate CAN frame for set auto mode request
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    std::optional<can_frame> generateAutoModeSet(uint8_t module_address) override;
+    std::optional<can_frame> generateAutoModeSet(uint8_t module_address) {
+        return _generator->generateAutoModeSet(module_address);
+    }
 
     /**
      * @brief Generate CAN frame for voltage setting
@@ -330,7 +1359,19 @@ public:
      * @param voltage Voltage value (in V units)
      * @return Generated CAN frame
      */
-    can_frame generateVoltageSet(uint8_t module_address, float voltage) override;
+    can_frame generateVoltageSet(uint8_t module_address, float voltage) {
+        return _generator->generateVoltageSet(module_address , voltage);
+    }
+
+    /**
+     * @brief Generate CAN frame for voltage setting
+     * @param module_address Device address
+     * @param voltage Voltage value (in mV units)
+     * @return Generated CAN frame
+     */
+    can_frame generateVoltageSet(uint8_t module_address, Millivolts voltage) {
+        return _generator->generateVoltageSet(module_address, voltage);
+    }
     
     /**
      * @brief Generate CAN frame for current setting
@@ -338,109 +1379,179 @@ public:
      * @param current Current value (in A units)
      * @return Generated CAN frame
      */
-    can_frame generateCurrentSet(uint8_t module_address, float current) override;
+    can_frame generateCurrentSet(uint8_t module_address, float current) {
+        return _generator->generateCurrentSet(module_address , current);
+    }
+
+    /**
+     * @brief Generate CAN frame for current setting
+     * @param module_address Device address
+     * @param current Current value (in mA units)
+     * @return Generated CAN frame
+     */
+    can_frame generateCurrentSet(uint8_t module_address, Milliamps current) {
+        return _generator->generateCurrentSet(module_address, current);
+    }
 
     /**
      * @brief Generate CAN frame for power ON
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateEnable(uint8_t module_address) override;
+    can_frame generateEnable(uint8_t module_address) {
+        return _generator->generateEnable(module_address);
+    }
 
     /**
      * @brief Generate CAN frame for power OFF
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateDisable(uint8_t module_address) override;
+    can_frame generateDisable(uint8_t module_address) {
+        return _generator->generateDisable(module_address);
+    }
 
-private:
     /**
-     * @brief Init CAN frame for create request
-     * @param module_address Device address
+     * @brief Generate CAN frame setting low mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
      * @return Generated CAN frame
      */
-    can_frame init_frame (uint8_t module_address); 
-    
+    can_frame generateGroupLowModeSet(uint8_t group) {
+        return _generator->generateGroupLowModeSet(group);
+    }
+
     /**
-     * @brief Creates a standard MMeet protocol command frame
-     * @param module_address Device address (0x00-0x7F)
-     * @param command 16-bit MMeet command code (e.g. 0x020B for temperature)
-     * @return Configured CAN frame with:
-     *         - CAN ID containing module address
-     *         - First 4 data bytes set to [0x01, 0xF0, command_high, command_low]
+     * @brief Generate CAN frame setting high mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
      */
-    can_frame create_command_frame(uint8_t module_address, uint16_t command);
+    can_frame generateGroupHighModeSet(uint8_t group) {
+        return _generator->generateGroupHighModeSet(group);
+    }
 
     /**
-     * @brief Creates a control frame for device configuration
-     * @param module_address Device address (0x00-0x7F)
-     * @param command 16-bit control command code (e.g. 0x025D for mode set)
-     * @param value 16-bit parameter value (default = 0x0000)
-     * @return Configured CAN frame with:
-     *         - Standard MMeet header
-     *         - Command bytes in data[2-3]
-     *         - Value packed in data[6-7] (little-endian)
+     * @brief Generate CAN frame setting auto mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame or std::nullopt if not supported
      */
-    can_frame create_control_frame(uint8_t module_address, uint16_t command, uint16_t value = 0);
+    std::optional<can_frame> generateGroupAutoModeSet(uint8_t group) {
+        return _generator->generateGroupAutoModeSet(group);
+    }
 
     /**
-     * @brief Packs a 32-bit value into 4-byte array (big-endian format)
-     * @param dest Pointer to destination buffer (must have at least 4 bytes capacity)
-     * @param value 32-bit value to pack
-     * @note Resulting byte order:
-     *       dest[0] = (value >> 24) & 0xFF
-     *       dest[1] = (value >> 16) & 0xFF
-     *       dest[2] = (value >> 8) & 0xFF
-     *       dest[3] = value & 0xFF
+     * @brief Generate CAN frame setting the voltage of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param voltage Voltage value (in V units)
+     * @return Generated CAN frame
      */
-    void pack_uint32(uint8_t* dest, uint32_t value);
-};
+    can_frame generateGroupVoltageSet(uint8_t group, float voltage) {
+        return _generator->generateGroupVoltageSet(group, voltage);
+    }
 
-/**
- * @brief CAN Protocol Manager (Context)
- */
-class CanProtocolManager {
-public:
     /**
-     * @brief Constructor with protocol selection
-     * @param protocol Type of protocol to use
+     * @brief Generate CAN frame setting the voltage of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param voltage Voltage value (in mV units)
+     * @return Generated CAN frame
      */
-    explicit CanProtocolManager(ProtocolType protocol) {
-        switch(protocol) {
-            case ProtocolType::UUgreen:
-                _generator = std::make_unique<UUgreenFrameGenerator>();
-                break;
-            case ProtocolType::MMeet:
-                _generator = std::make_unique<MMeetFrameGenerator>();
-                break;
-            // Add other protocols...
-        }
+    can_frame generateGroupVoltageSet(uint8_t group, Millivolts voltage) {
+        return _generator->generateGroupVoltageSet(group, voltage);
     }
-    
+
     /**
-     * @brief Set protocol at runtime
-     * @param protocol New protocol type
+     * @brief Generate CAN frame setting the current of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param current Current value (in A units)
+     * @return Generated CAN frame
      */
-    void setProtocol(ProtocolType protocol) {
-        switch(protocol) {
-            case ProtocolType::UUgreen:
-                _generator = std::make_unique<UUgreenFrameGenerator>();
-                break;
-            case ProtocolType::MMeet:
-                _generator = std::make_unique<MMeetFrameGenerator>();
-                break;
-            // Add other protocols...
-        }
+    can_frame generateGroupCurrentSet(uint8_t group, float current) {
+        return _generator->generateGroupCurrentSet(group, current);
+    }
+
+    /**
+     * @brief Generate CAN frame setting the current of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param current Current value (in mA units)
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupCurrentSet(uint8_t group, Milliamps current) {
+        return _generator->generateGroupCurrentSet(group, current);
+    }
+
+    /**
+     * @brief Generate CAN frame for power ON of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupEnable(uint8_t group) {
+        return _generator->generateGroupEnable(group);
+    }
+
+    /**
+     * @brief Generate CAN frame for power OFF of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    can_frame generateGroupDisable(uint8_t group) {
+        return _generator->generateGroupDisable(group);
+    }
+
+    /**
+     * @brief Generate request frames of one kind for a list of modules
+     * @param request Kind of request to generate
+     * @param module_addresses Device addresses
+     * @param count Number of addresses in module_addresses
+     * @param frames Caller-owned buffer with room for count frames
+     * @return Number of frames written
+     */
+    size_t generateRequestBatch(RequestType request, const uint8_t* module_addresses,
+                                size_t count, can_frame* frames) {
+        return _generator->generateRequestBatch(request, module_addresses, count, frames);
     }
 
+    /**
+     * @brief Generate request frames of one kind for consecutive module addresses
+     * @param request Kind of request to generate
+     * @param first_address First device address
+     * @param count Number of consecutive addresses
+     * @param frames Caller-owned buffer with room for count frames
+     * @return Number of frames written
+     */
+    size_t generateRequestRange(RequestType request, uint8_t first_address,
+                                size_t count, can_frame* frames) {
+        return _generator->generateRequestRange(request, first_address, count, frames);
+    }
+    
+private:
+    std::unique_ptr<ICanFrameGenerator> _generator;
+};
+
+/**
+ * @brief CAN Protocol Manager with the protocol fixed at compile time
+ *
+ * Same interface as CanProtocolManager, but without heap allocation or
+ * virtual dispatch, so frame construction inlines into the caller.
+ * Use CanProtocolManager when the protocol has to change at runtime.
+ */
+template <ProtocolType Protocol>
+class StaticCanProtocolManager {
+public:
+    using Builder = FrameBuilder<Protocol>;
+    using GroupBuilder = GroupFrameBuilder<Protocol>;
+
+    /**
+     * @brief Protocol this manager generates frames for
+     * @return Protocol type
+     */
+    static constexpr ProtocolType protocol() { return Protocol; }
+
     /**
      * @brief Generate CAN frame for temperature reading request
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateTempRequest(uint8_t module_address) {
-        return _generator->generateTempRequest(module_address);
+    constexpr can_frame generateTempRequest(uint8_t module_address) const {
+        return Builder::generateTempRequest(module_address);
     }
 
     /**
@@ -448,8 +1559,8 @@ public:
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateCurrentCapabilityRequest(uint8_t module_address) {
-        return _generator->generateCurrentCapabilityRequest(module_address);
+    constexpr can_frame generateCurrentCapabilityRequest(uint8_t module_address) const {
+        return Builder::generateCurrentCapabilityRequest(module_address);
     }
 
     /**
@@ -457,8 +1568,8 @@ public:
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateFlagsRequest(uint8_t module_address) {
-        return _generator->generateFlagsRequest(module_address);
+    constexpr can_frame generateFlagsRequest(uint8_t module_address) const {
+        return Builder::generateFlagsRequest(module_address);
     }
 
     /**
@@ -466,44 +1577,44 @@ public:
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateVoltageRequest(uint8_t module_address) {
-        return _generator->generateVoltageRequest(module_address);
-    } 
-    
+    constexpr can_frame generateVoltageRequest(uint8_t module_address) const {
+        return Builder::generateVoltageRequest(module_address);
+    }
+
     /**
      * @brief Generate CAN frame for current reading request
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateCurrentRequest(uint8_t module_address) {
-        return _generator->generateCurrentRequest(module_address);
-    } 
-    
+    constexpr can_frame generateCurrentRequest(uint8_t module_address) const {
+        return Builder::generateCurrentRequest(module_address);
+    }
+
     /**
      * @brief Generate CAN frame for set low mode request
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateLowModeSet(uint8_t module_address) {
-        return _generator->generateLowModeSet(module_address);
-    } 
+    constexpr can_frame generateLowModeSet(uint8_t module_address) const {
+        return Builder::generateLowModeSet(module_address);
+    }
 
     /**
      * @brief Generate CAN frame for set high mode request
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateHighModeSet(uint8_t module_address) {
-        return _generator->generateHighModeSet(module_address);
-    } 
+    constexpr can_frame generateHighModeSet(uint8_t module_address) const {
+        return Builder::generateHighModeSet(module_address);
+    }
 
     /**
      * @brief Generate CAN frame for set auto mode request
      * @param module_address Device address
-     * @return Generated CAN frame
+     * @return Generated CAN frame or std::nullopt if not supported
      */
-    std::optional<can_frame> generateAutoModeSet(uint8_t module_address) {
-        return _generator->generateAutoModeSet(module_address);
+    constexpr std::optional<can_frame> generateAutoModeSet(uint8_t module_address) const {
+        return Builder::generateAutoModeSet(module_address);
     }
 
     /**
@@ -512,18 +1623,38 @@ public:
      * @param voltage Voltage value (in V units)
      * @return Generated CAN frame
      */
-    can_frame generateVoltageSet(uint8_t module_address, float voltage) {
-        return _generator->generateVoltageSet(module_address , voltage);
+    constexpr can_frame generateVoltageSet(uint8_t module_address, float voltage) const {
+        return Builder::generateVoltageSet(module_address, voltage);
     }
-    
+
+    /**
+     * @brief Generate CAN frame for voltage setting
+     * @param module_address Device address
+     * @param voltage Voltage value (in mV units)
+     * @return Generated CAN frame
+     */
+    constexpr can_frame generateVoltageSet(uint8_t module_address, Millivolts voltage) const {
+        return Builder::generateVoltageSet(module_address, voltage);
+    }
+
     /**
      * @brief Generate CAN frame for current setting
      * @param module_address Device address
      * @param current Current value (in A units)
      * @return Generated CAN frame
      */
-    can_frame generateCurrentSet(uint8_t module_address, float current) {
-        return _generator->generateCurrentSet(module_address , current);
+    constexpr can_frame generateCurrentSet(uint8_t module_address, float current) const {
+        return Builder::generateCurrentSet(module_address, current);
+    }
+
+    /**
+     * @brief Generate CAN frame for current setting
+     * @param module_address Device address
+     * @param current Current value (in mA units)
+     * @return Generated CAN frame
+     */
+    constexpr can_frame generateCurrentSet(uint8_t module_address, Milliamps current) const {
+        return Builder::generateCurrentSet(module_address, current);
     }
 
     /**
@@ -531,8 +1662,8 @@ public:
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateEnable(uint8_t module_address) {
-        return _generator->generateEnable(module_address);
+    constexpr can_frame generateEnable(uint8_t module_address) const {
+        return Builder::generateEnable(module_address);
     }
 
     /**
@@ -540,12 +1671,120 @@ public:
      * @param module_address Device address
      * @return Generated CAN frame
      */
-    can_frame generateDisable(uint8_t module_address) {
-        return _generator->generateDisable(module_address);
+    constexpr can_frame generateDisable(uint8_t module_address) const {
+        return Builder::generateDisable(module_address);
+    }
+
+    /**
+     * @brief Generate CAN frame setting low mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    constexpr can_frame generateGroupLowModeSet(uint8_t group) const {
+        return GroupBuilder::generateGroupLowModeSet(group);
+    }
+
+    /**
+     * @brief Generate CAN frame setting high mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    constexpr can_frame generateGroupHighModeSet(uint8_t group) const {
+        return GroupBuilder::generateGroupHighModeSet(group);
+    }
+
+    /**
+     * @brief Generate CAN frame setting auto mode on a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame or std::nullopt if not supported
+     */
+    constexpr std::optional<can_frame> generateGroupAutoModeSet(uint8_t group) const {
+        return GroupBuilder::generateGroupAutoModeSet(group);
+    }
+
+    /**
+     * @brief Generate CAN frame setting the voltage of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param voltage Voltage value (in V units)
+     * @return Generated CAN frame
+     */
+    constexpr can_frame generateGroupVoltageSet(uint8_t group, float voltage) const {
+        return GroupBuilder::generateGroupVoltageSet(group, voltage);
+    }
+
+    /**
+     * @brief Generate CAN frame setting the voltage of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param voltage Voltage value (in mV units)
+     * @return Generated CAN frame
+     */
+    constexpr can_frame generateGroupVoltageSet(uint8_t group, Millivolts voltage) const {
+        return GroupBuilder::generateGroupVoltageSet(group, voltage);
+    }
+
+    /**
+     * @brief Generate CAN frame setting the current of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param current Current value (in A units)
+     * @return Generated CAN frame
+     */
+    constexpr can_frame generateGroupCurrentSet(uint8_t group, float current) const {
+        return GroupBuilder::generateGroupCurrentSet(group, current);
+    }
+
+    /**
+     * @brief Generate CAN frame setting the current of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @param current Current value (in mA units)
+     * @return Generated CAN frame
+     */
+    constexpr can_frame generateGroupCurrentSet(uint8_t group, Milliamps current) const {
+        return GroupBuilder::generateGroupCurrentSet(group, current);
+    }
+
+    /**
+     * @brief Generate CAN frame for power ON of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    constexpr can_frame generateGroupEnable(uint8_t group) const {
+        return GroupBuilder::generateGroupEnable(group);
+    }
+
+    /**
+     * @brief Generate CAN frame for power OFF of a group of modules
+     * @param group Group number, BROADCAST_GROUP for every module
+     * @return Generated CAN frame
+     */
+    constexpr can_frame generateGroupDisable(uint8_t group) const {
+        return GroupBuilder::generateGroupDisable(group);
+    }
+
+    /**
+     * @brief Generate request frames of one kind for a list of modules
+     * @param request Kind of request to generate
+     * @param module_addresses Device addresses
+     * @param count Number of addresses in module_addresses
+     * @param frames Caller-owned buffer with room for count frames
+     * @return Number of frames written
+     */
+    size_t generateRequestBatch(RequestType request, const uint8_t* module_addresses,
+                                size_t count, can_frame* frames) const {
+        return build_request_batch<Protocol>(request, module_addresses, count, frames);
+    }
+
+    /**
+     * @brief Generate request frames of one kind for consecutive module addresses
+     * @param request Kind of request to generate
+     * @param first_address First device address
+     * @param count Number of consecutive addresses
+     * @param frames Caller-owned buffer with room for count frames
+     * @return Number of frames written
+     */
+    size_t generateRequestRange(RequestType request, uint8_t first_address,
+                                size_t count, can_frame* frames) const {
+        return build_request_range<Protocol>(request, first_address, count, frames);
     }
-    
-private:
-    std::unique_ptr<ICanFrameGenerator> _generator;
 };
 
 #pragma pack(push,1)
@@ -564,8 +1803,176 @@ struct ParsedData {
 };
 #pragma pack(pop)
 
+/**
+ * @brief Compact naturally aligned telemetry of one module
+ *
+ * Integer values in fixed units independent of the protocol, so arrays of
+ * records scan without misaligned loads and two records share a cache line.
+ */
+struct alignas(32) TelemetryRecord {
+    uint32_t voltage_mv = 0;        // Voltage, mV
+    uint32_t current_ma = 0;        // Current, mA
+    uint32_t capability_milli = 0;  // Current capability, 0.001 units
+    uint32_t status = 0;            // Status flags as received
+    int32_t temperature_mdeg = 0;   // Temperature, 0.001 degC
+    uint8_t address = 0;            // Module address
+    uint8_t fields = 0;             // Bit per ParsedData::Field
+
+    /**
+     * @brief Check whether a field carries a value
+     * @param field Field to check
+     * @return bool isSet
+     */
+    constexpr bool has(ParsedData::Field field) const {
+        return (fields >> field) & 1u;
+    }
+
+    /**
+     * @brief Converting parsed data into a compact record
+     * @param data Parsed data, values rounded to the record units
+     * @return TelemetryRecord record
+     */
+    static TelemetryRecord fromParsedData(const ParsedData& data);
+
+    /**
+     * @brief Converting the record back into parsed data
+     * @return ParsedData data, temperature truncated to whole degC as parse() does
+     */
+    ParsedData toParsedData() const;
+};
+
+static_assert(sizeof(TelemetryRecord) == 32, "TelemetryRecord must fill half a cache line");
+static_assert(ParsedData::COUNT <= 8, "ParsedData fields must fit TelemetryRecord::fields");
+
 enum class ParseResult { OK, UNKNOWN_CMD, INVALID_FRAME };
 
+/**
+ * @brief Decoding rule for one telemetry command
+ */
+struct CommandEntry {
+    uint8_t field = ParsedData::COUNT;  // ParsedData::Field, COUNT for unknown command
+    bool is_signed = false;             // Payload is two's complement
+    float scale = 1.0f;                 // Multiplier from raw value to V, A or degC
+};
+
+/**
+ * @brief Dispatch table indexed by the protocol command key
+ */
+using CommandTable = std::array<CommandEntry, 256>;
+
+/**
+ * @brief Build dispatch table from (key, entry) pairs at compile time
+ * @param entries Known commands
+ * @return Table with every other key mapped to unknown
+ */
+template <size_t N>
+constexpr CommandTable make_command_table(const std::pair<uint8_t, CommandEntry> (&entries)[N]) {
+    CommandTable table{};
+    for (const auto& [key, entry] : entries) {
+        table[key] = entry;
+    }
+    return table;
+}
+
+/**
+ * @brief UUgreen telemetry commands, indexed by data[1]
+ */
+inline constexpr CommandTable UUGREEN_COMMANDS = make_command_table<7>({
+    {UUgreenConstants::VOLTAGE_CMD,     {ParsedData::VOLTAGE,    false, 0.001f}},
+    {UUgreenConstants::VOLTAGE_ALT_CMD, {ParsedData::VOLTAGE,    false, 0.001f}},
+    {UUgreenConstants::CURRENT_CMD,     {ParsedData::CURRENT,    false, 0.001f}},
+    {UUgreenConstants::CURRENT_ALT_CMD, {ParsedData::CURRENT,    false, 0.001f}},
+    {UUgreenConstants::FLAGS_CMD,       {ParsedData::STATUS,     false, 1.0f}},
+    {UUgreenConstants::TEMP_CMD,        {ParsedData::TEMP,       true,  0.001f}},
+    {UUgreenConstants::CURRENT_CAP_CMD, {ParsedData::CAPABILITY, false, 0.001f}},
+});
+
+// MMeet telemetry commands share the high byte, the table is indexed by data[3]
+constexpr uint8_t MMEET_TELEMETRY_CMD_HIGH = MMeetConstants::VOLTAGE_CMD >> 8;
+static_assert((MMeetConstants::CURRENT_CMD >> 8) == MMEET_TELEMETRY_CMD_HIGH &&
+              (MMeetConstants::FLAGS_CMD >> 8) == MMEET_TELEMETRY_CMD_HIGH &&
+              (MMeetConstants::TEMP_CMD >> 8) == MMEET_TELEMETRY_CMD_HIGH &&
+              (MMeetConstants::CURRENT_CAP_CMD >> 8) == MMEET_TELEMETRY_CMD_HIGH,
+              "MMeet telemetry commands must share the high byte");
+
+/**
+ * @brief MMeet telemetry commands, indexed by data[3] when data[2] == MMEET_TELEMETRY_CMD_HIGH
+ */
+inline constexpr CommandTable MMEET_COMMANDS = make_command_table<5>({
+    {MMeetConstants::VOLTAGE_CMD & 0xFF,     {ParsedData::VOLTAGE,    false, 0.001f}},
+    {MMeetConstants::CURRENT_CMD & 0xFF,     {ParsedData::CURRENT,    false, 0.001f}},
+    {MMeetConstants::FLAGS_CMD & 0xFF,       {ParsedData::STATUS,     false, 1.0f}},
+    {MMeetConstants::TEMP_CMD & 0xFF,        {ParsedData::TEMP,       true,  0.1f}},
+    {MMeetConstants::CURRENT_CAP_CMD & 0xFF, {ParsedData::CAPABILITY, false, 0.1f}},
+});
+
+/**
+ * @brief Multipliers from raw payload to TelemetryRecord units, indexed like the command table
+ * @param table Command table of the protocol
+ * @return Factor per key: 0.001 V, A or degC per raw unit, 1 for status bits
+ */
+constexpr std::array<uint32_t, 256> make_record_factors(const CommandTable& table) {
+    std::array<uint32_t, 256> factors{};
+    for (size_t key = 0; key < table.size(); ++key) {
+        factors[key] = table[key].field == ParsedData::STATUS
+            ? 1u
+            : static_cast<uint32_t>(table[key].scale * 1000.0f + 0.5f);
+    }
+    return factors;
+}
+
+inline constexpr auto UUGREEN_RECORD_FACTORS = make_record_factors(UUGREEN_COMMANDS);
+inline constexpr auto MMEET_RECORD_FACTORS = make_record_factors(MMEET_COMMANDS);
+static_assert(MMEET_RECORD_FACTORS[MMeetConstants::TEMP_CMD & 0xFF] == 100, "MMeet temperature in 0.1 degC");
+
+/**
+ * @brief Struct-of-arrays output for CanParser::parseBatch
+ *
+ * Every array must have room for as many entries as frames passed in.
+ * Entry i always describes frame i; fields of rejected frames are
+ * ParsedData::COUNT with address and raw value set to 0.
+ */
+struct ParsedBatch {
+    uint8_t* address;       // Module address
+    uint8_t* field;         // ParsedData::Field carried by the frame
+    uint32_t* raw;          // Unscaled 32-bit payload value
+    ParseResult* result;    // Parse outcome
+    float* value = nullptr; // Scaled value in V, A or degC (decodeBatch only)
+};
+
+/**
+ * @brief Implementations of the batch decode loop
+ */
+enum class DecodeKernel {
+    Scalar,
+    SSE4,   // x86 SSE4.1, 4 frames per step
+    AVX2    // x86 AVX2, 8 frames per step
+};
+
+/**
+ * @brief Frame counts produced by CanParser::splitByProtocol
+ */
+struct ProtocolSplit {
+    size_t uugreen = 0;     // Frames copied to the UUgreen span
+    size_t mmeet = 0;       // Frames copied to the MMeet span
+    size_t unknown = 0;     // Frames matching no protocol, dropped
+};
+
+/**
+ * @brief Default handlers for CanParser::dispatch
+ *
+ * Derive a visitor from it and declare only the handlers you need; the
+ * others do nothing. Values are in TelemetryRecord units, dispatch calls
+ * the handlers of the derived type directly, so no virtual calls.
+ */
+struct TelemetryVisitor {
+    void onVoltage(uint8_t, uint32_t) {}         // address, mV
+    void onCurrent(uint8_t, uint32_t) {}         // address, mA
+    void onTemperature(uint8_t, int32_t) {}      // address, 0.001 degC
+    void onStatus(uint8_t, uint32_t) {}          // address, status bits as received
+    void onCapability(uint8_t, uint32_t) {}      // address, 0.001 A
+};
+
 class CanParser {
 public:
     /**
@@ -575,6 +1982,131 @@ public:
      * @return  std::pair<std::optional<ParsedData>, ParseResult> data
      */
     std::pair<std::optional<ParsedData>, ParseResult> parse(can_frame frame, ProtocolType protocol);
+
+    /**
+     * @brief Detecting the protocol of a CAN frame from its ID
+     * @param frame CAN frame to classify
+     * @return std::optional<ProtocolType> protocol, nullopt if no protocol matches
+     * @note MMeet is checked first: MMEET_ID also carries the UUgreen bit
+     */
+    static std::optional<ProtocolType> detectProtocol(const can_frame& frame);
+
+    /**
+     * @brief Parsing CAN frame of any supported protocol
+     * @param frame CAN frame for parsing
+     * @return std::tuple<std::optional<ParsedData>, ParseResult, std::optional<ProtocolType>> data, result and matched protocol
+     */
+    std::tuple<std::optional<ParsedData>, ParseResult, std::optional<ProtocolType>> parseAny(can_frame frame);
+
+    /**
+     * @brief Parsing many CAN frames into struct-of-arrays output
+     * @param frames Frames for parsing
+     * @param count Number of frames
+     * @param protocol Type protocol for interpretation
+     * @param out Output arrays, each with room for count entries
+     * @return size_t Number of frames parsed with ParseResult::OK
+     */
+    size_t parseBatch(const can_frame* frames, size_t count, ProtocolType protocol, const ParsedBatch& out) const;
+
+    /**
+     * @brief Decoding many CAN frames into scaled values with the fastest kernel
+     * @param frames Frames for parsing
+     * @param count Number of frames
+     * @param protocol Type protocol for interpretation
+     * @param out Output arrays including value, each with room for count entries
+     * @return size_t Number of frames parsed with ParseResult::OK
+     * @note Values are bit-identical to parse(); STATUS frames carry their bits in raw
+     */
+    size_t decodeBatch(const can_frame* frames, size_t count, ProtocolType protocol, const ParsedBatch& out) const;
+
+    /**
+     * @brief Decoding many CAN frames with a specific kernel
+     * @param frames Frames for parsing
+     * @param count Number of frames
+     * @param protocol Type protocol for interpretation
+     * @param out Output arrays including value, each with room for count entries
+     * @param kernel Kernel to use, falls back to Scalar when the CPU lacks support
+     * @return size_t Number of frames parsed with ParseResult::OK
+     */
+    size_t decodeBatch(const can_frame* frames, size_t count, ProtocolType protocol, const ParsedBatch& out,
+                       DecodeKernel kernel) const;
+
+    /**
+     * @brief Check whether a decode kernel can run on this CPU
+     * @param kernel Kernel to check
+     * @return bool isSupported
+     */
+    static bool isDecodeKernelSupported(DecodeKernel kernel);
+
+    /**
+     * @brief Fastest decode kernel supported by this CPU (detected once)
+     * @return DecodeKernel kernel
+     */
+    static DecodeKernel bestDecodeKernel();
+
+    /**
+     * @brief Parsing CAN frame straight into a compact record
+     * @param frame CAN frame for parsing
+     * @param protocol Type protocol for interpretation
+     * @return std::pair<std::optional<TelemetryRecord>, ParseResult> record
+     */
+    std::pair<std::optional<TelemetryRecord>, ParseResult> parseRecord(const can_frame& frame, ProtocolType protocol) const;
+
+    /**
+     * @brief Parsing many CAN frames into compact records
+     * @param frames Frames for parsing
+     * @param count Number of frames
+     * @param protocol Type protocol for interpretation
+     * @param records Output with room for count records, rejected frames leave an empty record
+     * @return size_t Number of frames parsed with ParseResult::OK
+     */
+    size_t parseRecords(const can_frame* frames, size_t count, ProtocolType protocol, TelemetryRecord* records) const;
+
+    /**
+     * @brief Decoding a CAN frame straight into the handler of its field
+     *
+     * The frame is read in place and no ParsedData or record is built, so
+     * the handler inlines into the caller, e.g. a registry update.
+     * @param frame CAN frame for parsing
+     * @param protocol Type protocol for interpretation
+     * @param visitor Handlers as in TelemetryVisitor, exactly one is called on ParseResult::OK
+     * @return ParseResult result
+     */
+    template <typename Visitor>
+    ParseResult dispatch(const can_frame& frame, ProtocolType protocol, Visitor&& visitor) const {
+        const ParseResult result = protocol == ProtocolType::MMeet ? dispatch_frame<ProtocolType::MMeet>(frame, visitor)
+                                                                   : dispatch_frame<ProtocolType::UUgreen>(frame, visitor);
+#ifdef LIBMODUL_METRICS
+        count_frame(protocol, result, frame);
+#endif
+        return result;
+    }
+
+    /**
+     * @brief Decoding a CAN frame of any supported protocol into the handler of its field
+     * @param frame CAN frame for parsing, protocol detected as in detectProtocol
+     * @param visitor Handlers as in TelemetryVisitor
+     * @return ParseResult result, INVALID_FRAME if no protocol matches
+     */
+    template <typename Visitor>
+    ParseResult dispatch(const can_frame& frame, Visitor&& visitor) const {
+        // Frames of no protocol are not counted, as in parseAny
+        const bool mmeet = (frame.can_id & MMEET_MASK) == MMEET_ID;
+        if (!mmeet && (frame.can_id & UUGREEN_MASK) != UUGREEN_MASK)
+            return ParseResult::INVALID_FRAME;
+        return dispatch(frame, mmeet ? ProtocolType::MMeet : ProtocolType::UUgreen, visitor);
+    }
+
+    /**
+     * @brief Splitting mixed-bus frames by protocol in a single pass
+     * @param frames Frames to classify
+     * @param count Number of frames
+     * @param uugreen Output for UUgreen frames, room for count frames
+     * @param mmeet Output for MMeet frames, room for count frames
+     * @return ProtocolSplit Number of frames in each output and dropped
+     * @note Order within each output follows the input, ready for parseBatch or decodeBatch
+     */
+    ProtocolSplit splitByProtocol(const can_frame* frames, size_t count, can_frame* uugreen, can_frame* mmeet) const;
     
 
 private:
@@ -610,6 +2142,142 @@ private:
      */
     std::pair<std::optional<ParsedData>, ParseResult> parseMMeet(can_frame frame);
 
+    /**
+     * @brief Batch parsing for protocol UUgreen
+     * @param frames Frames for parsing
+     * @param count Number of frames
+     * @param out Output arrays
+     * @return size_t Number of frames parsed with ParseResult::OK
+     */
+    size_t parseBatchUUgreen(const can_frame* frames, size_t count, const ParsedBatch& out) const;
+
+    /**
+     * @brief Batch parsing for protocol MMeet
+     * @param frames Frames for parsing
+     * @param count Number of frames
+     * @param out Output arrays
+     * @return size_t Number of frames parsed with ParseResult::OK
+     */
+    size_t parseBatchMMeet(const can_frame* frames, size_t count, const ParsedBatch& out) const;
+
+#ifdef LIBMODUL_METRICS
+    /**
+     * @brief Counting a dispatched frame in Metrics, out of line since Metrics.h includes this header
+     */
+    static void count_frame(ProtocolType protocol, ParseResult result, const can_frame& frame);
+#endif
+
+    /**
+     * @brief Decoding one frame of a known protocol for dispatch and parseRecord(s), integer arithmetic only
+     * @param frame CAN frame for parsing
+     * @param visitor Handlers as in TelemetryVisitor
+     * @return ParseResult result
+     */
+    template <ProtocolType Protocol, typename Visitor>
+    static ParseResult dispatch_frame(const can_frame& frame, Visitor& visitor) {
+        constexpr bool mmeet = Protocol == ProtocolType::MMeet;
+        const bool valid = mmeet ? (frame.can_id & MMEET_MASK) == MMEET_ID
+                                 : (frame.can_id & UUGREEN_MASK) == UUGREEN_MASK;
+        if (!valid || frame.can_dlc != CAN_INV_DLC)
+            return ParseResult::INVALID_FRAME;
+
+        const uint8_t key = mmeet ? (frame.data[2] == MMEET_TELEMETRY_CMD_HIGH ? frame.data[3] : 0) : frame.data[1];
+        const CommandEntry& entry = (mmeet ? MMEET_COMMANDS : UUGREEN_COMMANDS)[key];
+        if (entry.field == ParsedData::COUNT)
+            return ParseResult::UNKNOWN_CMD;
+
+        const uint32_t raw = uint32_t(frame.data[4]) << 24 | uint32_t(frame.data[5]) << 16 |
+                             uint32_t(frame.data[6]) << 8 | frame.data[7];
+        // Modular product is also correct for the two's complement temperature
+        const uint32_t value = raw * (mmeet ? MMEET_RECORD_FACTORS : UUGREEN_RECORD_FACTORS)[key];
+        const uint8_t address = static_cast<uint8_t>(mmeet ? (frame.can_id & 0x7F8) >> 3
+                                                           : (frame.can_id & 0x1FC000) >> 14);
+        switch(entry.field) {
+            case ParsedData::VOLTAGE: visitor.onVoltage(address, value); break;
+            case ParsedData::CURRENT: visitor.onCurrent(address, value); break;
+            case ParsedData::TEMP: visitor.onTemperature(address, static_cast<int32_t>(value)); break;
+            case ParsedData::STATUS: visitor.onStatus(address, raw); break;
+            case ParsedData::CAPABILITY: visitor.onCapability(address, value); break;
+        }
+        return ParseResult::OK;
+    }
+
     // Add other protocol ...
 };
 
+
+/**
+ * @brief Latest telemetry of every module on one bus
+ *
+ * Fixed table of 128 slots indexed by the 7-bit module address. One ingest
+ * thread folds parsed frames into the slots, any number of threads read
+ * consistent snapshots without locks: each slot is guarded by a seqlock.
+ */
+class ModuleRegistry {
+public:
+    static constexpr size_t SLOT_COUNT = MODULE_ADDRESS_COUNT;
+
+    /**
+     * @brief Merging the fields present in a record into its module slot
+     * @param record Parsed record, only fields set in record.fields are written
+     * @note Single writer: call from the ingest thread only
+     */
+    void update(const TelemetryRecord& record);
+
+    /**
+     * @brief Merging the fields present in parsed data into its module slot
+     * @param data Parsed data, only fields set in data.fields are written
+     * @note Single writer: call from the ingest thread only
+     */
+    void update(const ParsedData& data);
+
+    /**
+     * @brief Merging many records, e.g. the output of CanParser::parseRecords
+     * @param records Records to merge, records without fields are skipped
+     * @param count Number of records
+     * @return size_t Number of records merged
+     */
+    size_t update(const TelemetryRecord* records, size_t count);
+
+    /**
+     * @brief Reading a consistent snapshot of a module slot without locking
+     * @param address Module address, masked to 7 bits
+     * @param record Output snapshot
+     * @return bool true if the module has reported at least one field
+     */
+    bool read(uint8_t address, TelemetryRecord& record) const;
+
+    /**
+     * @brief Reading a module snapshot as parsed data
+     * @param address Module address, masked to 7 bits
+     * @return std::optional<ParsedData> data, nullopt if the module never reported
+     */
+    std::optional<ParsedData> get(uint8_t address) const;
+
+    /**
+     * @brief Number of updates applied to a slot, changes whenever its data does
+     * @param address Module address, masked to 7 bits
+     * @return uint32_t version
+     */
+    uint32_t version(uint8_t address) const;
+
+    /**
+     * @brief Forgetting every module
+     * @note Single writer: call from the ingest thread only
+     */
+    void clear();
+
+private:
+    static constexpr size_t WORD_COUNT = sizeof(TelemetryRecord) / sizeof(uint64_t);
+
+    // One cache line per slot so readers of neighbours never share a line with the writer
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> sequence{0};          // Odd while a write is in progress
+        std::atomic<uint64_t> words[WORD_COUNT]{};  // TelemetryRecord bytes
+    };
+
+    void store(Slot& slot, const TelemetryRecord& record);
+    static TelemetryRecord load_unsynchronized(const Slot& slot);
+
+    std::array<Slot, SLOT_COUNT> _slots;
+};
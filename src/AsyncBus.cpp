@@ -0,0 +1,150 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include "../include/AsyncBus.h"
+
+#if defined(__linux__) && defined(__cpp_impl_coroutine)
+#include <algorithm>
+
+namespace {
+    constexpr size_t RX_BURST = CanTransport::BURST_CAPACITY;
+    constexpr size_t WHEEL_SLOTS = 1024;
+    // The TX queue drains on the I/O thread without telling us, so blocked sends poll it
+    constexpr int TX_RETRY_MS = 1;
+}
+
+AsyncBus::AsyncBus(CanTransport& transport, ProtocolType protocol)
+    : _transport(transport), _protocol(protocol), _manager(protocol),
+      _wheel(std::chrono::milliseconds(1), WHEEL_SLOTS, Clock::now()) {}
+
+AsyncBus::~AsyncBus() {
+    // Collect first: destroying a coroutine destroys the awaiters linked here
+    std::vector<std::coroutine_handle<>> handles;
+    for (ReadAwaiter* read : _timed) {
+        if (read) handles.push_back(read->_handle);
+    }
+    for (SendAwaiter* sender : _senders) handles.push_back(sender->_handle);
+    for (auto handle : _ready) handles.push_back(handle);
+    for (auto handle : handles) handle.destroy();
+}
+
+void AsyncBus::wait(ReadAwaiter& read, std::coroutine_handle<> handle) {
+    read._handle = handle;
+    read._result.reset();
+    const bool first = _reads[read._key] == nullptr;
+    read._next = _reads[read._key];
+    _reads[read._key] = &read;
+    ++_waiting;
+
+    if (_free_tags.empty()) {
+        read._tag = static_cast<uint32_t>(_timed.size());
+        _timed.push_back(&read);
+    } else {
+        read._tag = _free_tags.back();
+        _free_tags.pop_back();
+        _timed[read._tag] = &read;
+    }
+    read._timer = _wheel.arm(Clock::now() + read._timeout, read._tag);
+
+    // Later reads of the key ride on the request already on the bus
+    if (!first) return;
+    can_frame frame;
+    _manager.generateRequestRange(static_cast<RequestType>(read._key % REQUEST_TYPE_COUNT),
+                                  static_cast<uint8_t>(read._key / REQUEST_TYPE_COUNT), 1, &frame);
+    ++_stats.requests;
+    if (!_held.empty() || !_transport.send(frame)) _held.push_back(frame);
+}
+
+bool AsyncBus::try_send(const can_frame& frame) {
+    if (!_held.empty() || !_senders.empty()) return false;
+    return _transport.send(frame);
+}
+
+void AsyncBus::flush_held() {
+    if (!_held.empty()) {
+        const size_t sent = _transport.send(_held.data(), _held.size());
+        _held.erase(_held.begin(), _held.begin() + static_cast<std::ptrdiff_t>(sent));
+        if (!_held.empty()) return;
+    }
+    size_t sent = 0;
+    while (sent < _senders.size() && _transport.send(_senders[sent]->_frame)) {
+        _ready.push_back(_senders[sent]->_handle);
+        ++sent;
+    }
+    _senders.erase(_senders.begin(), _senders.begin() + static_cast<std::ptrdiff_t>(sent));
+}
+
+void AsyncBus::complete(const TelemetryRecord& record) {
+    // A parsed response carries ADDR plus exactly one telemetry field
+    const uint8_t telemetry = record.fields & ~(1u << ParsedData::ADDR);
+    const auto request = telemetry ? request_for_field(static_cast<uint8_t>(__builtin_ctz(telemetry))) : std::nullopt;
+    if (!request) return;
+
+    const uint16_t key = key_of(record.address, *request);
+    ReadAwaiter* read = _reads[key];
+    if (!read) {
+        ++_stats.unmatched;
+        return;
+    }
+    _reads[key] = nullptr;
+    for (; read; read = read->_next) {
+        _wheel.cancel(read->_timer);
+        _timed[read->_tag] = nullptr;
+        _free_tags.push_back(read->_tag);
+        read->_result = record;
+        _ready.push_back(read->_handle);
+        --_waiting;
+        ++_stats.completed;
+    }
+}
+
+void AsyncBus::expire(uint32_t tag) {
+    ReadAwaiter* read = _timed[tag];
+    _timed[tag] = nullptr;
+    _free_tags.push_back(tag);
+
+    ReadAwaiter** link = &_reads[read->_key];
+    while (*link != read) link = &(*link)->_next;
+    *link = read->_next;
+
+    read->_result.reset();
+    _ready.push_back(read->_handle);
+    --_waiting;
+    ++_stats.timed_out;
+}
+
+size_t AsyncBus::resume_ready() {
+    // Resumed conversations may suspend again and queue into _ready on a later turn only
+    std::vector<std::coroutine_handle<>> ready;
+    ready.swap(_ready);
+    for (auto handle : ready) handle.resume();
+    return ready.size();
+}
+
+size_t AsyncBus::runOnce(int timeout_ms) {
+    flush_held();
+    size_t resumed = resume_ready();
+
+    int wait = resumed ? 0 : timeout_ms;
+    if (const auto next = _wheel.nextExpiry()) {
+        const auto left = std::chrono::ceil<std::chrono::milliseconds>(*next - Clock::now()).count();
+        const int until = static_cast<int>(std::max<decltype(left)>(left, 0));
+        if (wait < 0 || until < wait) wait = until;
+    }
+    if ((!_held.empty() || !_senders.empty()) && (wait < 0 || wait > TX_RETRY_MS)) wait = TX_RETRY_MS;
+    if (wait < 0 && !suspended()) wait = 0;
+
+    can_frame frames[RX_BURST];
+    TelemetryRecord records[RX_BURST];
+    for (size_t received = _transport.receive(frames, RX_BURST, wait); received;
+         received = received < RX_BURST ? 0 : _transport.receive(frames, RX_BURST, 0)) {
+        _parser.parseRecords(frames, received, _protocol, records);
+        for (size_t i = 0; i < received; ++i) complete(records[i]);
+    }
+    _wheel.advance(Clock::now(), [this](uint32_t tag, Clock::time_point) { expire(tag); });
+    return resumed + resume_ready();
+}
+
+void AsyncBus::run() {
+    while (suspended() || !_ready.empty()) runOnce(-1);
+}
+
+#endif
@@ -0,0 +1,192 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include "../include/CanCapture.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+namespace {
+    // write/writev until everything is out, false on error
+    bool write_all(int fd, iovec* parts, int count) {
+        while (count > 0) {
+            const ssize_t written = ::writev(fd, parts, count);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            size_t left = static_cast<size_t>(written);
+            while (count > 0 && left >= parts->iov_len) {
+                left -= parts->iov_len;
+                ++parts;
+                --count;
+            }
+            if (count > 0) {
+                parts->iov_base = static_cast<uint8_t*>(parts->iov_base) + left;
+                parts->iov_len -= left;
+            }
+        }
+        return true;
+    }
+}
+
+bool CaptureWriter::open(const char* path, ProtocolType protocol, uint32_t block_frames) {
+    close();
+    if (block_frames == 0) return false;
+    _fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (_fd < 0) return false;
+
+    CaptureFormat::FileHeader header{};
+    std::memcpy(header.magic, CaptureFormat::MAGIC, sizeof(header.magic));
+    header.version = CaptureFormat::VERSION;
+    header.frame_size = sizeof(can_frame);
+    header.protocol = static_cast<uint32_t>(protocol);
+    header.block_frames = block_frames;
+    header.created_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    iovec part{&header, sizeof(header)};
+    if (!write_all(_fd, &part, 1)) {
+        ::close(_fd);
+        _fd = -1;
+        return false;
+    }
+
+    _block_frames = block_frames;
+    _pending = 0;
+    _frames = std::make_unique<can_frame[]>(block_frames);
+    _timestamps = std::make_unique<uint64_t[]>(block_frames);
+    _frames_written = 0;
+    return true;
+}
+
+bool CaptureWriter::append(const can_frame* frames, size_t count, uint64_t timestamp_ns) {
+    if (_fd < 0) return false;
+    while (count > 0) {
+        const size_t room = _block_frames - _pending;
+        const size_t taken = count < room ? count : room;
+        std::memcpy(&_frames[_pending], frames, taken * sizeof(can_frame));
+        std::fill_n(&_timestamps[_pending], taken, timestamp_ns);
+        _pending += static_cast<uint32_t>(taken);
+        frames += taken;
+        count -= taken;
+        if (_pending == _block_frames && !write_block()) return false;
+    }
+    return true;
+}
+
+bool CaptureWriter::append(const can_frame* frames, const uint64_t* timestamps_ns, size_t count) {
+    if (_fd < 0) return false;
+    while (count > 0) {
+        const size_t room = _block_frames - _pending;
+        const size_t taken = count < room ? count : room;
+        std::memcpy(&_frames[_pending], frames, taken * sizeof(can_frame));
+        std::memcpy(&_timestamps[_pending], timestamps_ns, taken * sizeof(uint64_t));
+        _pending += static_cast<uint32_t>(taken);
+        frames += taken;
+        timestamps_ns += taken;
+        count -= taken;
+        if (_pending == _block_frames && !write_block()) return false;
+    }
+    return true;
+}
+
+bool CaptureWriter::write_block() {
+    CaptureFormat::BlockHeader header{};
+    header.count = _pending;
+    header.first_ns = _timestamps[0];
+    iovec parts[3] = {
+        {&header, sizeof(header)},
+        {_frames.get(), _pending * sizeof(can_frame)},
+        {_timestamps.get(), _pending * sizeof(uint64_t)}
+    };
+    if (!write_all(_fd, parts, 3)) {
+        ::close(_fd);
+        _fd = -1;
+        return false;
+    }
+    _frames_written += _pending;
+    _pending = 0;
+    return true;
+}
+
+bool CaptureWriter::flush() {
+    if (_fd < 0) return false;
+    return _pending == 0 || write_block();
+}
+
+bool CaptureWriter::close() {
+    if (_fd < 0) return true;
+    const bool flushed = flush();
+    if (_fd >= 0) ::close(_fd);
+    _fd = -1;
+    return flushed;
+}
+
+bool CaptureReader::open(const char* path) {
+    close();
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat info{};
+    if (::fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < sizeof(CaptureFormat::FileHeader)) {
+        ::close(fd);
+        return false;
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) return false;
+
+    CaptureFormat::FileHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    if (std::memcmp(header.magic, CaptureFormat::MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != CaptureFormat::VERSION ||
+        header.frame_size != sizeof(can_frame) ||
+        header.protocol > static_cast<uint32_t>(ProtocolType::MMeet) ||
+        header.block_frames == 0) {
+        ::munmap(mapping, size);
+        return false;
+    }
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+    _data = static_cast<const uint8_t*>(mapping);
+    _size = size;
+    _block_frames = header.block_frames;
+    _protocol = static_cast<ProtocolType>(header.protocol);
+    _created_ns = header.created_ns;
+    rewind();
+    return true;
+}
+
+void CaptureReader::close() {
+    if (_data) ::munmap(const_cast<uint8_t*>(_data), _size);
+    _data = nullptr;
+    _size = 0;
+    _offset = 0;
+}
+
+bool CaptureReader::next(CaptureSpan& span) {
+    if (!_data || _offset == _size) return false;
+    if (_size - _offset < sizeof(CaptureFormat::BlockHeader)) {
+        _truncated = true;
+        return false;
+    }
+
+    CaptureFormat::BlockHeader header;
+    std::memcpy(&header, _data + _offset, sizeof(header));
+    const size_t size = CaptureFormat::block_size(header.count);
+    if (header.count == 0 || header.count > _block_frames || _size - _offset < size) {
+        _truncated = true;
+        return false;
+    }
+
+    const uint8_t* frames = _data + _offset + sizeof(header);
+    span.frames = reinterpret_cast<const can_frame*>(frames);
+    span.timestamps_ns = reinterpret_cast<const uint64_t*>(frames + header.count * sizeof(can_frame));
+    span.count = header.count;
+    _offset += size;
+    return true;
+}
@@ -0,0 +1,76 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include "../include/CanFilter.h"
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <linux/can/raw.h>
+
+namespace {
+    // Response ID layout, as checked by CanParser
+    struct ResponseLayout {
+        uint32_t id;            // Fixed bits of the response ID
+        uint32_t mask;          // Which bits of id are fixed
+        uint32_t address_shift; // Position of the address bits
+        uint32_t address_mask;  // Width of the address bits, before shifting
+    };
+
+    constexpr ResponseLayout UUGREEN_RESPONSE{UUGREEN_MASK, UUGREEN_MASK, 14, 0x7F};
+    constexpr ResponseLayout MMEET_RESPONSE{MMEET_ID, MMEET_MASK, 3, 0xFF};
+    static_assert((UUGREEN_RESPONSE.address_mask << UUGREEN_RESPONSE.address_shift) == 0x1FC000, "UUgreen address bits");
+    static_assert((MMEET_RESPONSE.address_mask << MMEET_RESPONSE.address_shift) == 0x7F8, "MMeet address bits");
+
+    // Only extended data frames carry module responses
+    constexpr uint32_t FRAME_TYPE_MASK = CAN_EFF_FLAG | CAN_RTR_FLAG;
+
+    // Splits [first, end) into aligned power-of-two blocks, one filter each
+    size_t build_filters(const ResponseLayout& layout, uint32_t first, uint32_t end, can_filter* out) {
+        size_t count = 0;
+        while (first < end) {
+            uint32_t block = first ? first & -first : layout.address_mask + 1;
+            while (first + block > end) block >>= 1;
+            out[count].can_id = CAN_EFF_FLAG | layout.id | first << layout.address_shift;
+            out[count].can_mask = FRAME_TYPE_MASK | layout.mask |
+                                  (layout.address_mask & ~(block - 1)) << layout.address_shift;
+            ++count;
+            first += block;
+        }
+        return count;
+    }
+}
+
+bool CanFilterSet::add(ProtocolType protocol, uint8_t first_address, size_t count) {
+    if (first_address > UUgreenConstants::MAX_ADDRESS) return false;
+    const size_t limit = MODULE_ADDRESS_COUNT - first_address;
+    const uint32_t end = first_address + static_cast<uint32_t>(count < limit ? count : limit);
+
+    // At most two blocks per address bit
+    can_filter blocks[2 * 8];
+    size_t built = 0;
+    switch(protocol) {
+        case ProtocolType::UUgreen: built = build_filters(UUGREEN_RESPONSE, first_address, end, blocks); break;
+        case ProtocolType::MMeet: built = build_filters(MMEET_RESPONSE, first_address, end, blocks); break;
+        default: return false;
+    }
+    if (built > MAX_FILTERS - _size) return false;
+    for (size_t i = 0; i < built; ++i) _filters[_size++] = blocks[i];
+    return true;
+}
+
+bool CanFilterSet::accepts(canid_t can_id) const {
+    for (size_t i = 0; i < _size; ++i) {
+        if ((can_id & _filters[i].can_mask) == (_filters[i].can_id & _filters[i].can_mask))
+            return true;
+    }
+    return false;
+}
+
+bool CanFilterSet::install(int fd) const {
+    return ::setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, _filters.data(),
+                        static_cast<socklen_t>(_size * sizeof(can_filter))) == 0;
+}
+
+bool CanFilterSet::acceptAll(int fd) {
+    const can_filter all{0, 0};
+    return ::setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, &all, sizeof(all)) == 0;
+}
+#endif
@@ -0,0 +1,240 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include "../include/CanLogReader.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifndef CAN_ERR_FLAG
+#define CAN_ERR_FLAG 0x20000000U
+#define CAN_RTR_FLAG 0x40000000U
+#define CAN_EFF_FLAG 0x80000000U
+#define CAN_EFF_MASK 0x1FFFFFFFU
+#endif
+
+namespace {
+    constexpr uint8_t NOT_HEX = 0xFF;
+
+    constexpr std::array<uint8_t, 256> make_hex_table() {
+        std::array<uint8_t, 256> table{};
+        for (size_t c = 0; c < table.size(); ++c) table[c] = NOT_HEX;
+        for (uint8_t d = 0; d < 10; ++d) table['0' + d] = d;
+        for (uint8_t d = 0; d < 6; ++d) {
+            table['A' + d] = 10 + d;
+            table['a' + d] = 10 + d;
+        }
+        return table;
+    }
+
+    constexpr auto HEX = make_hex_table();
+
+    inline uint8_t hex_of(char c) { return HEX[static_cast<uint8_t>(c)]; }
+    inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+    inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    inline const char* skip_blanks(const char* p, const char* end) {
+        while (p < end && is_blank(*p)) ++p;
+        return p;
+    }
+
+    inline bool starts_with(const char* p, const char* end, const char* word, size_t length) {
+        return static_cast<size_t>(end - p) >= length && std::memcmp(p, word, length) == 0;
+    }
+
+    // "seconds.fraction" in microseconds, nullptr if there are no digits
+    const char* parse_timestamp(const char* p, const char* end, uint64_t& timestamp_us) {
+        const char* start = p;
+        uint64_t seconds = 0;
+        while (p < end && is_digit(*p)) seconds = seconds * 10 + (*p++ - '0');
+        if (p == start) return nullptr;
+
+        uint64_t fraction = 0;
+        unsigned digits = 0;
+        if (p < end && *p == '.') {
+            for (++p; p < end && is_digit(*p); ++p) {
+                if (digits < 6) {
+                    fraction = fraction * 10 + (*p - '0');
+                    ++digits;
+                }
+            }
+        }
+        for (; digits < 6; ++digits) fraction *= 10;
+        timestamp_us = seconds * 1000000 + fraction;
+        return p;
+    }
+
+    // Up to 8 bytes of contiguous hex pairs, nullptr if more follow
+    const char* parse_packed_data(const char* p, const char* end, can_frame& frame) {
+        uint8_t length = 0;
+        while (end - p >= 2 && length < CAN_INV_DLC) {
+            const uint8_t high = hex_of(p[0]);
+            const uint8_t low = hex_of(p[1]);
+            if ((high | low) > 0x0F) break;
+            frame.data[length++] = static_cast<uint8_t>(high << 4 | low);
+            p += 2;
+        }
+        if (p < end && hex_of(*p) != NOT_HEX) return nullptr;
+        frame.can_dlc = length;
+        return p;
+    }
+
+    // candump -l: "(seconds.usec) interface id#data", id of 3 digits (SFF) or 8 (EFF)
+    bool parse_candump(const char* p, const char* end, can_frame& frame, uint64_t& timestamp_us) {
+        if (*p != '(') return false;
+        p = parse_timestamp(p + 1, end, timestamp_us);
+        if (!p || p == end || *p != ')') return false;
+        p = skip_blanks(p + 1, end);
+        while (p < end && !is_blank(*p)) ++p;
+        p = skip_blanks(p, end);
+
+        const char* id_start = p;
+        uint32_t id = 0;
+        for (; p < end && hex_of(*p) != NOT_HEX; ++p) id = id << 4 | hex_of(*p);
+        const size_t id_length = p - id_start;
+        if (p == end || *p != '#' || (id_length != 3 && id_length != 8)) return false;
+        if (id_length == 8) {
+            if (id & CAN_ERR_FLAG) return false;
+            id = (id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+        }
+        ++p;
+        if (p < end && *p == '#') return false;    // CAN FD
+
+        frame = can_frame{};
+        frame.can_id = id;
+        if (p < end && *p == 'R') {
+            frame.can_id |= CAN_RTR_FLAG;
+            frame.can_dlc = p + 1 < end && p[1] >= '0' && p[1] <= '8' ? p[1] - '0' : 0;
+            return true;
+        }
+        return parse_packed_data(p, end, frame) != nullptr;
+    }
+
+    // ASC: "timestamp channel id[x] Rx|Tx d|r dlc data..."
+    bool parse_asc(const char* p, const char* end, can_frame& frame, uint64_t& timestamp_us, bool hex_ids) {
+        p = parse_timestamp(p, end, timestamp_us);
+        if (!p) return false;
+        p = skip_blanks(p, end);
+        const char* channel = p;
+        while (p < end && is_digit(*p)) ++p;
+        if (p == channel) return false;             // CANFD, ErrorFrame and other events
+        p = skip_blanks(p, end);
+
+        const char* id_start = p;
+        uint32_t id = 0;
+        if (hex_ids) {
+            for (; p < end && hex_of(*p) != NOT_HEX; ++p) id = id << 4 | hex_of(*p);
+        } else {
+            for (; p < end && is_digit(*p); ++p) id = id * 10 + (*p - '0');
+        }
+        if (p == id_start) return false;
+        if (p < end && *p == 'x') {
+            id = (id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+            ++p;
+        }
+        if (p == end || !is_blank(*p)) return false;
+        p = skip_blanks(p, end);
+        while (p < end && !is_blank(*p)) ++p;       // Rx or Tx
+        p = skip_blanks(p, end);
+
+        if (p == end || (*p != 'd' && *p != 'r')) return false;
+        const bool remote = *p == 'r';
+        p = skip_blanks(p + 1, end);
+
+        frame = can_frame{};
+        frame.can_id = remote ? id | CAN_RTR_FLAG : id;
+        frame.can_dlc = 0;
+        if (p < end && *p >= '0' && *p <= '8') frame.can_dlc = *p++ - '0';
+        else if (!remote) return false;
+        if (remote) return true;
+
+        for (uint8_t i = 0; i < frame.can_dlc; ++i) {
+            p = skip_blanks(p, end);
+            if (end - p < 2) return false;
+            const uint8_t high = hex_of(p[0]);
+            const uint8_t low = hex_of(p[1]);
+            if ((high | low) > 0x0F) return false;
+            frame.data[i] = static_cast<uint8_t>(high << 4 | low);
+            p += 2;
+        }
+        return true;
+    }
+}
+
+bool CanLogReader::open(const char* path) {
+    close();
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat info{};
+    if (::fstat(fd, &info) < 0) {
+        ::close(fd);
+        return false;
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+    if (size == 0) {
+        ::close(fd);
+        openBuffer("", 0);
+        return true;
+    }
+
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) return false;
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+    openBuffer(static_cast<const char*>(mapping), size);
+    _mapping = mapping;
+    _mapping_size = size;
+    return true;
+}
+
+void CanLogReader::openBuffer(const char* text, size_t size) {
+    close();
+    _begin = text;
+    _end = text + size;
+    rewind();
+}
+
+void CanLogReader::close() {
+    if (_mapping) ::munmap(_mapping, _mapping_size);
+    _mapping = nullptr;
+    _mapping_size = 0;
+    _begin = _end = _cursor = nullptr;
+}
+
+void CanLogReader::rewind() {
+    _cursor = _begin;
+    _skipped = 0;
+    _hex_ids = true;
+}
+
+size_t CanLogReader::read(can_frame* frames, size_t max_frames, uint64_t* timestamps_us) {
+    size_t count = 0;
+    uint64_t timestamp = 0;
+    while (count < max_frames && _cursor < _end) {
+        const char* newline = static_cast<const char*>(std::memchr(_cursor, '\n', _end - _cursor));
+        const char* line_end = newline ? newline : _end;
+        const char* p = skip_blanks(_cursor, line_end);
+        _cursor = newline ? newline + 1 : _end;
+        if (p == line_end) continue;
+
+        bool decoded;
+        if (_format == LogFormat::Candump || (_format == LogFormat::Auto && *p == '(')) {
+            decoded = parse_candump(p, line_end, frames[count], timestamp);
+        } else {
+            if (starts_with(p, line_end, "base ", 5)) {
+                const char* base = skip_blanks(p + 5, line_end);
+                _hex_ids = !starts_with(base, line_end, "dec", 3);
+            }
+            decoded = parse_asc(p, line_end, frames[count], timestamp, _hex_ids);
+        }
+
+        if (!decoded) {
+            ++_skipped;
+            continue;
+        }
+        if (timestamps_us) timestamps_us[count] = timestamp;
+        ++count;
+    }
+    return count;
+}
@@ -1,6 +1,63 @@
 /* MIT License Copyright (c) 2025 SmartElectroni*/
 
 #include "../libmodul.h"
+#include "../include/Metrics.h"
+
+namespace {
+    inline uint32_t load_be32(const uint8_t* bytes) {
+        return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | bytes[3];
+    }
+
+    // Result code without branching on validity or command
+    inline ParseResult classify(bool valid, uint8_t field) {
+        const unsigned known = field != ParsedData::COUNT;
+        return static_cast<ParseResult>(valid ? 1u - known : 2u);
+    }
+
+    static_assert(static_cast<unsigned>(ParseResult::OK) == 0 &&
+                  static_cast<unsigned>(ParseResult::UNKNOWN_CMD) == 1 &&
+                  static_cast<unsigned>(ParseResult::INVALID_FRAME) == 2, "ParseResult order");
+
+    static_assert(MMEET_COMMANDS[0].field == ParsedData::COUNT, "MMeet key 0 must stay unknown for parseAny");
+
+    // One masked compare per protocol: 0 none, 1 UUgreen, 2 MMeet
+    inline unsigned protocol_of(uint32_t can_id) {
+        const unsigned mmeet = (can_id & MMEET_MASK) == MMEET_ID;
+        const unsigned uugreen = (can_id & UUGREEN_MASK) == UUGREEN_MASK;
+        return mmeet ? 2u : uugreen;
+    }
+
+    // Dispatch handlers filling a compact record
+    struct RecordFiller {
+        TelemetryRecord& record;
+
+        void set(uint8_t address, ParsedData::Field field) {
+            record.address = address;
+            record.fields = static_cast<uint8_t>((1u << ParsedData::ADDR) | (1u << field));
+        }
+        void onVoltage(uint8_t address, uint32_t mv) { record.voltage_mv = mv; set(address, ParsedData::VOLTAGE); }
+        void onCurrent(uint8_t address, uint32_t ma) { record.current_ma = ma; set(address, ParsedData::CURRENT); }
+        void onTemperature(uint8_t address, int32_t mdeg) { record.temperature_mdeg = mdeg; set(address, ParsedData::TEMP); }
+        void onStatus(uint8_t address, uint32_t bits) { record.status = bits; set(address, ParsedData::STATUS); }
+        void onCapability(uint8_t address, uint32_t milli) { record.capability_milli = milli; set(address, ParsedData::CAPABILITY); }
+    };
+
+    // Decode payload into result with the command's dispatch rule
+    inline void apply_command(ParsedData& result, const CommandEntry& entry, uint32_t data) {
+        const float value = entry.is_signed
+            ? static_cast<float>(static_cast<int32_t>(data)) * entry.scale
+            : static_cast<float>(data) * entry.scale;
+
+        switch(entry.field) {
+            case ParsedData::VOLTAGE: result.voltage = value; break;
+            case ParsedData::CURRENT: result.current = value; break;
+            case ParsedData::TEMP: result.temperature = static_cast<int16_t>(value); break;
+            case ParsedData::STATUS: result.status = data; break;
+            case ParsedData::CAPABILITY: result.current_capability = value; break;
+        }
+        result.fields.set(entry.field);
+    }
+}
 
 uint32_t CanParser::extractData(const can_frame& frame, uint8_t start_byte) const {
     return (frame.can_dlc >= start_byte + 4)
@@ -17,6 +74,10 @@ std::pair<std::optional<ParsedData>, ParseResult> CanParser::parseUUgreen(can_fr
     if (!validateFrame(frame, UUGREEN_MASK, UUGREEN_MASK)) 
         return {std::nullopt, ParseResult::INVALID_FRAME};
 
+    const CommandEntry& entry = UUGREEN_COMMANDS[frame.data[1]];
+    if (entry.field == ParsedData::COUNT)
+        return {std::nullopt, ParseResult::UNKNOWN_CMD};
+
     ParsedData result;
 
     frame.data[2] = 0;
@@ -25,32 +86,7 @@ std::pair<std::optional<ParsedData>, ParseResult> CanParser::parseUUgreen(can_fr
     result.address = (frame.can_id & 0x1FC000) >> 14;
     result.fields.set(ParsedData::ADDR);
 
-    const uint32_t data = extractData(frame);
-
-    switch(frame.data[1]) {
-        case 0x00: case 0x62: 
-            result.voltage = data * 0.001f;
-            result.fields.set(ParsedData::VOLTAGE);
-            break;
-        case 0x01: case 0x30:
-            result.current = data * 0.001f;
-            result.fields.set(ParsedData::CURRENT);
-            break;
-        case 0x08:
-            result.status = data;
-            result.fields.set(ParsedData::STATUS);
-            break;
-        case 0x1E:
-            result.temperature = static_cast<int16_t>(data * 0.001f);
-            result.fields.set(ParsedData::TEMP);
-            break;
-        case 0x68:
-            result.current_capability = data * 0.001f;
-            result.fields.set(ParsedData::CAPABILITY);
-            break;
-        default:
-            return {std::nullopt, ParseResult::UNKNOWN_CMD};
-    }
+    apply_command(result, entry, extractData(frame));
     return {result, ParseResult::OK};
 }
 
@@ -58,46 +94,182 @@ std::pair<std::optional<ParsedData>, ParseResult> CanParser::parseUUgreen(can_fr
 std::pair<std::optional<ParsedData>, ParseResult> CanParser::parseMMeet(can_frame frame){
     if (!validateFrame(frame, MMEET_MASK, MMEET_ID)) 
         return {std::nullopt, ParseResult::INVALID_FRAME};
-    
+
+    if (frame.data[2] != MMEET_TELEMETRY_CMD_HIGH)
+        return {std::nullopt, ParseResult::UNKNOWN_CMD};
+
+    const CommandEntry& entry = MMEET_COMMANDS[frame.data[3]];
+    if (entry.field == ParsedData::COUNT)
+        return {std::nullopt, ParseResult::UNKNOWN_CMD};
+
     ParsedData result;
     result.address = (frame.can_id & 0x7F8) >> 3;
     result.fields.set(ParsedData::ADDR);
 
-    const uint32_t data = extractData(frame);
-    const uint16_t command = (frame.data[2] << 8) | frame.data[3];
-
-    switch(command) {
-        case 0x0231:
-            result.voltage = data * 0.001f;
-            result.fields.set(ParsedData::VOLTAGE);
-            break;
-        case 0x0232:
-            result.current = data * 0.001f;
-            result.fields.set(ParsedData::CURRENT);
-            break;
-        case 0x0218:
-            result.status = data;
-            result.fields.set(ParsedData::STATUS);
-            break;
-        case 0x020B:
-            result.temperature = static_cast<int16_t>(data * 0.1f);
-            result.fields.set(ParsedData::TEMP);
-            break;
-        case 0x0235:
-            result.current_capability = static_cast<float>(data * 0.1f);
-            result.fields.set(ParsedData::CAPABILITY);
-            break;
-        default:
-            return {std::nullopt, ParseResult::UNKNOWN_CMD};
-    }
+    apply_command(result, entry, extractData(frame));
     return {result, ParseResult::OK};
 }
 
 std::pair<std::optional<ParsedData>, ParseResult> CanParser::parse(can_frame frame, ProtocolType protocol) {
+    std::pair<std::optional<ParsedData>, ParseResult> parsed;
     switch(protocol) {
-        case ProtocolType::UUgreen: return parseUUgreen(std::move(frame));
-        case ProtocolType::MMeet: return parseMMeet(std::move(frame));
+        case ProtocolType::UUgreen: parsed = parseUUgreen(frame); break;
+        case ProtocolType::MMeet: parsed = parseMMeet(frame); break;
         // Add other protocols...
         default: return {std::nullopt, ParseResult::INVALID_FRAME};
     }
-}
\ No newline at end of file
+    Metrics::FrameCounter(protocol).add(parsed.second, Metrics::command_key(protocol, frame));
+    return parsed;
+}
+
+#ifdef LIBMODUL_METRICS
+void CanParser::count_frame(ProtocolType protocol, ParseResult result, const can_frame& frame) {
+    Metrics::FrameCounter(protocol).add(result, Metrics::command_key(protocol, frame));
+}
+#endif
+
+std::optional<ProtocolType> CanParser::detectProtocol(const can_frame& frame) {
+    switch(protocol_of(frame.can_id)) {
+        case 1: return ProtocolType::UUgreen;
+        case 2: return ProtocolType::MMeet;
+        default: return std::nullopt;
+    }
+}
+
+std::tuple<std::optional<ParsedData>, ParseResult, std::optional<ProtocolType>> CanParser::parseAny(can_frame frame) {
+    // The protocol is known here, so only the DLC and command remain to check
+    const unsigned protocol = protocol_of(frame.can_id);
+    if (protocol == 0)
+        return {std::nullopt, ParseResult::INVALID_FRAME, std::nullopt};
+
+    const bool mmeet = protocol == 2;
+    const ProtocolType type = mmeet ? ProtocolType::MMeet : ProtocolType::UUgreen;
+    Metrics::FrameCounter metrics(type);
+    if (frame.can_dlc != CAN_INV_DLC) {
+        metrics.add(ParseResult::INVALID_FRAME, 0);
+        return {std::nullopt, ParseResult::INVALID_FRAME, type};
+    }
+
+    const uint8_t key = Metrics::command_key(type, frame);
+    const CommandEntry& entry = (mmeet ? MMEET_COMMANDS : UUGREEN_COMMANDS)[key];
+    if (entry.field == ParsedData::COUNT) {
+        metrics.add(ParseResult::UNKNOWN_CMD, key);
+        return {std::nullopt, ParseResult::UNKNOWN_CMD, type};
+    }
+    metrics.add(ParseResult::OK, key);
+
+    std::tuple<std::optional<ParsedData>, ParseResult, std::optional<ProtocolType>> parsed{
+        std::in_place, ParseResult::OK, type};
+    ParsedData& result = *std::get<0>(parsed);
+    result.address = mmeet ? (frame.can_id & 0x7F8) >> 3 : (frame.can_id & 0x1FC000) >> 14;
+    result.fields.set(ParsedData::ADDR);
+    apply_command(result, entry, load_be32(frame.data + 4));
+    return parsed;
+}
+
+size_t CanParser::parseBatchUUgreen(const can_frame* frames, size_t count, const ParsedBatch& out) const {
+    Metrics::FrameCounter metrics(ProtocolType::UUgreen);
+    size_t parsed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const can_frame& frame = frames[i];
+        const bool valid = validateFrame(frame, UUGREEN_MASK, UUGREEN_MASK);
+        const uint8_t field = valid ? UUGREEN_COMMANDS[frame.data[1]].field : uint8_t(ParsedData::COUNT);
+        const ParseResult result = classify(valid, field);
+        const uint32_t keep = result == ParseResult::OK ? ~0u : 0u;
+
+        out.address[i] = static_cast<uint8_t>(((frame.can_id & 0x1FC000) >> 14) & keep);
+        out.field[i] = field;
+        out.raw[i] = load_be32(frame.data + 4) & keep;
+        out.result[i] = result;
+        parsed += result == ParseResult::OK;
+        metrics.add(result, frame.data[1]);
+    }
+    return parsed;
+}
+
+size_t CanParser::parseBatchMMeet(const can_frame* frames, size_t count, const ParsedBatch& out) const {
+    Metrics::FrameCounter metrics(ProtocolType::MMeet);
+    size_t parsed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const can_frame& frame = frames[i];
+        const bool valid = validateFrame(frame, MMEET_MASK, MMEET_ID);
+        const bool telemetry = frame.data[2] == MMEET_TELEMETRY_CMD_HIGH;
+        const uint8_t field = (valid && telemetry) ? MMEET_COMMANDS[frame.data[3]].field : uint8_t(ParsedData::COUNT);
+        const ParseResult result = classify(valid, field);
+        const uint32_t keep = result == ParseResult::OK ? ~0u : 0u;
+
+        out.address[i] = static_cast<uint8_t>(((frame.can_id & 0x7F8) >> 3) & keep);
+        out.field[i] = field;
+        out.raw[i] = load_be32(frame.data + 4) & keep;
+        out.result[i] = result;
+        parsed += result == ParseResult::OK;
+        metrics.add(result, telemetry ? frame.data[3] : 0);
+    }
+    return parsed;
+}
+
+size_t CanParser::parseBatch(const can_frame* frames, size_t count, ProtocolType protocol, const ParsedBatch& out) const {
+    Metrics::BatchTimer timer(count);
+    switch(protocol) {
+        case ProtocolType::UUgreen: return parseBatchUUgreen(frames, count, out);
+        case ProtocolType::MMeet: return parseBatchMMeet(frames, count, out);
+        // Add other protocols...
+        default:
+            for (size_t i = 0; i < count; ++i) {
+                out.address[i] = 0;
+                out.field[i] = ParsedData::COUNT;
+                out.raw[i] = 0;
+                out.result[i] = ParseResult::INVALID_FRAME;
+            }
+            return 0;
+    }
+}
+
+ProtocolSplit CanParser::splitByProtocol(const can_frame* frames, size_t count, can_frame* uugreen, can_frame* mmeet) const {
+    size_t uugreen_count = 0, mmeet_count = 0;
+    for (size_t i = 0; i < count; ++i) {
+        // Write to both spans and advance only the matching one
+        const unsigned protocol = protocol_of(frames[i].can_id);
+        uugreen[uugreen_count] = frames[i];
+        mmeet[mmeet_count] = frames[i];
+        uugreen_count += protocol == 1;
+        mmeet_count += protocol == 2;
+    }
+    return {uugreen_count, mmeet_count, count - uugreen_count - mmeet_count};
+}
+
+std::pair<std::optional<TelemetryRecord>, ParseResult> CanParser::parseRecord(const can_frame& frame, ProtocolType protocol) const {
+    TelemetryRecord record;
+    RecordFiller filler{record};
+    ParseResult result = ParseResult::INVALID_FRAME;
+    switch(protocol) {
+        case ProtocolType::UUgreen: result = dispatch_frame<ProtocolType::UUgreen>(frame, filler); break;
+        case ProtocolType::MMeet: result = dispatch_frame<ProtocolType::MMeet>(frame, filler); break;
+        // Add other protocols...
+        default: return {std::nullopt, result};
+    }
+    Metrics::FrameCounter(protocol).add(result, Metrics::command_key(protocol, frame));
+    if (result != ParseResult::OK)
+        return {std::nullopt, result};
+    return {record, result};
+}
+
+size_t CanParser::parseRecords(const can_frame* frames, size_t count, ProtocolType protocol, TelemetryRecord* records) const {
+    Metrics::BatchTimer timer(count);
+    Metrics::FrameCounter metrics(protocol);
+    size_t parsed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        records[i] = TelemetryRecord{};
+        RecordFiller filler{records[i]};
+        ParseResult result;
+        switch(protocol) {
+            case ProtocolType::UUgreen: result = dispatch_frame<ProtocolType::UUgreen>(frames[i], filler); break;
+            case ProtocolType::MMeet: result = dispatch_frame<ProtocolType::MMeet>(frames[i], filler); break;
+            // Add other protocols...
+            default: continue;
+        }
+        parsed += result == ParseResult::OK;
+        metrics.add(result, Metrics::command_key(protocol, frames[i]));
+    }
+    return parsed;
+}
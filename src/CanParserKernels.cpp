@@ -0,0 +1,313 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include "../libmodul.h"
+#include "../include/Metrics.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(__APPLE__) && defined(__GNUC__)
+    #define LIBMODUL_X86_KERNELS 1
+    #include <immintrin.h>
+    #include <cstddef>
+#endif
+
+namespace {
+    /**
+     * @brief Where a protocol keeps the fields the decoder needs
+     *
+     * Both the command key and the optional command high byte live in
+     * data[0..3], so the vector kernels read them from a single dword.
+     */
+    struct DecodeLayout {
+        uint32_t id_mask;           // Mask for protocol check
+        uint32_t id_expected;       // Expected masked CAN ID
+        uint32_t address_mask;      // Address bits of the CAN ID
+        unsigned address_shift;     // Address position in the CAN ID
+        unsigned key_shift;         // Bit offset of the table key in data[0..3]
+        unsigned high_shift;        // Bit offset of the required high byte in data[0..3]
+        uint32_t high_mask;         // 0 when the protocol has no high byte
+        uint32_t high_value;        // Required high byte value
+        const CommandEntry* table;  // Dispatch table
+    };
+
+    const DecodeLayout UUGREEN_LAYOUT = {
+        UUGREEN_MASK, UUGREEN_MASK, 0x1FC000, 14, 8, 0, 0, 0, UUGREEN_COMMANDS.data()
+    };
+
+    const DecodeLayout MMEET_LAYOUT = {
+        MMEET_MASK, MMEET_ID, 0x7F8, 3, 24, 16, 0xFF, MMEET_TELEMETRY_CMD_HIGH, MMEET_COMMANDS.data()
+    };
+
+    static_assert(static_cast<int>(ParseResult::OK) == 0 &&
+                  static_cast<int>(ParseResult::UNKNOWN_CMD) == 1 &&
+                  static_cast<int>(ParseResult::INVALID_FRAME) == 2, "ParseResult order");
+
+    inline uint32_t load_le32(const uint8_t* bytes) {
+        return uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) | (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24);
+    }
+
+    size_t decode_scalar(const can_frame* frames, size_t count, const DecodeLayout& layout, const ParsedBatch& out) {
+        size_t parsed = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const can_frame& frame = frames[i];
+            const bool valid = (frame.can_id & layout.id_mask) == layout.id_expected && frame.can_dlc == CAN_INV_DLC;
+            const uint32_t head = load_le32(frame.data);
+            const bool telemetry = ((head >> layout.high_shift) & layout.high_mask) == layout.high_value;
+            const CommandEntry& entry = layout.table[(head >> layout.key_shift) & 0xFF];
+
+            const uint8_t field = (valid && telemetry) ? entry.field : uint8_t(ParsedData::COUNT);
+            const bool ok = valid && field != ParsedData::COUNT;
+            const ParseResult result = ok ? ParseResult::OK : (valid ? ParseResult::UNKNOWN_CMD : ParseResult::INVALID_FRAME);
+
+            const uint32_t raw = ok ? (uint32_t(frame.data[4]) << 24) | (uint32_t(frame.data[5]) << 16)
+                                      | (uint32_t(frame.data[6]) << 8) | frame.data[7]
+                                    : 0;
+            const float value = entry.is_signed
+                ? static_cast<float>(static_cast<int32_t>(raw)) * entry.scale
+                : static_cast<float>(raw) * entry.scale;
+
+            out.address[i] = ok ? static_cast<uint8_t>((frame.can_id & layout.address_mask) >> layout.address_shift) : 0;
+            out.field[i] = field;
+            out.raw[i] = raw;
+            out.value[i] = ok ? value : 0.0f;
+            out.result[i] = result;
+            parsed += ok;
+        }
+        return parsed;
+    }
+
+#ifdef LIBMODUL_X86_KERNELS
+    static_assert(sizeof(can_frame) == 16 && offsetof(can_frame, data) == 8, "Linux can_frame layout");
+    static_assert(sizeof(CommandEntry) == 8 && offsetof(CommandEntry, scale) == 4, "CommandEntry layout");
+    static_assert(sizeof(ParseResult) == sizeof(int32_t), "ParseResult stored as int32");
+
+    /**
+     * @brief Per-lane decode of 4 frames already transposed into dword columns
+     * @param ids CAN IDs
+     * @param heads data[0..3] (little-endian dwords)
+     * @param tails data[4..7] (little-endian dwords)
+     * @param dlcs Dword holding can_dlc in its low byte
+     */
+    __attribute__((target("sse4.1")))
+    size_t decode_block_sse4(__m128i ids, __m128i dlcs, __m128i heads, __m128i tails,
+                             const DecodeLayout& layout, const ParsedBatch& out, size_t i) {
+        const __m128i byte_mask = _mm_set1_epi32(0xFF);
+        const __m128i count_field = _mm_set1_epi32(ParsedData::COUNT);
+
+        const __m128i id_ok = _mm_cmpeq_epi32(_mm_and_si128(ids, _mm_set1_epi32(int(layout.id_mask))),
+                                              _mm_set1_epi32(int(layout.id_expected)));
+        const __m128i dlc_ok = _mm_cmpeq_epi32(_mm_and_si128(dlcs, byte_mask), _mm_set1_epi32(CAN_INV_DLC));
+        const __m128i valid = _mm_and_si128(id_ok, dlc_ok);
+        const __m128i telemetry = _mm_cmpeq_epi32(
+            _mm_and_si128(_mm_srl_epi32(heads, _mm_cvtsi32_si128(int(layout.high_shift))), _mm_set1_epi32(int(layout.high_mask))),
+            _mm_set1_epi32(int(layout.high_value)));
+        const __m128i keys = _mm_and_si128(_mm_srl_epi32(heads, _mm_cvtsi32_si128(int(layout.key_shift))), byte_mask);
+
+        // No gather before AVX2: fetch the four dispatch entries directly
+        const CommandEntry& e0 = layout.table[_mm_extract_epi32(keys, 0)];
+        const CommandEntry& e1 = layout.table[_mm_extract_epi32(keys, 1)];
+        const CommandEntry& e2 = layout.table[_mm_extract_epi32(keys, 2)];
+        const CommandEntry& e3 = layout.table[_mm_extract_epi32(keys, 3)];
+        const __m128i fields_raw = _mm_setr_epi32(e0.field, e1.field, e2.field, e3.field);
+        const __m128i is_signed = _mm_sub_epi32(_mm_setzero_si128(),
+                                                _mm_setr_epi32(e0.is_signed, e1.is_signed, e2.is_signed, e3.is_signed));
+        const __m128 scales = _mm_setr_ps(e0.scale, e1.scale, e2.scale, e3.scale);
+
+        const __m128i routed = _mm_and_si128(valid, telemetry);
+        const __m128i fields = _mm_blendv_epi8(count_field, fields_raw, routed);
+        const __m128i ok = _mm_andnot_si128(_mm_cmpeq_epi32(fields, count_field), valid);
+
+        // Result: INVALID_FRAME (2) + 1 if valid + 1 if known
+        const __m128i result = _mm_add_epi32(_mm_set1_epi32(2), _mm_add_epi32(valid, ok));
+
+        const __m128i bswap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        const __m128i raw = _mm_and_si128(_mm_shuffle_epi8(tails, bswap), ok);
+
+        // Exact uint32 -> float: both halves convert exactly, the sum rounds once
+        const __m128 hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(raw, 16)), _mm_set1_ps(65536.0f));
+        const __m128 unsigned_value = _mm_add_ps(hi, _mm_cvtepi32_ps(_mm_and_si128(raw, _mm_set1_epi32(0xFFFF))));
+        const __m128 signed_value = _mm_cvtepi32_ps(raw);
+        const __m128 value = _mm_mul_ps(_mm_blendv_ps(unsigned_value, signed_value, _mm_castsi128_ps(is_signed)), scales);
+
+        const __m128i address = _mm_and_si128(
+            _mm_srl_epi32(_mm_and_si128(ids, _mm_set1_epi32(int(layout.address_mask))), _mm_cvtsi32_si128(int(layout.address_shift))),
+            ok);
+
+        const __m128i address8 = _mm_packus_epi16(_mm_packus_epi32(address, address), _mm_setzero_si128());
+        const __m128i fields8 = _mm_packus_epi16(_mm_packus_epi32(fields, fields), _mm_setzero_si128());
+        const uint32_t address_bytes = static_cast<uint32_t>(_mm_cvtsi128_si32(address8));
+        const uint32_t field_bytes = static_cast<uint32_t>(_mm_cvtsi128_si32(fields8));
+        std::memcpy(out.address + i, &address_bytes, 4);
+        std::memcpy(out.field + i, &field_bytes, 4);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out.raw + i), raw);
+        _mm_storeu_ps(out.value + i, _mm_and_ps(value, _mm_castsi128_ps(ok)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out.result + i), result);
+
+        return static_cast<size_t>(__builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(ok))));
+    }
+
+    __attribute__((target("sse4.1")))
+    size_t decode_sse4(const can_frame* frames, size_t count, const DecodeLayout& layout, const ParsedBatch& out) {
+        size_t parsed = 0;
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128i f0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frames + i));
+            const __m128i f1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frames + i + 1));
+            const __m128i f2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frames + i + 2));
+            const __m128i f3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frames + i + 3));
+
+            // 4x4 dword transpose: columns are id, dlc, data[0..3], data[4..7]
+            const __m128i lo01 = _mm_unpacklo_epi32(f0, f1);
+            const __m128i lo23 = _mm_unpacklo_epi32(f2, f3);
+            const __m128i hi01 = _mm_unpackhi_epi32(f0, f1);
+            const __m128i hi23 = _mm_unpackhi_epi32(f2, f3);
+
+            parsed += decode_block_sse4(_mm_unpacklo_epi64(lo01, lo23), _mm_unpackhi_epi64(lo01, lo23),
+                                        _mm_unpacklo_epi64(hi01, hi23), _mm_unpackhi_epi64(hi01, hi23),
+                                        layout, out, i);
+        }
+        const ParsedBatch tail{out.address + i, out.field + i, out.raw + i, out.result + i, out.value + i};
+        return parsed + decode_scalar(frames + i, count - i, layout, tail);
+    }
+
+    __attribute__((target("avx2")))
+    size_t decode_avx2(const can_frame* frames, size_t count, const DecodeLayout& layout, const ParsedBatch& out) {
+        const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+        const __m256i count_field = _mm256_set1_epi32(ParsedData::COUNT);
+        const __m256i id_mask = _mm256_set1_epi32(int(layout.id_mask));
+        const __m256i id_expected = _mm256_set1_epi32(int(layout.id_expected));
+        const __m256i dlc = _mm256_set1_epi32(CAN_INV_DLC);
+        const __m256i high_mask = _mm256_set1_epi32(int(layout.high_mask));
+        const __m256i high_value = _mm256_set1_epi32(int(layout.high_value));
+        const __m256i address_mask = _mm256_set1_epi32(int(layout.address_mask));
+        const __m128i high_shift = _mm_cvtsi32_si128(int(layout.high_shift));
+        const __m128i key_shift = _mm_cvtsi32_si128(int(layout.key_shift));
+        const __m128i address_shift = _mm_cvtsi32_si128(int(layout.address_shift));
+        const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                               3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        // Unpacking across two-frame registers yields frames 0,2,4,6,1,3,5,7
+        const __m256i restore_order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        const int* table_words = reinterpret_cast<const int*>(layout.table);
+        const float* table_scales = &layout.table[0].scale;
+
+        size_t parsed = 0;
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256i f01 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frames + i));
+            const __m256i f23 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frames + i + 2));
+            const __m256i f45 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frames + i + 4));
+            const __m256i f67 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frames + i + 6));
+
+            const __m256i lo_a = _mm256_unpacklo_epi32(f01, f23);
+            const __m256i lo_b = _mm256_unpacklo_epi32(f45, f67);
+            const __m256i hi_a = _mm256_unpackhi_epi32(f01, f23);
+            const __m256i hi_b = _mm256_unpackhi_epi32(f45, f67);
+
+            const __m256i ids = _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(lo_a, lo_b), restore_order);
+            const __m256i dlcs = _mm256_permutevar8x32_epi32(_mm256_unpackhi_epi64(lo_a, lo_b), restore_order);
+            const __m256i heads = _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(hi_a, hi_b), restore_order);
+            const __m256i tails = _mm256_permutevar8x32_epi32(_mm256_unpackhi_epi64(hi_a, hi_b), restore_order);
+
+            const __m256i valid = _mm256_and_si256(
+                _mm256_cmpeq_epi32(_mm256_and_si256(ids, id_mask), id_expected),
+                _mm256_cmpeq_epi32(_mm256_and_si256(dlcs, byte_mask), dlc));
+            const __m256i telemetry = _mm256_cmpeq_epi32(
+                _mm256_and_si256(_mm256_srl_epi32(heads, high_shift), high_mask), high_value);
+            const __m256i keys = _mm256_and_si256(_mm256_srl_epi32(heads, key_shift), byte_mask);
+
+            // CommandEntry is 8 bytes: gather {field, is_signed} words and scales by key
+            const __m256i words = _mm256_i32gather_epi32(table_words, keys, 8);
+            const __m256 scales = _mm256_i32gather_ps(table_scales, keys, 8);
+            const __m256i is_signed = _mm256_sub_epi32(_mm256_setzero_si256(),
+                                                       _mm256_and_si256(_mm256_srli_epi32(words, 8), byte_mask));
+
+            const __m256i fields = _mm256_blendv_epi8(count_field, _mm256_and_si256(words, byte_mask),
+                                                      _mm256_and_si256(valid, telemetry));
+            const __m256i ok = _mm256_andnot_si256(_mm256_cmpeq_epi32(fields, count_field), valid);
+            const __m256i result = _mm256_add_epi32(_mm256_set1_epi32(2), _mm256_add_epi32(valid, ok));
+
+            const __m256i raw = _mm256_and_si256(_mm256_shuffle_epi8(tails, bswap), ok);
+            const __m256 hi = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(raw, 16)), _mm256_set1_ps(65536.0f));
+            const __m256 unsigned_value = _mm256_add_ps(hi, _mm256_cvtepi32_ps(_mm256_and_si256(raw, _mm256_set1_epi32(0xFFFF))));
+            const __m256 signed_value = _mm256_cvtepi32_ps(raw);
+            const __m256 value = _mm256_mul_ps(_mm256_blendv_ps(unsigned_value, signed_value, _mm256_castsi256_ps(is_signed)),
+                                               scales);
+
+            const __m256i address = _mm256_and_si256(_mm256_srl_epi32(_mm256_and_si256(ids, address_mask), address_shift), ok);
+
+            const __m128i address16 = _mm_packus_epi32(_mm256_castsi256_si128(address), _mm256_extracti128_si256(address, 1));
+            const __m128i fields16 = _mm_packus_epi32(_mm256_castsi256_si128(fields), _mm256_extracti128_si256(fields, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out.address + i), _mm_packus_epi16(address16, address16));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out.field + i), _mm_packus_epi16(fields16, fields16));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.raw + i), raw);
+            _mm256_storeu_ps(out.value + i, _mm256_and_ps(value, _mm256_castsi256_ps(ok)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.result + i), result);
+
+            parsed += static_cast<size_t>(__builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(ok))));
+        }
+        const ParsedBatch tail{out.address + i, out.field + i, out.raw + i, out.result + i, out.value + i};
+        return parsed + decode_scalar(frames + i, count - i, layout, tail);
+    }
+#endif
+
+    DecodeKernel detect_decode_kernel() {
+#ifdef LIBMODUL_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return DecodeKernel::AVX2;
+        if (__builtin_cpu_supports("sse4.1")) return DecodeKernel::SSE4;
+#endif
+        return DecodeKernel::Scalar;
+    }
+}
+
+bool CanParser::isDecodeKernelSupported(DecodeKernel kernel) {
+    switch(kernel) {
+        case DecodeKernel::Scalar: return true;
+        case DecodeKernel::SSE4: return bestDecodeKernel() != DecodeKernel::Scalar;
+        case DecodeKernel::AVX2: return bestDecodeKernel() == DecodeKernel::AVX2;
+        default: return false;
+    }
+}
+
+DecodeKernel CanParser::bestDecodeKernel() {
+    static const DecodeKernel best = detect_decode_kernel();
+    return best;
+}
+
+size_t CanParser::decodeBatch(const can_frame* frames, size_t count, ProtocolType protocol, const ParsedBatch& out) const {
+    return decodeBatch(frames, count, protocol, out, bestDecodeKernel());
+}
+
+size_t CanParser::decodeBatch(const can_frame* frames, size_t count, ProtocolType protocol, const ParsedBatch& out,
+                              DecodeKernel kernel) const {
+    const DecodeLayout* layout = nullptr;
+    switch(protocol) {
+        case ProtocolType::UUgreen: layout = &UUGREEN_LAYOUT; break;
+        case ProtocolType::MMeet: layout = &MMEET_LAYOUT; break;
+        // Add other protocols...
+        default:
+            for (size_t i = 0; i < count; ++i) {
+                out.address[i] = 0;
+                out.field[i] = ParsedData::COUNT;
+                out.raw[i] = 0;
+                out.value[i] = 0.0f;
+                out.result[i] = ParseResult::INVALID_FRAME;
+            }
+            return 0;
+    }
+
+    Metrics::BatchTimer timer(count);
+    if (!isDecodeKernelSupported(kernel)) kernel = DecodeKernel::Scalar;
+    size_t parsed;
+    switch(kernel) {
+#ifdef LIBMODUL_X86_KERNELS
+        case DecodeKernel::AVX2: parsed = decode_avx2(frames, count, *layout, out); break;
+        case DecodeKernel::SSE4: parsed = decode_sse4(frames, count, *layout, out); break;
+#endif
+        default: parsed = decode_scalar(frames, count, *layout, out); break;
+    }
+
+    // The vector kernels stay branch-free, outcomes are counted in a second pass
+    if constexpr (Metrics::ENABLED) {
+        Metrics::FrameCounter metrics(protocol);
+        for (size_t i = 0; i < count; ++i) metrics.add(out.result[i], Metrics::command_key(protocol, frames[i]));
+    }
+    return parsed;
+}
@@ -0,0 +1,292 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include "../include/CanTransport.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/can/raw.h>
+
+namespace {
+    constexpr size_t RX_BURST = CanTransport::BURST_CAPACITY;   // Frames moved per RX queue push
+    constexpr int MAX_EVENTS = 4;
+
+    inline void signal_event(int fd) {
+        const uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = ::write(fd, &one, sizeof(one));
+    }
+
+    inline void clear_event(int fd) {
+        uint64_t value;
+        [[maybe_unused]] ssize_t bytes = ::read(fd, &value, sizeof(value));
+    }
+}
+
+CanTransport::CanTransport(int fd, IoMode mode) : _fd(fd), _mode(mode) {
+    if (_fd < 0) return;
+    ::fcntl(_fd, F_SETFL, ::fcntl(_fd, F_GETFL) | O_NONBLOCK);
+    _epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    _tx_event = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    _rx_event = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_epoll_fd < 0 || _tx_event < 0 || _rx_event < 0) return;
+
+    epoll_event socket_event{};
+    socket_event.events = EPOLLIN;
+    socket_event.data.fd = _fd;
+    epoll_event wakeup_event{};
+    wakeup_event.events = EPOLLIN;
+    wakeup_event.data.fd = _tx_event;
+    ::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _fd, &socket_event);
+    ::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _tx_event, &wakeup_event);
+}
+
+CanTransport::~CanTransport() {
+    stop();
+    for (int fd : {_rx_event, _tx_event, _epoll_fd, _fd}) {
+        if (fd >= 0) ::close(fd);
+    }
+}
+
+std::unique_ptr<CanTransport> CanTransport::open(const char* interface, IoMode mode) {
+    const int fd = ::socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+    if (fd < 0) return nullptr;
+
+    ifreq ifr{};
+    std::strncpy(ifr.ifr_name, interface, IFNAMSIZ - 1);
+    sockaddr_can addr{};
+    addr.can_family = AF_CAN;
+    if (::ioctl(fd, SIOCGIFINDEX, &ifr) < 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    return std::make_unique<CanTransport>(fd, mode);
+}
+
+bool CanTransport::start(int cpu) {
+    if (_fd < 0 || _epoll_fd < 0 || _tx_event < 0 || _rx_event < 0) return false;
+    if (cpu >= CPU_SETSIZE) return false;
+    if (_running.exchange(true, std::memory_order_acq_rel)) return false;
+    _thread = std::thread(&CanTransport::run, this);
+    if (cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        if (::pthread_setaffinity_np(_thread.native_handle(), sizeof(cpus), &cpus) != 0) {
+            stop();
+            return false;
+        }
+    }
+    return true;
+}
+
+void CanTransport::stop() {
+    if (!_running.exchange(false, std::memory_order_acq_rel)) return;
+    signal_event(_tx_event);
+    if (_thread.joinable()) _thread.join();
+}
+
+size_t CanTransport::send(const can_frame* frames, size_t count) {
+    const size_t queued = _tx_queue.push(frames, count);
+    // Only the first producer after the I/O thread's last flush pays for the wakeup
+    if (queued && !_tx_signalled.exchange(true, std::memory_order_acq_rel))
+        signal_event(_tx_event);
+    return queued;
+}
+
+bool CanTransport::wait_rx(int timeout_ms) {
+    pollfd event{_rx_event, POLLIN, 0};
+    if (::poll(&event, 1, timeout_ms) <= 0) return false;
+    clear_event(_rx_event);
+    return true;
+}
+
+size_t CanTransport::receive(can_frame* frames, size_t max_frames, int timeout_ms) {
+    size_t received = _rx_queue.pop(frames, max_frames);
+    if (received || timeout_ms == 0 || max_frames == 0) return received;
+
+    // The eventfd may hold a count from frames already taken: loop until the deadline
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (true) {
+        int remaining = -1;
+        if (timeout_ms > 0) {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0) return _rx_queue.pop(frames, max_frames);
+            remaining = static_cast<int>(left);
+        }
+        wait_rx(remaining);
+        received = _rx_queue.pop(frames, max_frames);
+        if (received) return received;
+    }
+}
+
+size_t CanTransport::receiveRecords(const CanParser& parser, ProtocolType protocol,
+                                    TelemetryRecord* records, size_t max_records, int timeout_ms) {
+    can_frame frames[RX_BURST];
+    size_t taken = 0;
+    while (taken < max_records) {
+        const size_t chunk = max_records - taken < RX_BURST ? max_records - taken : RX_BURST;
+        const size_t received = receive(frames, chunk, taken ? 0 : timeout_ms);
+        if (!received) break;
+        parser.parseRecords(frames, received, protocol, records + taken);
+        taken += received;
+    }
+    return taken;
+}
+
+CanTransport::Stats CanTransport::stats() const {
+    Stats stats;
+    stats.rx_frames = _rx_frames.load(std::memory_order_relaxed);
+    stats.tx_frames = _tx_frames.load(std::memory_order_relaxed);
+    stats.rx_dropped = _rx_dropped.load(std::memory_order_relaxed);
+    stats.tx_errors = _tx_errors.load(std::memory_order_relaxed);
+    stats.wakeups = _wakeups.load(std::memory_order_relaxed);
+    stats.syscalls = _syscalls.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void CanTransport::update_interest(bool want_writable) {
+    if (want_writable == _want_writable) return;
+    epoll_event socket_event{};
+    socket_event.events = EPOLLIN | (want_writable ? EPOLLOUT : 0u);
+    socket_event.data.fd = _fd;
+    ::epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, _fd, &socket_event);
+    _want_writable = want_writable;
+}
+
+void CanTransport::deliver(const can_frame* frames, size_t count) {
+    _rx_frames.fetch_add(count, std::memory_order_relaxed);
+    if (_rx_handler) {
+        _rx_handler(frames, count);
+        return;
+    }
+    const size_t pushed = _rx_queue.push(frames, count);
+    if (pushed < count) _rx_dropped.fetch_add(count - pushed, std::memory_order_relaxed);
+    signal_event(_rx_event);
+}
+
+void CanTransport::drain_socket() {
+    can_frame frames[RX_BURST];
+    while (true) {
+        size_t count = 0;
+        while (count < RX_BURST) {
+            const ssize_t bytes = ::read(_fd, &frames[count], sizeof(can_frame));
+            _syscalls.fetch_add(1, std::memory_order_relaxed);
+            if (bytes != static_cast<ssize_t>(sizeof(can_frame))) break;
+            ++count;
+        }
+        if (!count) return;
+
+        deliver(frames, count);
+        if (count < RX_BURST) return;
+    }
+}
+
+void CanTransport::drain_socket_batched() {
+    while (true) {
+        const int received = _rx_burst.receive(_fd);
+        _syscalls.fetch_add(1, std::memory_order_relaxed);
+        if (received <= 0) return;
+
+        const size_t count = static_cast<size_t>(received);
+        deliver(_rx_burst.frames(), count);
+        if (count < _rx_burst.capacity()) return;
+    }
+}
+
+bool CanTransport::flush_tx_batched() {
+    while (true) {
+        if (_tx_sent == _tx_burst.size()) {
+            _tx_burst.resize(_tx_queue.pop(_tx_burst.frames(), _tx_burst.capacity()));
+            _tx_sent = 0;
+            if (!_tx_burst.size()) return true;
+        }
+        const int sent = _tx_burst.send(_fd, _tx_sent);
+        _syscalls.fetch_add(1, std::memory_order_relaxed);
+        if (sent > 0) {
+            _tx_sent += static_cast<size_t>(sent);
+            _tx_frames.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+            return false;   // Retry the rest on EPOLLOUT
+        } else {
+            ++_tx_sent;     // sendmmsg failed on the first frame: drop it
+            _tx_errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool CanTransport::flush_tx() {
+    while (true) {
+        if (!_tx_pending) {
+            if (!_tx_queue.pop(_tx_frame)) return true;
+            _tx_pending = true;
+        }
+        const ssize_t bytes = ::write(_fd, &_tx_frame, sizeof(can_frame));
+        _syscalls.fetch_add(1, std::memory_order_relaxed);
+        if (bytes == static_cast<ssize_t>(sizeof(can_frame))) {
+            _tx_frames.fetch_add(1, std::memory_order_relaxed);
+        } else if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)) {
+            return false;   // Retry on EPOLLOUT
+        } else {
+            _tx_errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        _tx_pending = false;
+    }
+}
+
+void CanTransport::run() {
+    epoll_event events[MAX_EVENTS];
+    while (_running.load(std::memory_order_acquire)) {
+        const int ready = ::epoll_wait(_epoll_fd, events, MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        _wakeups.fetch_add(1, std::memory_order_relaxed);
+
+        bool flush = false;
+        for (int i = 0; i < ready; ++i) {
+            if (events[i].data.fd == _tx_event) {
+                clear_event(_tx_event);
+                _tx_signalled.exchange(false, std::memory_order_acq_rel);
+                flush = true;
+            } else {
+                if (events[i].events & EPOLLIN) {
+                    if (_mode == IoMode::Batched) drain_socket_batched();
+                    else drain_socket();
+                }
+                if (events[i].events & EPOLLOUT) flush = true;
+                if (events[i].events & EPOLLERR) {
+                    // Reading the pending error clears it, otherwise epoll reports it forever
+                    int error = 0;
+                    socklen_t length = sizeof(error);
+                    ::getsockopt(_fd, SOL_SOCKET, SO_ERROR, &error, &length);
+                    _tx_errors.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (events[i].events & EPOLLHUP) {
+                    // Peer gone: stop watching the socket, queued TX frames stay queued
+                    ::epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, _fd, nullptr);
+                    _want_writable = false;
+                    _hung_up = true;
+                }
+            }
+        }
+        if (flush && !_hung_up) update_interest(!(_mode == IoMode::Batched ? flush_tx_batched() : flush_tx()));
+    }
+}
+
+#endif
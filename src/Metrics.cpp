@@ -0,0 +1,141 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include "../include/Metrics.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+uint64_t Metrics::Histogram::percentile(double quantile) const {
+    if (!count) return 0;
+    const double share = std::min(std::max(quantile, 0.0), 1.0);
+    // 1-based rank of the sample, rounded up
+    const double scaled = share * static_cast<double>(count);
+    uint64_t rank = static_cast<uint64_t>(scaled);
+    if (rank < scaled || rank == 0) ++rank;
+
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < counts.size(); ++bucket) {
+        seen += counts[bucket];
+        if (seen >= rank) return std::min(Buckets::upper(bucket), max);
+    }
+    return max;
+}
+
+#ifdef LIBMODUL_METRICS
+namespace {
+    using Metrics::detail::Counter;
+    using Metrics::detail::HistogramCells;
+    using Metrics::detail::Shard;
+
+    inline uint64_t load(const Counter& counter) {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+    void add_histogram(Metrics::Histogram& out, const HistogramCells& cells) {
+        for (size_t bucket = 0; bucket < Metrics::Buckets::COUNT; ++bucket) {
+            const uint64_t count = load(cells.counts[bucket]);
+            out.counts[bucket] += count;
+            out.count += count;
+        }
+        out.sum += load(cells.sum);
+        out.max = std::max(out.max, load(cells.max));
+    }
+
+    void add_shard(Metrics::Snapshot& out, const Shard& shard) {
+        for (size_t protocol = 0; protocol < Metrics::PROTOCOL_COUNT; ++protocol) {
+            for (size_t result = 0; result < Metrics::RESULT_COUNT; ++result)
+                out.outcomes[protocol][result] += load(shard.outcomes[protocol][result]);
+            for (size_t key = 0; key < Metrics::COMMAND_KEYS; ++key)
+                out.commands[protocol][key] += load(shard.commands[protocol][key]);
+        }
+        add_histogram(out.parse_ns, shard.parse_ns);
+        for (size_t address = 0; address < MODULE_ADDRESS_COUNT; ++address)
+            add_histogram(out.latency_us[address], shard.latency_us[address]);
+    }
+
+    void merge_cells(HistogramCells& into, const HistogramCells& from) {
+        for (size_t bucket = 0; bucket < Metrics::Buckets::COUNT; ++bucket)
+            Metrics::detail::bump(into.counts[bucket], load(from.counts[bucket]));
+        Metrics::detail::bump(into.sum, load(from.sum));
+        if (load(from.max) > load(into.max)) into.max.store(load(from.max), std::memory_order_relaxed);
+    }
+
+    // Folding an exiting thread's shard into the retired totals
+    void merge_shard(Shard& into, const Shard& from) {
+        for (size_t protocol = 0; protocol < Metrics::PROTOCOL_COUNT; ++protocol) {
+            for (size_t result = 0; result < Metrics::RESULT_COUNT; ++result)
+                Metrics::detail::bump(into.outcomes[protocol][result], load(from.outcomes[protocol][result]));
+            for (size_t key = 0; key < Metrics::COMMAND_KEYS; ++key)
+                Metrics::detail::bump(into.commands[protocol][key], load(from.commands[protocol][key]));
+        }
+        merge_cells(into.parse_ns, from.parse_ns);
+        for (size_t address = 0; address < MODULE_ADDRESS_COUNT; ++address)
+            merge_cells(into.latency_us[address], from.latency_us[address]);
+    }
+
+    /**
+     * @brief Live shards and the totals of exited threads
+     *
+     * Leaked on purpose so threads exiting during static destruction
+     * still find it.
+     */
+    struct Registry {
+        std::mutex mutex;
+        std::vector<Shard*> live;
+        std::unique_ptr<Shard> retired{new Shard()};
+    };
+
+    Registry& registry() {
+        static Registry* instance = new Registry();
+        return *instance;
+    }
+
+    // Trivial pointer for the fast path, the owner is only touched once per thread
+    thread_local Shard* local_shard = nullptr;
+
+    // Owns the shard of one thread, retires it at thread exit
+    struct ShardOwner {
+        Shard* shard = nullptr;
+
+        ~ShardOwner() {
+            if (!shard) return;
+            Registry& shared = registry();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            merge_shard(*shared.retired, *shard);
+            shared.live.erase(std::find(shared.live.begin(), shared.live.end(), shard));
+            // A later thread_local destructor that records gets a fresh shard, not this one
+            local_shard = nullptr;
+            delete shard;
+            shard = nullptr;
+        }
+    };
+
+    thread_local ShardOwner local_owner;
+}
+
+Metrics::detail::Shard& Metrics::detail::shard() {
+    if (Shard* shard = local_shard) return *shard;
+
+    Shard* shard = new Shard();     // Value-initialized, all counters zero
+    Registry& shared = registry();
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.live.push_back(shard);
+    }
+    local_owner.shard = shard;
+    local_shard = shard;
+    return *shard;
+}
+
+void Metrics::snapshot(Snapshot& out) {
+    out = Snapshot{};
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    add_shard(out, *shared.retired);
+    for (const Shard* shard : shared.live) add_shard(out, *shard);
+}
+#else
+void Metrics::snapshot(Snapshot& out) {
+    out = Snapshot{};
+}
+#endif
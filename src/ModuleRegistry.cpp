@@ -0,0 +1,87 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <type_traits>
+#include "../libmodul.h"
+
+static_assert(std::is_trivially_copyable<TelemetryRecord>::value, "TelemetryRecord is copied as raw words");
+static_assert(sizeof(TelemetryRecord) % sizeof(uint64_t) == 0, "TelemetryRecord must be whole words");
+
+namespace {
+    // Copy the fields present in update over the current record
+    inline void merge(TelemetryRecord& current, const TelemetryRecord& update) {
+        if (update.has(ParsedData::VOLTAGE)) current.voltage_mv = update.voltage_mv;
+        if (update.has(ParsedData::CURRENT)) current.current_ma = update.current_ma;
+        if (update.has(ParsedData::TEMP)) current.temperature_mdeg = update.temperature_mdeg;
+        if (update.has(ParsedData::STATUS)) current.status = update.status;
+        if (update.has(ParsedData::CAPABILITY)) current.capability_milli = update.capability_milli;
+        current.address = update.address & UUgreenConstants::MAX_ADDRESS;
+        current.fields |= update.fields;
+    }
+}
+
+TelemetryRecord ModuleRegistry::load_unsynchronized(const Slot& slot) {
+    uint64_t words[WORD_COUNT];
+    for (size_t i = 0; i < WORD_COUNT; ++i) words[i] = slot.words[i].load(std::memory_order_relaxed);
+    TelemetryRecord record;
+    std::memcpy(&record, words, sizeof(record));
+    return record;
+}
+
+void ModuleRegistry::store(Slot& slot, const TelemetryRecord& record) {
+    uint64_t words[WORD_COUNT];
+    std::memcpy(words, &record, sizeof(record));
+
+    const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORD_COUNT; ++i) slot.words[i].store(words[i], std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void ModuleRegistry::update(const TelemetryRecord& record) {
+    if (record.fields == 0) return;
+
+    Slot& slot = _slots[record.address & UUgreenConstants::MAX_ADDRESS];
+    // The writer owns the slot, its own view never needs the retry loop
+    TelemetryRecord current = load_unsynchronized(slot);
+    merge(current, record);
+    store(slot, current);
+}
+
+void ModuleRegistry::update(const ParsedData& data) {
+    update(TelemetryRecord::fromParsedData(data));
+}
+
+size_t ModuleRegistry::update(const TelemetryRecord* records, size_t count) {
+    size_t merged = 0;
+    for (size_t i = 0; i < count; ++i) {
+        merged += records[i].fields != 0;
+        update(records[i]);
+    }
+    return merged;
+}
+
+bool ModuleRegistry::read(uint8_t address, TelemetryRecord& record) const {
+    const Slot& slot = _slots[address & UUgreenConstants::MAX_ADDRESS];
+    uint32_t before, after;
+    do {
+        before = slot.sequence.load(std::memory_order_acquire);
+        record = load_unsynchronized(slot);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = slot.sequence.load(std::memory_order_relaxed);
+    } while ((before & 1u) || before != after);
+    return record.fields != 0;
+}
+
+std::optional<ParsedData> ModuleRegistry::get(uint8_t address) const {
+    TelemetryRecord record;
+    if (!read(address, record)) return std::nullopt;
+    return record.toParsedData();
+}
+
+uint32_t ModuleRegistry::version(uint8_t address) const {
+    return _slots[address & UUgreenConstants::MAX_ADDRESS].sequence.load(std::memory_order_acquire) / 2;
+}
+
+void ModuleRegistry::clear() {
+    for (auto& slot : _slots) store(slot, TelemetryRecord{});
+}
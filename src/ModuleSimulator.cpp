@@ -0,0 +1,267 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include "../include/ModuleSimulator.h"
+#include <algorithm>
+
+namespace {
+    constexpr uint32_t ID_MASK = 0x1FFFFFFF;            // CAN ID without flags
+    constexpr uint8_t MMEET_CONTROLLER = MMeetConstants::FRAME_SUFFIX;  // Source address of our requests
+
+    // Telemetry model, see ModuleSimulator
+    constexpr int32_t AMBIENT_MDEG = 25000;
+    constexpr uint32_t LOW_MODE_CAPABILITY_MILLI = 100000;
+    constexpr uint32_t HIGH_MODE_CAPABILITY_MILLI = 50000;
+
+    inline uint32_t load_be32(const uint8_t* bytes) {
+        return uint32_t(bytes[0]) << 24 | uint32_t(bytes[1]) << 16 | uint32_t(bytes[2]) << 8 | bytes[3];
+    }
+
+    template <ProtocolType Protocol>
+    std::optional<RequestType> request_of(uint16_t command) {
+        for (size_t i = 0; i < REQUEST_TYPE_COUNT; ++i) {
+            const auto request = static_cast<RequestType>(i);
+            if (FrameBuilder<Protocol>::request_command(request) == command) return request;
+        }
+        return std::nullopt;
+    }
+
+    // Inverse of the parser scale: raw = value in milli-units / record factor
+    inline uint32_t encode_raw(const std::array<uint32_t, 256>& factors, uint8_t key, int64_t milli) {
+        return static_cast<uint32_t>(milli / static_cast<int64_t>(factors[key]));
+    }
+
+    inline bool earlier(const ModuleSimulator::Clock::time_point& due_a, uint64_t sequence_a,
+                        const ModuleSimulator::Clock::time_point& due_b, uint64_t sequence_b) {
+        return due_a != due_b ? due_a < due_b : sequence_a < sequence_b;
+    }
+}
+
+ModuleSimulator::ModuleSimulator(ProtocolType protocol, uint8_t first_address, size_t count, Config config)
+    : _protocol(protocol), _first_address(first_address & UUgreenConstants::MAX_ADDRESS),
+      _config(config), _random(config.seed) {
+    const size_t room = MODULE_ADDRESS_COUNT - _first_address;
+    _modules.resize(count < room ? count : room);
+}
+
+bool ModuleSimulator::decode(const can_frame& frame, uint8_t& address, uint16_t& command, uint32_t& value,
+                             bool& group) const {
+    const uint32_t id = frame.can_id & ID_MASK;
+    if (frame.can_dlc != CAN_INV_DLC) return false;
+
+    if (_protocol == ProtocolType::UUgreen) {
+        // Responses also lack the P2P bit, only controls are taken as group frames
+        if ((id & UUGREEN_MASK) == 0) return false;
+        group = (id & UUgreenConstants::P2P_FLAG) == 0;
+        if (frame.data[0] != UUgreenConstants::CONTROL_PREFIX &&
+            (group || frame.data[0] != UUgreenConstants::PREAMBLE)) return false;
+        address = (id >> 14) & UUgreenConstants::MAX_ADDRESS;
+        command = frame.data[1];
+    } else {
+        if ((id & MMeetConstants::MASK) != MMeetConstants::MASK || ((id >> 3) & 0xFF) != MMEET_CONTROLLER) return false;
+        if (frame.data[0] != MMeetConstants::FRAME_PREFIX || frame.data[1] != MMeetConstants::FRAME_SUFFIX) return false;
+        group = ((id >> 19) & 0x01) == MMeetConstants::GROUP_COMMUNICATION;
+        if (group && ((id >> 11) & 0xFF) != MMeetConstants::BROADCAST_ADDRESS) return false;
+        address = group ? id & MMeetConstants::GROUP_MASK : (id >> 11) & MMeetConstants::MAX_ADDRESS;
+        command = static_cast<uint16_t>(frame.data[2] << 8 | frame.data[3]);
+    }
+    value = load_be32(frame.data + 4);
+    return true;
+}
+
+bool ModuleSimulator::apply_control(ModuleState& module, uint16_t command, uint32_t value) const {
+    if (_protocol == ProtocolType::UUgreen) {
+        switch(command) {
+            case UUgreenConstants::MODE_SET_CMD:
+                module.mode = (value & 0xFF) == UUgreenConstants::HIGH_MODE ? Mode::High : Mode::Low;
+                break;
+            case UUgreenConstants::VOLTAGE_SET_CMD: module.voltage_set_mv = value; break;
+            case UUgreenConstants::CURRENT_SET_CMD: module.current_set_ma = value; break;
+            case UUgreenConstants::POWER_CTRL_CMD: module.enabled = (value & 0xFF) == UUgreenConstants::ON; break;
+            default: return false;
+        }
+    } else {
+        switch(command) {
+            case MMeetConstants::MODE_SET_CMD:
+                switch(value & 0xFFFF) {
+                    case MMeetConstants::HIGH_MODE: module.mode = Mode::High; break;
+                    case MMeetConstants::AUTO_MODE: module.mode = Mode::Auto; break;
+                    default: module.mode = Mode::Low; break;
+                }
+                break;
+            case MMeetConstants::VOLTAGE_SET_CMD: module.voltage_set_mv = value; break;
+            case MMeetConstants::CURRENT_SET_CMD: module.current_set_ma = value; break;
+            case MMeetConstants::POWER_CTRL_CMD: module.enabled = (value & 0xFF) == MMeetConstants::ON; break;
+            default: return false;
+        }
+    }
+    return true;
+}
+
+can_frame ModuleSimulator::make_response(uint8_t address, const ModuleState& module, RequestType request) const {
+    const uint32_t current_ma = module.enabled ? module.current_set_ma : 0;
+    int64_t milli = 0;
+    switch(request) {
+        case RequestType::Voltage: milli = module.enabled ? module.voltage_set_mv : 0; break;
+        case RequestType::Current: milli = current_ma; break;
+        case RequestType::Temp: milli = AMBIENT_MDEG + current_ma / 10; break;
+        case RequestType::CurrentCapability:
+            milli = module.mode == Mode::High ? HIGH_MODE_CAPABILITY_MILLI : LOW_MODE_CAPABILITY_MILLI;
+            break;
+        case RequestType::Flags: milli = module.enabled ? 0 : 1; break;
+    }
+
+    if (_protocol == ProtocolType::UUgreen) {
+        const uint8_t command = *FrameBuilder<ProtocolType::UUgreen>::request_command(request);
+        const uint32_t raw = encode_raw(UUGREEN_RECORD_FACTORS, command, milli);
+        return make_frame(CAN_INV_EFF_FLAG | UUGREEN_MASK | uint32_t(address) << 14,
+                          UUgreenConstants::PREAMBLE, command, 0, 0,
+                          byte_of(raw, 24), byte_of(raw, 16), byte_of(raw, 8), byte_of(raw, 0));
+    }
+    const uint16_t command = *FrameBuilder<ProtocolType::MMeet>::request_command(request);
+    const uint32_t raw = encode_raw(MMEET_RECORD_FACTORS, command & 0xFF, milli);
+    return make_frame(CAN_INV_EFF_FLAG | MMEET_ID | uint32_t(address) << 3,
+                      MMeetConstants::FRAME_PREFIX, MMeetConstants::FRAME_SUFFIX,
+                      byte_of(command, 8), byte_of(command, 0),
+                      byte_of(raw, 24), byte_of(raw, 16), byte_of(raw, 8), byte_of(raw, 0));
+}
+
+bool ModuleSimulator::apply_group(uint8_t group, uint16_t command, uint32_t value) {
+    bool applied = false;
+    for (ModuleState& module : _modules) {
+        if (!module.online || (group != BROADCAST_GROUP && module.group != group)) continue;
+        if (!apply_control(module, command, value)) return false;
+        applied = true;
+    }
+    return applied;
+}
+
+void ModuleSimulator::push_pending(Pending pending) {
+    _pending.push_back(pending);
+    std::push_heap(_pending.begin(), _pending.end(), [](const Pending& a, const Pending& b) {
+        return earlier(b.due, b.sequence, a.due, a.sequence);
+    });
+}
+
+ModuleSimulator::Pending ModuleSimulator::pop_pending() {
+    std::pop_heap(_pending.begin(), _pending.end(), [](const Pending& a, const Pending& b) {
+        return earlier(b.due, b.sequence, a.due, a.sequence);
+    });
+    const Pending pending = _pending.back();
+    _pending.pop_back();
+    return pending;
+}
+
+size_t ModuleSimulator::receive(const can_frame* frames, size_t count, Clock::time_point now) {
+    size_t handled = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t address;
+        uint16_t command;
+        uint32_t value;
+        bool group = false;
+        const bool decoded = decode(frames[i], address, command, value, group);
+        if (decoded && group) {
+            // One frame for the whole group; requests have no single responder
+            const bool request = _protocol == ProtocolType::UUgreen
+                ? request_of<ProtocolType::UUgreen>(command).has_value()
+                : request_of<ProtocolType::MMeet>(command).has_value();
+            if (!request && apply_group(address, command, value)) {
+                ++_stats.controls;
+                ++handled;
+            } else {
+                ++_stats.ignored;
+            }
+            continue;
+        }
+        const size_t index = decoded ? static_cast<uint8_t>(address - _first_address) : _modules.size();
+        if (index >= _modules.size() || !_modules[index].online) {
+            ++_stats.ignored;
+            continue;
+        }
+
+        ModuleState& module = _modules[index];
+        const std::optional<RequestType> request = _protocol == ProtocolType::UUgreen
+            ? request_of<ProtocolType::UUgreen>(command) : request_of<ProtocolType::MMeet>(command);
+        if (!request) {
+            if (apply_control(module, command, value)) {
+                ++_stats.controls;
+                ++handled;
+            } else {
+                ++_stats.ignored;
+            }
+            continue;
+        }
+
+        ++_stats.requests;
+        ++handled;
+        if (_config.drop_rate > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(_random) < _config.drop_rate) {
+            ++_stats.dropped;
+            continue;
+        }
+        Clock::duration delay = _config.latency;
+        if (_config.jitter > Clock::duration::zero())
+            delay += Clock::duration(std::uniform_int_distribution<Clock::rep>(0, _config.jitter.count())(_random));
+        push_pending({now + delay, _sequence++, make_response(address, module, *request)});
+    }
+    return handled;
+}
+
+size_t ModuleSimulator::transmit(Clock::time_point now, can_frame* frames, size_t max_frames) {
+    size_t count = 0;
+    while (count < max_frames && !_pending.empty() && _pending.front().due <= now) {
+        frames[count++] = pop_pending().frame;
+    }
+    _stats.responses += count;
+    return count;
+}
+
+std::optional<ModuleSimulator::Clock::time_point> ModuleSimulator::nextResponse() const {
+    if (_pending.empty()) return std::nullopt;
+    return _pending.front().due;
+}
+
+bool ModuleSimulator::setOnline(uint8_t address, bool online) {
+    const size_t index = static_cast<uint8_t>(address - _first_address);
+    if (index >= _modules.size()) return false;
+    _modules[index].online = online;
+    return true;
+}
+
+bool ModuleSimulator::setGroup(uint8_t address, uint8_t group) {
+    const size_t index = static_cast<uint8_t>(address - _first_address);
+    if (index >= _modules.size()) return false;
+    _modules[index].group = group;
+    return true;
+}
+
+std::optional<ModuleSimulator::ModuleState> ModuleSimulator::state(uint8_t address) const {
+    const size_t index = static_cast<uint8_t>(address - _first_address);
+    if (index >= _modules.size()) return std::nullopt;
+    return _modules[index];
+}
+
+#ifdef __linux__
+size_t ModuleSimulator::serve(CanTransport& bus, Clock::time_point now) {
+    can_frame frames[CanTransport::BURST_CAPACITY];
+    size_t count;
+    while ((count = bus.receive(frames, CanTransport::BURST_CAPACITY, 0)) > 0) receive(frames, count, now);
+
+    Pending due[CanTransport::BURST_CAPACITY];
+    size_t sent = 0;
+    for (;;) {
+        count = 0;
+        while (count < CanTransport::BURST_CAPACITY && !_pending.empty() && _pending.front().due <= now) {
+            due[count] = pop_pending();
+            frames[count] = due[count].frame;
+            ++count;
+        }
+        if (count == 0) break;
+        const size_t accepted = bus.send(frames, count);
+        sent += accepted;
+        _stats.responses += accepted;
+        if (accepted == count) continue;
+        // TX queue full: the rest keep their place and go out on a later serve()
+        for (size_t i = accepted; i < count; ++i) push_pending(due[i]);
+        break;
+    }
+    return sent;
+}
+#endif
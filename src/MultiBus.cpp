@@ -0,0 +1,104 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include "../include/MultiBus.h"
+
+#ifdef __linux__
+
+MultiBusManager::~MultiBusManager() {
+    stop();
+}
+
+int MultiBusManager::addBus(std::unique_ptr<CanTransport> transport, ProtocolType protocol, int cpu) {
+    if (_running || !transport || _buses.size() >= MAX_BUSES) return -1;
+
+    auto bus = std::make_unique<Bus>();
+    bus->transport = std::move(transport);
+    bus->protocol = protocol;
+    bus->cpu = cpu;
+    Bus* target = bus.get();
+    bus->transport->setReceiveHandler([target](const can_frame* frames, size_t count) {
+        ingest(*target, frames, count);
+    });
+    _buses.push_back(std::move(bus));
+    return static_cast<int>(_buses.size() - 1);
+}
+
+int MultiBusManager::open(const char* interface, ProtocolType protocol, int cpu, CanTransport::IoMode mode) {
+    return addBus(CanTransport::open(interface, mode), protocol, cpu);
+}
+
+bool MultiBusManager::start() {
+    if (_running) return false;
+    for (auto& bus : _buses) {
+        if (!bus->transport->start(bus->cpu)) {
+            for (auto& started : _buses) started->transport->stop();
+            return false;
+        }
+    }
+    _running = true;
+    return true;
+}
+
+void MultiBusManager::stop() {
+    if (!_running) return;
+    for (auto& bus : _buses) bus->transport->stop();
+    _running = false;
+}
+
+void MultiBusManager::ingest(Bus& bus, const can_frame* frames, size_t count) {
+    TelemetryRecord records[CanTransport::BURST_CAPACITY];
+    size_t merged = 0;
+    for (size_t done = 0; done < count;) {
+        const size_t chunk = count - done < CanTransport::BURST_CAPACITY ? count - done : CanTransport::BURST_CAPACITY;
+        merged += bus.parser.parseRecords(frames + done, chunk, bus.protocol, records);
+        bus.registry.update(records, chunk);
+        done += chunk;
+    }
+    // Single writer: plain stores keep the counters off the locked-instruction path
+    bus.frames.store(bus.frames.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    bus.rejected.store(bus.rejected.load(std::memory_order_relaxed) + (count - merged), std::memory_order_relaxed);
+}
+
+size_t MultiBusManager::send(size_t bus, const can_frame* frames, size_t count) {
+    if (bus >= _buses.size()) return 0;
+    return _buses[bus]->transport->send(frames, count);
+}
+
+bool MultiBusManager::read(size_t bus, uint8_t address, TelemetryRecord& record) const {
+    if (bus >= _buses.size()) return false;
+    return _buses[bus]->registry.read(address, record);
+}
+
+MultiBusManager::Totals MultiBusManager::totals(size_t bus) const {
+    Totals totals;
+    if (bus >= _buses.size()) return totals;
+
+    TelemetryRecord record;
+    for (size_t address = 0; address < ModuleRegistry::SLOT_COUNT; ++address) {
+        if (!_buses[bus]->registry.read(static_cast<uint8_t>(address), record)) continue;
+        ++totals.modules;
+        totals.current_ma += record.current_ma;
+        totals.power_mw += static_cast<uint64_t>(record.voltage_mv) * record.current_ma / 1000;
+    }
+    return totals;
+}
+
+MultiBusManager::Totals MultiBusManager::totals() const {
+    Totals sum;
+    for (size_t bus = 0; bus < _buses.size(); ++bus) {
+        const Totals part = totals(bus);
+        sum.modules += part.modules;
+        sum.current_ma += part.current_ma;
+        sum.power_mw += part.power_mw;
+    }
+    return sum;
+}
+
+MultiBusManager::BusStats MultiBusManager::stats(size_t bus) const {
+    BusStats stats;
+    if (bus >= _buses.size()) return stats;
+    stats.frames = _buses[bus]->frames.load(std::memory_order_relaxed);
+    stats.rejected = _buses[bus]->rejected.load(std::memory_order_relaxed);
+    return stats;
+}
+
+#endif
@@ -0,0 +1,133 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include "../include/PollScheduler.h"
+#include "../include/Metrics.h"
+
+static_assert((MODULE_ADDRESS_COUNT & (MODULE_ADDRESS_COUNT - 1)) == 0, "address mask");
+
+namespace {
+    // 64 ticks per timeout bounds the expiry lag to 1/64 of the timeout
+    constexpr size_t TICKS_PER_TIMEOUT = 64;
+    constexpr size_t WHEEL_SLOTS = 256;
+
+    // The clock is read for responses only when the latency is recorded
+    inline PollScheduler::Clock::time_point response_time() {
+        return Metrics::ENABLED ? PollScheduler::Clock::now() : PollScheduler::Clock::time_point{};
+    }
+}
+
+PollScheduler::PollScheduler(ProtocolType protocol, size_t max_in_flight, Clock::duration timeout)
+    : _protocol(protocol), _max_in_flight(max_in_flight ? max_in_flight : 1), _timeout(timeout),
+      _wheel(timeout / TICKS_PER_TIMEOUT, WHEEL_SLOTS) {}
+
+bool PollScheduler::enqueue(PollRequest request) {
+    if (static_cast<size_t>(request.request) >= REQUEST_TYPE_COUNT) return false;
+    const uint16_t key = key_of(request.address, request.request);
+    if (_state[key] != KeyState::Idle) return false;
+
+    _state[key] = KeyState::Pending;
+    _pending[(_pending_head + _pending_count) % KEY_COUNT] = key;
+    ++_pending_count;
+    return true;
+}
+
+size_t PollScheduler::enqueueSweep(uint8_t first_address, size_t count) {
+    if (count > MODULE_ADDRESS_COUNT) count = MODULE_ADDRESS_COUNT;
+    size_t queued = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t address = static_cast<uint8_t>(first_address + i);
+        for (size_t request = 0; request < REQUEST_TYPE_COUNT; ++request) {
+            queued += enqueue({address, static_cast<RequestType>(request)});
+        }
+    }
+    return queued;
+}
+
+size_t PollScheduler::nextFrames(Clock::time_point now, can_frame* frames, size_t max_frames) {
+    size_t issued = 0;
+    while (issued < max_frames && _pending_count && _in_flight < _max_in_flight) {
+        const uint16_t key = _pending[_pending_head];
+        _pending_head = (_pending_head + 1) % KEY_COUNT;
+        --_pending_count;
+
+        const PollRequest request = request_of(key);
+        const can_frame* table = request_frames(_protocol, request.request);
+        if (!table) {
+            _state[key] = KeyState::Idle;
+            continue;
+        }
+        frames[issued++] = table[request.address];
+        _state[key] = KeyState::InFlight;
+        _timers[key] = _wheel.arm(now + _timeout, key);
+        if constexpr (Metrics::ENABLED) _sent[key] = now;
+        ++_in_flight;
+    }
+    _stats.issued += issued;
+    return issued;
+}
+
+std::optional<PollRequest> PollScheduler::complete(uint8_t address, uint8_t field, Clock::time_point now) {
+    const auto request = request_for_field(field);
+    if (!request) return std::nullopt;
+
+    const uint16_t key = key_of(address, *request);
+    if (_state[key] != KeyState::InFlight) {
+        ++_stats.unmatched;
+        return std::nullopt;
+    }
+    _state[key] = KeyState::Idle;
+    _wheel.cancel(_timers[key]);
+    --_in_flight;
+    ++_stats.completed;
+    Metrics::record_latency(address, now - _sent[key]);
+    return request_of(key);
+}
+
+std::optional<PollRequest> PollScheduler::onResponse(const can_frame& frame) {
+    const auto [record, result] = _parser.parseRecord(frame, _protocol);
+    if (!record) return std::nullopt;
+    return onResponse(*record);
+}
+
+std::optional<PollRequest> PollScheduler::onResponse(const TelemetryRecord& record) {
+    return onResponse(record, response_time());
+}
+
+std::optional<PollRequest> PollScheduler::onResponse(const TelemetryRecord& record, Clock::time_point now) {
+    // A parsed response carries ADDR plus exactly one telemetry field
+    const uint8_t telemetry = record.fields & ~(1u << ParsedData::ADDR);
+    if (!telemetry) return std::nullopt;
+    return complete(record.address, static_cast<uint8_t>(__builtin_ctz(telemetry)), now);
+}
+
+size_t PollScheduler::onResponses(const TelemetryRecord* records, size_t count) {
+    return onResponses(records, count, response_time());   // One clock read per batch
+}
+
+size_t PollScheduler::onResponses(const TelemetryRecord* records, size_t count, Clock::time_point now) {
+    size_t completed = 0;
+    for (size_t i = 0; i < count; ++i) completed += onResponse(records[i], now).has_value();
+    return completed;
+}
+
+size_t PollScheduler::expire(Clock::time_point now, PollRequest* timed_out, size_t max_timed_out) {
+    _wheel.advance(now, [this](uint32_t key, Clock::time_point) {
+        _state[key] = KeyState::Idle;
+        --_in_flight;
+        ++_stats.timed_out;
+        _expired.push_back(static_cast<uint16_t>(key));
+    });
+
+    size_t reported = 0;
+    if (timed_out) {
+        while (reported < max_timed_out && _expired_head < _expired.size()) {
+            timed_out[reported++] = request_of(_expired[_expired_head++]);
+        }
+    } else {
+        _expired_head = _expired.size();
+    }
+    if (_expired_head == _expired.size()) {
+        _expired.clear();
+        _expired_head = 0;
+    }
+    return reported;
+}
@@ -0,0 +1,106 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include "../include/SetpointCache.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // Both protocols carry the encoded value in the data bytes, the ID only names the module and command
+    inline uint64_t payload_of(const can_frame& frame) {
+        uint64_t payload;
+        std::memcpy(&payload, frame.data, sizeof(payload));
+        return payload;
+    }
+}
+
+SetpointCache::SetpointCache(ProtocolType protocol, Clock::duration refresh_period)
+    : _manager(protocol), _refresh_period(refresh_period) {}
+
+bool SetpointCache::stage(uint8_t address, Setpoint setpoint, const can_frame& frame) {
+    Slot& slot = _slots[slot_of(address, setpoint)];
+    ++_stats.updates;
+    const bool changed = !slot.sent || payload_of(frame) != slot.sent_payload;
+
+    // Steady state: the bus and the staged frame already hold this value
+    if (!changed && !slot.dirty) {
+        ++_stats.suppressed;
+        return false;
+    }
+    if (slot.dirty) {
+        ++_stats.coalesced;
+        --_dirty_count;
+    }
+    // Changed back to what was sent: the slot is due for refresh from its old send time again
+    if (!changed) _next_refresh = std::min(_next_refresh, slot.sent_at + _refresh_period);
+    slot.wanted = frame;
+    slot.staged = true;
+    slot.dirty = changed;
+    _dirty_count += changed;
+    return changed;
+}
+
+void SetpointCache::mark_sent(Slot& slot, Clock::time_point now) {
+    slot.sent_payload = payload_of(slot.wanted);
+    slot.sent_at = now;
+    slot.sent = true;
+    _next_refresh = std::min(_next_refresh, now + _refresh_period);
+}
+
+size_t SetpointCache::flush(Clock::time_point now, can_frame* frames, size_t max_frames) {
+    size_t count = 0;
+    for (size_t i = 0; i < _slots.size() && count < max_frames && _dirty_count; ++i) {
+        Slot& slot = _slots[i];
+        if (!slot.dirty) continue;
+        frames[count++] = slot.wanted;
+        mark_sent(slot, now);
+        slot.dirty = false;
+        --_dirty_count;
+        ++_stats.sent;
+    }
+
+    // Most ticks come before any refresh is due and skip the scan
+    if (now < _next_refresh) return count;
+    Clock::time_point next = Clock::time_point::max();
+    for (size_t i = 0; i < _slots.size(); ++i) {
+        Slot& slot = _slots[i];
+        if (!slot.sent || slot.dirty) continue;
+        const Clock::time_point due = slot.sent_at + _refresh_period;
+        if (now < due) {
+            next = std::min(next, due);
+            continue;
+        }
+        if (count == max_frames) {
+            next = now;     // No room: the rest are still due on the next flush
+            break;
+        }
+        frames[count++] = slot.wanted;
+        mark_sent(slot, now);
+        next = std::min(next, now + _refresh_period);
+        ++_stats.refreshed;
+    }
+    _next_refresh = next;
+    return count;
+}
+
+void SetpointCache::invalidate(uint8_t module_address) {
+    for (size_t setpoint = 0; setpoint < SETPOINT_COUNT; ++setpoint) {
+        Slot& slot = _slots[slot_of(module_address, static_cast<Setpoint>(setpoint))];
+        slot.sent = false;
+        if (slot.staged && !slot.dirty) {
+            slot.dirty = true;
+            ++_dirty_count;
+        }
+    }
+}
+
+void SetpointCache::invalidateAll() {
+    for (size_t address = 0; address < MODULE_ADDRESS_COUNT; ++address)
+        invalidate(static_cast<uint8_t>(address));
+}
+
+std::optional<can_frame> SetpointCache::lastSent(uint8_t module_address, Setpoint setpoint) const {
+    const Slot& slot = _slots[slot_of(module_address, setpoint)];
+    if (!slot.sent) return std::nullopt;
+    can_frame frame = slot.wanted;
+    std::memcpy(frame.data, &slot.sent_payload, sizeof(slot.sent_payload));
+    return frame;
+}
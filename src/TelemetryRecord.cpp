@@ -0,0 +1,34 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <cmath>
+#include "../libmodul.h"
+
+namespace {
+    // Float value to 0.001 units, rounded to nearest
+    inline uint32_t to_milli(float value) {
+        return static_cast<uint32_t>(std::llround(static_cast<double>(value) * 1000.0));
+    }
+}
+
+TelemetryRecord TelemetryRecord::fromParsedData(const ParsedData& data) {
+    TelemetryRecord record;
+    record.voltage_mv = to_milli(data.voltage);
+    record.current_ma = to_milli(data.current);
+    record.capability_milli = to_milli(data.current_capability);
+    record.status = data.status;
+    record.temperature_mdeg = static_cast<int32_t>(data.temperature) * 1000;
+    record.address = data.address;
+    record.fields = static_cast<uint8_t>(data.fields.to_ulong());
+    return record;
+}
+
+ParsedData TelemetryRecord::toParsedData() const {
+    ParsedData data;
+    data.address = address;
+    data.voltage = static_cast<float>(voltage_mv) * 0.001f;
+    data.current = static_cast<float>(current_ma) * 0.001f;
+    data.current_capability = static_cast<float>(capability_milli) * 0.001f;
+    data.status = status;
+    data.temperature = static_cast<int16_t>(temperature_mdeg / 1000);
+    data.fields = std::bitset<ParsedData::COUNT>(fields);
+    return data;
+}
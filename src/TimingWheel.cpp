@@ -0,0 +1,127 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include "../include/TimingWheel.h"
+
+namespace {
+    inline size_t round_up_pow2(size_t value) {
+        size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+}
+
+TimingWheel::TimingWheel(Clock::duration tick, size_t slot_count, Clock::time_point origin)
+    : _tick(tick.count() > 0 ? tick : Clock::duration(1)),
+      _origin(origin),
+      _slots(round_up_pow2(slot_count ? slot_count : 1), NIL),
+      _mask(_slots.size() - 1) {}
+
+uint64_t TimingWheel::elapsed_ticks(Clock::time_point now) const {
+    if (now <= _origin) return 0;
+    return static_cast<uint64_t>((now - _origin) / _tick);
+}
+
+uint64_t TimingWheel::deadline_tick(Clock::time_point deadline) const {
+    if (deadline <= _origin) return 0;
+    // Round up so a timer never fires before its deadline
+    return static_cast<uint64_t>((deadline - _origin + _tick - Clock::duration(1)) / _tick);
+}
+
+TimingWheel::TimerId TimingWheel::arm(Clock::time_point deadline, uint32_t tag) {
+    uint32_t index = _free;
+    if (index != NIL) {
+        _free = _nodes[index].next;
+    } else {
+        index = static_cast<uint32_t>(_nodes.size());
+        _nodes.emplace_back();
+    }
+
+    uint64_t tick = deadline_tick(deadline);
+    if (tick <= _current_tick) tick = _current_tick + 1;
+
+    Node& node = _nodes[index];
+    node.tag = tag;
+    node.tick = tick;
+    node.deadline = deadline;
+    node.armed = true;
+
+    // Insert at the head: a slot being fired is walked from a detached chain
+    uint32_t& head = _slots[tick & _mask];
+    node.prev = NIL;
+    node.next = head;
+    if (head != NIL) _nodes[head].prev = index;
+    head = index;
+    ++_armed;
+    return (static_cast<uint64_t>(node.generation) << 32) | index;
+}
+
+bool TimingWheel::cancel(TimerId id) {
+    const uint32_t index = static_cast<uint32_t>(id);
+    const uint32_t generation = static_cast<uint32_t>(id >> 32);
+    if (index >= _nodes.size() || _nodes[index].generation != generation || !_nodes[index].armed) return false;
+    unlink(index);
+    release(index);
+    return true;
+}
+
+void TimingWheel::unlink(uint32_t index) {
+    Node& node = _nodes[index];
+    if (node.prev != NIL) _nodes[node.prev].next = node.next;
+    else _slots[node.tick & _mask] = node.next;
+    if (node.next != NIL) _nodes[node.next].prev = node.prev;
+    node.armed = false;
+    --_armed;
+}
+
+void TimingWheel::release(uint32_t index) {
+    Node& node = _nodes[index];
+    node.armed = false;
+    ++node.generation;
+    if (node.generation == 0) node.generation = 1;  // Keep INVALID_TIMER unused
+    node.next = _free;
+    _free = index;
+}
+
+uint32_t TimingWheel::collect(size_t slot, uint64_t up_to_tick) {
+    // Detach due nodes into a chain so callbacks may arm and cancel freely
+    uint32_t chain = NIL;
+    uint32_t index = _slots[slot];
+    while (index != NIL) {
+        const uint32_t next = _nodes[index].next;
+        if (_nodes[index].tick <= up_to_tick) {
+            unlink(index);
+            _nodes[index].next = chain;
+            chain = index;
+        }
+        index = next;
+    }
+    return chain;
+}
+
+std::optional<TimingWheel::Clock::time_point> TimingWheel::nextDeadline() const {
+    if (_armed == 0) return std::nullopt;
+
+    // The first slot ahead holding a timer of this revolution has the earliest deadlines
+    for (uint64_t tick = _current_tick + 1; tick <= _current_tick + _slots.size(); ++tick) {
+        std::optional<Clock::time_point> earliest;
+        for (uint32_t index = _slots[tick & _mask]; index != NIL; index = _nodes[index].next) {
+            if (_nodes[index].tick == tick && (!earliest || _nodes[index].deadline < *earliest))
+                earliest = _nodes[index].deadline;
+        }
+        if (earliest) return earliest;
+    }
+
+    // Every timer is more than a revolution away
+    std::optional<Clock::time_point> earliest;
+    for (const Node& node : _nodes) {
+        if (node.armed && (!earliest || node.deadline < *earliest)) earliest = node.deadline;
+    }
+    return earliest;
+}
+
+std::optional<TimingWheel::Clock::time_point> TimingWheel::nextExpiry() const {
+    const auto deadline = nextDeadline();
+    if (!deadline) return std::nullopt;
+    uint64_t tick = deadline_tick(*deadline);
+    if (tick <= _current_tick) tick = _current_tick + 1;
+    return _origin + _tick * static_cast<Clock::duration::rep>(tick);
+}
@@ -0,0 +1,151 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include "../include/AsyncBus.h"
+#include "../include/ModuleSimulator.h"
+
+// Built with make COROUTINES=1 only
+#if defined(__linux__) && defined(__cpp_impl_coroutine)
+#include <atomic>
+#include <sys/socket.h>
+#include <thread>
+
+namespace {
+    using std::chrono::milliseconds;
+
+    // Modules served from their own thread on the far end of a socket pair
+    class SimulatedBus {
+    public:
+        SimulatedBus(ProtocolType protocol, size_t modules) : _fleet(protocol, 0, modules) {
+            int fds[2];
+            if (::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) != 0) return;
+            local = std::make_unique<CanTransport>(fds[0]);
+            _remote = std::make_unique<CanTransport>(fds[1]);
+            local->start();
+            _remote->start();
+            _thread = std::thread([this] {
+                while (!_stop.load(std::memory_order_acquire)) {
+                    _fleet.serve(*_remote, ModuleSimulator::Clock::now());
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+            });
+        }
+
+        ~SimulatedBus() {
+            _stop.store(true, std::memory_order_release);
+            if (_thread.joinable()) _thread.join();
+        }
+
+        bool setOnline(uint8_t address, bool online) { return _fleet.setOnline(address, online); }
+
+        std::unique_ptr<CanTransport> local;
+
+    private:
+        ModuleSimulator _fleet;
+        std::unique_ptr<CanTransport> _remote;
+        std::thread _thread;
+        std::atomic<bool> _stop{false};
+    };
+
+    struct Outcome {
+        std::optional<Millivolts> voltage;
+        std::optional<Milliamps> current;
+        bool done = false;
+    };
+
+    AsyncTask configureAndRead(AsyncBus& bus, uint8_t address, Outcome& outcome) {
+        co_await bus.setVoltage(address, Millivolts{300000u + address});
+        co_await bus.setCurrent(address, Milliamps{1000u + address});
+        co_await bus.enable(address);
+        outcome.voltage = co_await bus.readVoltage(address, milliseconds(500));
+        outcome.current = co_await bus.readCurrent(address, milliseconds(500));
+        outcome.done = true;
+    }
+
+    AsyncTask readTemperature(AsyncBus& bus, uint8_t address, std::optional<int32_t>& temperature, bool& done) {
+        temperature = co_await bus.readTemperature(address, milliseconds(20));
+        done = true;
+    }
+
+    struct Guard {
+        bool& destroyed;
+        ~Guard() { destroyed = true; }
+    };
+
+    AsyncTask readForever(AsyncBus& bus, bool& destroyed) {
+        Guard guard{destroyed};
+        co_await bus.readFlags(0x01, std::chrono::hours(1));
+    }
+}
+
+class AsyncBusTest : public ::testing::TestWithParam<ProtocolType> {};
+
+TEST_P(AsyncBusTest, ManyConversationsAsStraightLineCode) {
+    constexpr size_t CONVERSATIONS_PER_MODULE = 8;
+    SimulatedBus simulated(GetParam(), MODULE_ADDRESS_COUNT);
+    ASSERT_TRUE(simulated.local);
+    AsyncBus bus(*simulated.local, GetParam());
+
+    std::vector<Outcome> outcomes(MODULE_ADDRESS_COUNT * CONVERSATIONS_PER_MODULE);
+    for (size_t i = 0; i < outcomes.size(); ++i) {
+        configureAndRead(bus, static_cast<uint8_t>(i % MODULE_ADDRESS_COUNT), outcomes[i]);
+    }
+    EXPECT_GT(bus.suspended(), 0u);
+    bus.run();
+    EXPECT_EQ(bus.suspended(), 0u);
+
+    for (size_t i = 0; i < outcomes.size(); ++i) {
+        const uint32_t address = static_cast<uint32_t>(i % MODULE_ADDRESS_COUNT);
+        ASSERT_TRUE(outcomes[i].done) << i;
+        ASSERT_TRUE(outcomes[i].voltage) << i;
+        ASSERT_TRUE(outcomes[i].current) << i;
+        EXPECT_EQ(outcomes[i].voltage->value, 300000u + address);
+        EXPECT_EQ(outcomes[i].current->value, 1000u + address);
+    }
+    const AsyncBus::Stats stats = bus.stats();
+    EXPECT_EQ(stats.completed, 2 * outcomes.size());
+    EXPECT_EQ(stats.timed_out, 0u);
+    // Reads of the same module and value share a request
+    EXPECT_LE(stats.requests, 2 * outcomes.size());
+    EXPECT_GE(stats.requests, 2 * MODULE_ADDRESS_COUNT);
+}
+
+TEST_P(AsyncBusTest, SilentModuleTimesOut) {
+    SimulatedBus simulated(GetParam(), 4);
+    ASSERT_TRUE(simulated.local);
+    ASSERT_TRUE(simulated.setOnline(2, false));
+    AsyncBus bus(*simulated.local, GetParam());
+
+    std::optional<int32_t> online, offline;
+    bool online_done = false, offline_done = false;
+    const auto start = AsyncBus::Clock::now();
+    readTemperature(bus, 1, online, online_done);
+    readTemperature(bus, 2, offline, offline_done);
+    bus.run();
+
+    EXPECT_TRUE(online_done);
+    EXPECT_TRUE(online);
+    EXPECT_TRUE(offline_done);
+    EXPECT_FALSE(offline);
+    EXPECT_GE(AsyncBus::Clock::now() - start, milliseconds(20));
+    EXPECT_EQ(bus.stats().completed, 1u);
+    EXPECT_EQ(bus.stats().timed_out, 1u);
+}
+
+TEST_P(AsyncBusTest, DestroysSuspendedConversations) {
+    SimulatedBus simulated(GetParam(), 0);
+    ASSERT_TRUE(simulated.local);
+    bool destroyed = false;
+    {
+        AsyncBus bus(*simulated.local, GetParam());
+        readForever(bus, destroyed);
+        EXPECT_EQ(bus.suspended(), 1u);
+        EXPECT_EQ(bus.runOnce(0), 0u);
+        EXPECT_FALSE(destroyed);
+    }
+    EXPECT_TRUE(destroyed);
+}
+
+INSTANTIATE_TEST_SUITE_P(Protocols, AsyncBusTest,
+                         ::testing::Values(ProtocolType::UUgreen, ProtocolType::MMeet));
+
+#endif
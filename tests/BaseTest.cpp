@@ -272,6 +272,213 @@ TEST_F(MMeetFrameGeneratorTest, GenerateDisable) {
     EXPECT_EQ(frame.data[7], 0x55); // OFF
 }
 
+// Batch generation Tests
+static void expectSameFrame(const can_frame& actual, const can_frame& expected) {
+    EXPECT_EQ(actual.can_id, expected.can_id);
+    EXPECT_EQ(actual.can_dlc, expected.can_dlc);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(actual.data[i], expected.data[i]);
+    }
+}
+
+TEST_F(UUgreenFrameGeneratorTest, GenerateRequestBatchMatchesSingleFrames) {
+    const uint8_t addresses[] = {0x00, testAddress, 0x40, 0x7F};
+    can_frame frames[4];
+
+    ASSERT_EQ(generator.generateRequestBatch(RequestType::Voltage, addresses, 4, frames), 4u);
+    for (size_t i = 0; i < 4; ++i) {
+        expectSameFrame(frames[i], generator.generateVoltageRequest(addresses[i]));
+    }
+}
+
+TEST_F(UUgreenFrameGeneratorTest, GenerateRequestRangeMatchesSingleFrames) {
+    can_frame frames[128];
+
+    ASSERT_EQ(generator.generateRequestRange(RequestType::Temp, 0, 128, frames), 128u);
+    for (uint8_t address = 0; address < 128; ++address) {
+        expectSameFrame(frames[address], generator.generateTempRequest(address));
+    }
+}
+
+TEST_F(UUgreenFrameGeneratorTest, GenerateRequestRangeClampsToAddressSpace) {
+    can_frame frames[8];
+
+    EXPECT_EQ(generator.generateRequestRange(RequestType::Flags, 0x7C, 8, frames), 4u);
+    expectSameFrame(frames[3], generator.generateFlagsRequest(0x7F));
+    EXPECT_EQ(generator.generateRequestRange(RequestType::Flags, 0x80, 8, frames), 0u);
+    EXPECT_EQ(generator.generateRequestRange(static_cast<RequestType>(99), 0, 8, frames), 0u);
+}
+
+TEST_F(MMeetFrameGeneratorTest, GenerateRequestBatchMatchesSingleFrames) {
+    const uint8_t addresses[] = {0x00, testAddress, 0x40, 0x7F};
+    can_frame frames[4];
+
+    ASSERT_EQ(generator.generateRequestBatch(RequestType::CurrentCapability, addresses, 4, frames), 4u);
+    for (size_t i = 0; i < 4; ++i) {
+        expectSameFrame(frames[i], generator.generateCurrentCapabilityRequest(addresses[i]));
+    }
+}
+
+TEST_F(MMeetFrameGeneratorTest, GenerateRequestRangeMatchesSingleFrames) {
+    can_frame frames[128];
+
+    ASSERT_EQ(generator.generateRequestRange(RequestType::Current, 0, 128, frames), 128u);
+    for (uint8_t address = 0; address < 128; ++address) {
+        expectSameFrame(frames[address], generator.generateCurrentRequest(address));
+    }
+}
+
+TEST_F(MMeetFrameGeneratorTest, GenerateRequestRangeClampsToAddressSpace) {
+    can_frame frames[8];
+
+    EXPECT_EQ(generator.generateRequestRange(RequestType::Voltage, 0x7E, 8, frames), 2u);
+    expectSameFrame(frames[1], generator.generateVoltageRequest(0x7F));
+    EXPECT_EQ(generator.generateRequestBatch(static_cast<RequestType>(99), nullptr, 0, frames), 0u);
+}
+
+// Group frame Tests
+static void expectSamePayload(const can_frame& actual, const can_frame& expected) {
+    EXPECT_EQ(actual.can_dlc, expected.can_dlc);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(actual.data[i], expected.data[i]);
+    }
+}
+
+TEST_F(UUgreenFrameGeneratorTest, GenerateGroupFrames) {
+    const uint8_t group = 0x05;
+    auto frame = generator.generateGroupVoltageSet(group, 400.0f);
+
+    EXPECT_EQ(frame.can_id, 0x02000000u | group << 14 | CAN_INV_EFF_FLAG); // P2P bit cleared
+    expectSamePayload(frame, generator.generateVoltageSet(testAddress, 400.0f));
+    expectSamePayload(generator.generateGroupCurrentSet(group, 12.5f), generator.generateCurrentSet(testAddress, 12.5f));
+    expectSamePayload(generator.generateGroupLowModeSet(group), generator.generateLowModeSet(testAddress));
+    expectSamePayload(generator.generateGroupHighModeSet(group), generator.generateHighModeSet(testAddress));
+    expectSamePayload(generator.generateGroupEnable(group), generator.generateEnable(testAddress));
+    expectSamePayload(generator.generateGroupDisable(group), generator.generateDisable(testAddress));
+    EXPECT_FALSE(generator.generateGroupAutoModeSet(group).has_value());
+
+    EXPECT_EQ(generator.generateGroupEnable(BROADCAST_GROUP).can_id, 0x02000000u | CAN_INV_EFF_FLAG);
+    EXPECT_EQ(generator.generateEnable(testAddress).can_id, 0x02200000u | testAddress << 14 | CAN_INV_EFF_FLAG);
+}
+
+TEST_F(MMeetFrameGeneratorTest, GenerateGroupFrames) {
+    const uint8_t group = 0x03;
+    auto frame = generator.generateGroupVoltageSet(group, 400.0f);
+
+    // P2P bit cleared, destination 0xFF, source 0xF0, group in the low bits
+    EXPECT_EQ(frame.can_id, 0x06000000u | 0xFFu << 11 | 0xF0u << 3 | group | CAN_INV_EFF_FLAG);
+    expectSamePayload(frame, generator.generateVoltageSet(testAddress, 400.0f));
+    expectSamePayload(generator.generateGroupCurrentSet(group, 12.5f), generator.generateCurrentSet(testAddress, 12.5f));
+    expectSamePayload(generator.generateGroupLowModeSet(group), generator.generateLowModeSet(testAddress));
+    expectSamePayload(generator.generateGroupHighModeSet(group), generator.generateHighModeSet(testAddress));
+    expectSamePayload(generator.generateGroupEnable(group), generator.generateEnable(testAddress));
+    expectSamePayload(generator.generateGroupDisable(group), generator.generateDisable(testAddress));
+    auto auto_mode = generator.generateGroupAutoModeSet(group);
+    ASSERT_TRUE(auto_mode.has_value());
+    expectSamePayload(*auto_mode, *generator.generateAutoModeSet(testAddress));
+
+    EXPECT_EQ(generator.generateGroupEnable(BROADCAST_GROUP).can_id & 0x07u, 0u);
+    EXPECT_EQ(generator.generateGroupEnable(group).can_id & (1u << 19), 0u);
+    EXPECT_NE(generator.generateEnable(testAddress).can_id & (1u << 19), 0u);
+}
+
+// Static manager Tests
+template <ProtocolType Protocol>
+static void expectStaticManagerMatchesRuntime() {
+    StaticCanProtocolManager<Protocol> fixed;
+    CanProtocolManager runtime(Protocol);
+
+    for (uint8_t address = 0; address < 128; ++address) {
+        expectSameFrame(fixed.generateTempRequest(address), runtime.generateTempRequest(address));
+        expectSameFrame(fixed.generateCurrentCapabilityRequest(address), runtime.generateCurrentCapabilityRequest(address));
+        expectSameFrame(fixed.generateFlagsRequest(address), runtime.generateFlagsRequest(address));
+        expectSameFrame(fixed.generateVoltageRequest(address), runtime.generateVoltageRequest(address));
+        expectSameFrame(fixed.generateCurrentRequest(address), runtime.generateCurrentRequest(address));
+        expectSameFrame(fixed.generateLowModeSet(address), runtime.generateLowModeSet(address));
+        expectSameFrame(fixed.generateHighModeSet(address), runtime.generateHighModeSet(address));
+        expectSameFrame(fixed.generateVoltageSet(address, 123.456f), runtime.generateVoltageSet(address, 123.456f));
+        expectSameFrame(fixed.generateCurrentSet(address, 45.6f), runtime.generateCurrentSet(address, 45.6f));
+        expectSameFrame(fixed.generateEnable(address), runtime.generateEnable(address));
+        expectSameFrame(fixed.generateDisable(address), runtime.generateDisable(address));
+
+        auto fixed_auto = fixed.generateAutoModeSet(address);
+        auto runtime_auto = runtime.generateAutoModeSet(address);
+        ASSERT_EQ(fixed_auto.has_value(), runtime_auto.has_value());
+        if (fixed_auto) expectSameFrame(*fixed_auto, *runtime_auto);
+    }
+
+    for (uint8_t group = 0; group < 8; ++group) {
+        expectSameFrame(fixed.generateGroupLowModeSet(group), runtime.generateGroupLowModeSet(group));
+        expectSameFrame(fixed.generateGroupHighModeSet(group), runtime.generateGroupHighModeSet(group));
+        expectSameFrame(fixed.generateGroupVoltageSet(group, 123.456f), runtime.generateGroupVoltageSet(group, 123.456f));
+        expectSameFrame(fixed.generateGroupCurrentSet(group, 45.6f), runtime.generateGroupCurrentSet(group, 45.6f));
+        expectSameFrame(fixed.generateGroupEnable(group), runtime.generateGroupEnable(group));
+        expectSameFrame(fixed.generateGroupDisable(group), runtime.generateGroupDisable(group));
+        ASSERT_EQ(fixed.generateGroupAutoModeSet(group).has_value(), runtime.generateGroupAutoModeSet(group).has_value());
+    }
+}
+
+TEST(StaticCanProtocolManagerTest, UUgreenMatchesRuntimeManager) {
+    expectStaticManagerMatchesRuntime<ProtocolType::UUgreen>();
+}
+
+TEST(StaticCanProtocolManagerTest, MMeetMatchesRuntimeManager) {
+    expectStaticManagerMatchesRuntime<ProtocolType::MMeet>();
+}
+
+TEST(StaticCanProtocolManagerTest, FramesAreBuiltAtCompileTime) {
+    constexpr StaticCanProtocolManager<ProtocolType::MMeet> manager;
+    constexpr can_frame frame = manager.generateVoltageRequest(0x2B);
+    static_assert(frame.data[2] == 0x02 && frame.data[3] == 0x31, "VOLTAGE_CMD");
+    static_assert(sizeof(manager) == 1, "stateless manager");
+    EXPECT_EQ(frame.can_id, MMeetFrameGenerator().generateVoltageRequest(0x2B).can_id);
+}
+
+// Request frame table Tests
+static can_frame runtimeRequest(ICanFrameGenerator& generator, RequestType request, uint8_t address) {
+    switch(request) {
+        case RequestType::Temp: return generator.generateTempRequest(address);
+        case RequestType::CurrentCapability: return generator.generateCurrentCapabilityRequest(address);
+        case RequestType::Flags: return generator.generateFlagsRequest(address);
+        case RequestType::Voltage: return generator.generateVoltageRequest(address);
+        case RequestType::Current: return generator.generateCurrentRequest(address);
+    }
+    return can_frame{};
+}
+
+template <ProtocolType Protocol>
+static void expectTableMatchesGenerator(ICanFrameGenerator& generator) {
+    for (size_t row = 0; row < REQUEST_TYPE_COUNT; ++row) {
+        const auto request = static_cast<RequestType>(row);
+        const can_frame* frames = request_frames(Protocol, request);
+        ASSERT_EQ(frames, REQUEST_FRAME_TABLE<Protocol>[row].data());
+        for (uint8_t address = 0; address < MODULE_ADDRESS_COUNT; ++address) {
+            const can_frame expected = runtimeRequest(generator, request, address);
+            EXPECT_EQ(std::memcmp(&frames[address], &expected, sizeof(can_frame)), 0)
+                << "request " << row << " address " << int(address);
+        }
+    }
+}
+
+TEST(RequestFrameTableTest, UUgreenMatchesGeneratorByteForByte) {
+    UUgreenFrameGenerator generator;
+    expectTableMatchesGenerator<ProtocolType::UUgreen>(generator);
+}
+
+TEST(RequestFrameTableTest, MMeetMatchesGeneratorByteForByte) {
+    MMeetFrameGenerator generator;
+    expectTableMatchesGenerator<ProtocolType::MMeet>(generator);
+}
+
+TEST(RequestFrameTableTest, BuiltAtCompileTime) {
+    constexpr const can_frame& frame =
+        REQUEST_FRAME_TABLE<ProtocolType::UUgreen>[static_cast<size_t>(RequestType::Flags)][0x1A];
+    static_assert(frame.data[0] == 0x12 && frame.data[1] == 0x08, "FLAGS_CMD");
+    static_assert((frame.can_id & 0x1FC000) >> 14 == 0x1A, "address bits");
+    EXPECT_EQ(request_frames(ProtocolType::MMeet, static_cast<RequestType>(99)), nullptr);
+    EXPECT_EQ(request_frames(static_cast<ProtocolType>(99), RequestType::Temp), nullptr);
+}
+
 // CanParser Tests
 TEST_F(CanParserTest, ParseUUgreenVoltage) {
     can_frame frame;
@@ -0,0 +1,142 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../include/CanCapture.h"
+#include "TestFrames.h"
+
+namespace {
+    class CaptureFile {
+    public:
+        CaptureFile() {
+            const int fd = ::mkstemp(_path);
+            if (fd >= 0) ::close(fd);
+        }
+        ~CaptureFile() { ::unlink(_path); }
+        const char* path() const { return _path; }
+
+    private:
+        char _path[32] = "/tmp/libmodul_cap_XXXXXX";
+    };
+
+    can_frame voltageResponse(uint32_t i) {
+        return uugreenResponse(static_cast<uint8_t>(i % 128), UUgreenConstants::VOLTAGE_CMD, i);
+    }
+}
+
+TEST(CanCaptureTest, RoundTripAcrossBlocks) {
+    CaptureFile file;
+    constexpr uint32_t COUNT = 1000;
+    std::vector<can_frame> frames(COUNT);
+    std::vector<uint64_t> timestamps(COUNT);
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        frames[i] = voltageResponse(i);
+        timestamps[i] = 1000000000ull + i * 1000;
+    }
+
+    CaptureWriter writer;
+    ASSERT_TRUE(writer.open(file.path(), ProtocolType::UUgreen, 64));
+    // Bursts with one timestamp, single frames and per-frame timestamps
+    ASSERT_TRUE(writer.append(frames.data(), 100, timestamps[0]));
+    for (uint32_t i = 100; i < 150; ++i) ASSERT_TRUE(writer.append(frames[i], timestamps[i]));
+    ASSERT_TRUE(writer.flush());
+    ASSERT_TRUE(writer.append(frames.data() + 150, timestamps.data() + 150, COUNT - 150));
+    ASSERT_TRUE(writer.close());
+    EXPECT_EQ(writer.framesWritten(), COUNT);
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(file.path()));
+    EXPECT_EQ(reader.protocol(), ProtocolType::UUgreen);
+    EXPECT_GT(reader.createdNs(), 0u);
+
+    CaptureSpan span;
+    uint32_t index = 0;
+    size_t blocks = 0;
+    while (reader.next(span)) {
+        ++blocks;
+        EXPECT_LE(span.count, 64u);
+        for (size_t i = 0; i < span.count; ++i, ++index) {
+            ASSERT_EQ(std::memcmp(&span.frames[i], &frames[index], sizeof(can_frame)), 0) << index;
+            ASSERT_EQ(span.timestamps_ns[i], index < 100 ? timestamps[0] : timestamps[index]);
+        }
+    }
+    EXPECT_EQ(index, COUNT);
+    EXPECT_FALSE(reader.truncated());
+    EXPECT_EQ(blocks, 17u);  // 64 | 36 + 28 | 22 flushed | 13 x 64 | 18
+
+    reader.rewind();
+    ASSERT_TRUE(reader.next(span));
+    EXPECT_EQ(span.frames[0].can_id, frames[0].can_id);
+}
+
+// Spans go straight into the batch parser, no copy
+TEST(CanCaptureTest, SpansFeedParser) {
+    CaptureFile file;
+    CaptureWriter writer;
+    ASSERT_TRUE(writer.open(file.path(), ProtocolType::UUgreen));
+    for (uint32_t i = 0; i < 600; ++i) {
+        const can_frame frame = voltageResponse(i);
+        ASSERT_TRUE(writer.append(frame, i));
+    }
+    ASSERT_TRUE(writer.close());
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(file.path()));
+    CanParser parser;
+    TelemetryRecord records[CaptureFormat::DEFAULT_BLOCK_FRAMES];
+    CaptureSpan span;
+    size_t parsed = 0;
+    uint32_t index = 0;
+    while (reader.next(span)) {
+        parsed += parser.parseRecords(span.frames, span.count, reader.protocol(), records);
+        for (size_t i = 0; i < span.count; ++i, ++index) ASSERT_EQ(records[i].voltage_mv, index);
+    }
+    EXPECT_EQ(parsed, 600u);
+
+    // On disk: header plus blocks of 256, 256 and 88 frames, about half a candump -l log
+    struct stat info;
+    ASSERT_EQ(::stat(file.path(), &info), 0);
+    const size_t size = static_cast<size_t>(info.st_size);
+    EXPECT_EQ(size, sizeof(CaptureFormat::FileHeader) + 2 * CaptureFormat::block_size(256)
+                        + CaptureFormat::block_size(88));
+    const std::string line = "(1700000000.123456) can0 02204000#1262000000061A80\n";
+    EXPECT_GT(600 * line.size(), 2 * size);
+}
+
+TEST(CanCaptureTest, TruncatedAndForeignFiles) {
+    CaptureFile file;
+    CaptureWriter writer;
+    ASSERT_TRUE(writer.open(file.path(), ProtocolType::UUgreen, 16));
+    for (uint32_t i = 0; i < 40; ++i) {
+        const can_frame frame = voltageResponse(i);
+        ASSERT_TRUE(writer.append(frame, i));
+    }
+    ASSERT_TRUE(writer.close());
+
+    // Cut the last block short, as a crash during writev would
+    const off_t full = static_cast<off_t>(sizeof(CaptureFormat::FileHeader) + 2 * CaptureFormat::block_size(16) +
+                                          CaptureFormat::block_size(8));
+    ASSERT_EQ(::truncate(file.path(), full - 5), 0);
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(file.path()));
+    CaptureSpan span;
+    size_t frames = 0;
+    while (reader.next(span)) frames += span.count;
+    EXPECT_EQ(frames, 32u);
+    EXPECT_TRUE(reader.truncated());
+
+    // Not a capture
+    CaptureFile text;
+    FILE* out = std::fopen(text.path(), "w");
+    ASSERT_NE(out, nullptr);
+    std::fputs("(1700000000.123456) can0 02204000#1262000000061A80\n"
+               "(1700000000.123457) can0 02204000#1262000000061A80\n", out);
+    std::fclose(out);
+    EXPECT_FALSE(reader.open(text.path()));
+    EXPECT_FALSE(reader.isOpen());
+    EXPECT_FALSE(reader.open("/nonexistent/capture.bin"));
+    EXPECT_FALSE(writer.open("/nonexistent/capture.bin", ProtocolType::UUgreen));
+    EXPECT_FALSE(writer.append(voltageResponse(0), 0));
+}
@@ -0,0 +1,159 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/CanFilter.h"
+#include "../include/CanTransport.h"
+#include "TestFrames.h"
+
+#ifdef __linux__
+namespace {
+    canid_t mmeetResponse(uint8_t address) {
+        return CAN_EFF_FLAG | MMEET_ID | static_cast<uint32_t>(address) << 3;
+    }
+
+    // Typical J1939 traffic of other nodes: BMS status and charger control
+    constexpr canid_t FOREIGN_IDS[] = {CAN_EFF_FLAG | 0x1806E5F4, CAN_EFF_FLAG | 0x18FF50E5,
+                                       CAN_EFF_FLAG | 0x0CF00400, 0x123, 0x7FF};
+}
+
+TEST(CanFilterTest, FullRangeIsOneFilterPerProtocol) {
+    CanFilterSet filters;
+    ASSERT_TRUE(filters.add(ProtocolType::UUgreen));
+    EXPECT_EQ(filters.size(), 1u);
+    ASSERT_TRUE(filters.add(ProtocolType::MMeet));
+    EXPECT_EQ(filters.size(), 2u);
+
+    for (uint8_t address = 0; address <= UUgreenConstants::MAX_ADDRESS; ++address) {
+        EXPECT_TRUE(filters.accepts(uugreenResponseId(address)));
+        EXPECT_TRUE(filters.accepts(mmeetResponse(address)));
+    }
+    for (canid_t id : FOREIGN_IDS) EXPECT_FALSE(filters.accepts(id)) << std::hex << id;
+
+    // Standard and remote frames never carry responses
+    EXPECT_FALSE(filters.accepts(uugreenResponseId(1) & ~CAN_EFF_FLAG));
+    EXPECT_FALSE(filters.accepts(mmeetResponse(1) | CAN_RTR_FLAG));
+}
+
+TEST(CanFilterTest, AddressRangesAreExact) {
+    for (uint8_t first = 0; first <= UUgreenConstants::MAX_ADDRESS; first += 3) {
+        for (size_t count : {size_t(1), size_t(2), size_t(7), size_t(16), size_t(45), size_t(128)}) {
+            for (ProtocolType protocol : {ProtocolType::UUgreen, ProtocolType::MMeet}) {
+                CanFilterSet filters;
+                ASSERT_TRUE(filters.add(protocol, first, count));
+                EXPECT_LE(filters.size(), 14u);
+                for (unsigned address = 0; address <= UUgreenConstants::MAX_ADDRESS; ++address) {
+                    const bool in_range = address >= first && address < first + count;
+                    const canid_t id = protocol == ProtocolType::UUgreen
+                        ? uugreenResponseId(address) : mmeetResponse(address);
+                    EXPECT_EQ(filters.accepts(id), in_range)
+                        << "first " << int(first) << " count " << count << " address " << address;
+                }
+            }
+        }
+    }
+}
+
+// Every frame the parser accepts from a module in range passes the filter
+TEST(CanFilterTest, NoFalseRejects) {
+    CanParser parser;
+    CanFilterSet filters;
+    ASSERT_TRUE(filters.add(ProtocolType::UUgreen, 0x10, 32));
+    ASSERT_TRUE(filters.add(ProtocolType::MMeet, 0x40, 8));
+
+    std::mt19937 rng(14);
+    size_t parsed = 0;
+    for (int i = 0; i < 200000; ++i) {
+        // The parser sees bare IDs as in CanParserTest; the kernel adds CAN_EFF_FLAG
+        uint32_t id = (rng() & CAN_EFF_MASK) | (rng() & 1 ? UUGREEN_MASK : 0);
+        if (i % 4 == 0) id = MMEET_ID | (id & 0x7FF);
+        const can_frame frame = make_frame(id, 0, UUgreenConstants::VOLTAGE_CMD, 0x02, 0x31);
+
+        auto [data, result, protocol] = parser.parseAny(frame);
+        if (result != ParseResult::OK) continue;
+        const bool wanted = *protocol == ProtocolType::UUgreen
+            ? data->address >= 0x10 && data->address < 0x30
+            : data->address >= 0x40 && data->address < 0x48;
+        if (!wanted) continue;
+        ++parsed;
+        EXPECT_TRUE(filters.accepts(id | CAN_EFF_FLAG)) << std::hex << id;
+    }
+    EXPECT_GT(parsed, 100u);
+}
+
+TEST(CanFilterTest, RejectsInvalidInput) {
+    CanFilterSet filters;
+    EXPECT_FALSE(filters.add(ProtocolType::UUgreen, 0x80, 1));
+    EXPECT_TRUE(filters.add(ProtocolType::UUgreen, 0x7F, 10)); // clipped to one address
+    EXPECT_EQ(filters.size(), 1u);
+    EXPECT_TRUE(filters.add(ProtocolType::MMeet, 0x05, 0));
+    EXPECT_EQ(filters.size(), 1u);
+
+    // 0x01..0x7E needs 12 blocks, so the third such range does not fit
+    filters.clear();
+    EXPECT_TRUE(filters.add(ProtocolType::UUgreen, 0x01, 126));
+    EXPECT_TRUE(filters.add(ProtocolType::MMeet, 0x01, 126));
+    const size_t before = filters.size();
+    EXPECT_FALSE(filters.add(ProtocolType::UUgreen, 0x01, 126));
+    EXPECT_EQ(filters.size(), before);
+
+    // Not a CAN socket
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+    EXPECT_FALSE(filters.install(fds[0]));
+    EXPECT_FALSE(CanFilterSet::acceptAll(fds[0]));
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+// Module responses mixed into heavy foreign traffic: the filtered reader only wakes for responses
+TEST(CanFilterTest, VcanWakeupReduction) {
+    auto sender = CanTransport::open("vcan0");
+    auto plain = CanTransport::open("vcan0");
+    auto filtered = CanTransport::open("vcan0");
+    if (!sender || !plain || !filtered) GTEST_SKIP() << "vcan0 not available";
+
+    CanFilterSet filters;
+    ASSERT_TRUE(filters.add(ProtocolType::UUgreen, 0x00, 16));
+    ASSERT_TRUE(filtered->setFilters(filters));
+    ASSERT_TRUE(sender->start());
+    ASSERT_TRUE(plain->start());
+    ASSERT_TRUE(filtered->start());
+
+    constexpr size_t RESPONSES = 100;
+    constexpr size_t FOREIGN_PER_RESPONSE = 9;
+    constexpr size_t TOTAL = RESPONSES * (FOREIGN_PER_RESPONSE + 1);
+    for (size_t i = 0; i < RESPONSES; ++i) {
+        for (size_t j = 0; j < FOREIGN_PER_RESPONSE; ++j) {
+            can_frame foreign = make_frame(FOREIGN_IDS[j % 3], static_cast<uint8_t>(i));
+            while (!sender->send(foreign)) std::this_thread::yield();
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        const can_frame response = uugreenResponse(static_cast<uint8_t>(i % 16), UUgreenConstants::VOLTAGE_CMD, 48000);
+        while (!sender->send(response)) std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    can_frame sink[256];
+    size_t plain_count = 0, filtered_count = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((plain_count < TOTAL || filtered_count < RESPONSES) && std::chrono::steady_clock::now() < deadline) {
+        plain_count += plain->receive(sink, 256, 10);
+        filtered_count += filtered->receive(sink, 256, 0);
+    }
+    filtered_count += filtered->receive(sink, 256, 50);
+    EXPECT_EQ(plain_count, TOTAL);
+    EXPECT_EQ(filtered_count, RESPONSES);
+
+    const auto plain_stats = plain->stats();
+    const auto filtered_stats = filtered->stats();
+    EXPECT_EQ(filtered_stats.rx_frames, RESPONSES);
+    // At most one I/O thread wakeup per accepted response, foreign traffic never wakes it
+    EXPECT_LE(filtered_stats.wakeups, RESPONSES);
+    EXPECT_LT(filtered_stats.wakeups, plain_stats.wakeups);
+    RecordProperty("unfiltered_wakeups", static_cast<int>(plain_stats.wakeups));
+    RecordProperty("filtered_wakeups", static_cast<int>(filtered_stats.wakeups));
+}
+#endif
@@ -0,0 +1,155 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include "../include/CanLogReader.h"
+
+namespace {
+    // Two modules answering voltage and current, interleaved with foreign traffic
+    constexpr char CANDUMP_LOG[] =
+        "(1436509052.249713) can0 02204000#1262000000061A80\n"   // 0x01 voltage 400.000 V
+        "(1436509052.250000) can0 18FF50E5#0102030405060708\n"   // BMS, not a module
+        "(1436509052.250100) can0 02208000#1230000000002710\n"   // 0x02 current 10.000 A
+        "(1436509052.250200) can0 123#DEADBEEF\n"
+        "(1436509052.250300) can0 123#R\n"
+        "(1436509052.250400) can0 20000004#0000000000000000\n"   // error frame, skipped
+        "(1436509052.250500) can0 123##1112233\n"                // CAN FD, skipped
+        "\n"
+        "garbage line\n"
+        "(1436509052.251) can0 02204000#1230000000001388";       // 0x01 current 5.000 A, no newline
+
+    constexpr char ASC_LOG[] =
+        "date Wed Jun 1 10:00:00.000 am 2025\n"
+        "base hex  timestamps absolute\n"
+        "internal events logged\n"
+        "Begin Triggerblock Wed Jun 1 10:00:00.000 am 2025\n"
+        "   0.010000 1  60F0808x       Rx   d 8 00 00 02 31 00 06 1A 80\n"    // MMeet 0x01 voltage
+        "   0.011000 1  18FF50E5x      Rx   d 8 01 02 03 04 05 06 07 08\n"
+        "   0.012000 1  ErrorFrame\n"
+        "   0.013000 1  123            Tx   d 2 AB CD\n"
+        "   0.014000 1  7FF            Rx   r\n"
+        "End TriggerBlock\n";
+}
+
+TEST(CanLogReaderTest, DecodesCandumpLines) {
+    CanLogReader reader;
+    reader.openBuffer(CANDUMP_LOG, sizeof(CANDUMP_LOG) - 1);
+    can_frame frames[16];
+    uint64_t timestamps[16];
+    ASSERT_EQ(reader.read(frames, 16, timestamps), 6u);
+    EXPECT_EQ(reader.skippedLines(), 3u);
+    EXPECT_EQ(reader.read(frames, 16), 0u);
+
+    EXPECT_EQ(frames[0].can_id, CAN_EFF_FLAG | 0x02204000);
+    EXPECT_EQ(frames[0].can_dlc, 8);
+    EXPECT_EQ(frames[0].data[1], UUgreenConstants::VOLTAGE_CMD);
+    EXPECT_EQ(frames[0].data[7], 0x80);
+    EXPECT_EQ(timestamps[0], 1436509052249713ull);
+    EXPECT_EQ(frames[3].can_id, 0x123u);
+    EXPECT_EQ(frames[3].can_dlc, 4);
+    EXPECT_EQ(frames[3].data[3], 0xEF);
+    EXPECT_EQ(frames[4].can_id, 0x123u | CAN_RTR_FLAG);
+    EXPECT_EQ(frames[4].can_dlc, 0);
+    EXPECT_EQ(timestamps[5], 1436509052251000ull);
+
+    reader.rewind();
+    can_frame again[16];
+    ASSERT_EQ(reader.read(again, 2), 2u);
+    ASSERT_EQ(reader.read(again + 2, 16), 4u);
+    EXPECT_EQ(std::memcmp(frames, again, sizeof(can_frame) * 6), 0);
+}
+
+TEST(CanLogReaderTest, DecodesAscLines) {
+    CanLogReader reader;
+    reader.openBuffer(ASC_LOG, sizeof(ASC_LOG) - 1);
+    can_frame frames[16];
+    uint64_t timestamps[16];
+    ASSERT_EQ(reader.read(frames, 16, timestamps), 4u);
+    EXPECT_EQ(reader.skippedLines(), 6u);
+
+    EXPECT_EQ(frames[0].can_id, CAN_EFF_FLAG | 0x060F0808);
+    EXPECT_EQ(frames[0].data[3], 0x31);
+    EXPECT_EQ(timestamps[0], 10000u);
+    EXPECT_EQ(frames[2].can_id, 0x123u);
+    EXPECT_EQ(frames[2].can_dlc, 2);
+    EXPECT_EQ(frames[2].data[1], 0xCD);
+    EXPECT_EQ(frames[3].can_id, 0x7FFu | CAN_RTR_FLAG);
+
+    // A forced format does not try the other one
+    CanLogReader candump_only(LogFormat::Candump);
+    candump_only.openBuffer(ASC_LOG, sizeof(ASC_LOG) - 1);
+    EXPECT_EQ(candump_only.read(frames, 16), 0u);
+
+    const char decimal[] = "base dec timestamps absolute\n   1.5 1 291 Rx d 1 FF\n";
+    reader.openBuffer(decimal, sizeof(decimal) - 1);
+    ASSERT_EQ(reader.read(frames, 16, timestamps), 1u);
+    EXPECT_EQ(frames[0].can_id, 291u);
+    EXPECT_EQ(timestamps[0], 1500000u);
+}
+
+// The log as a deterministic source for the parser and registry
+TEST(CanLogReaderTest, ReplayFeedsRegistry) {
+    CanLogReader reader;
+    reader.openBuffer(CANDUMP_LOG, sizeof(CANDUMP_LOG) - 1);
+    CanParser parser;
+    ModuleRegistry registry;
+    size_t batches = 0;
+    const ReplayStats stats = reader.replay(parser, ProtocolType::UUgreen,
+        [&](const TelemetryRecord* records, size_t count) {
+            registry.update(records, count);
+            ++batches;
+        });
+
+    EXPECT_EQ(stats.frames, 6u);
+    EXPECT_EQ(stats.parsed, 3u);
+    EXPECT_EQ(stats.skipped, 3u);
+    EXPECT_EQ(stats.bytes, sizeof(CANDUMP_LOG) - 1);
+    EXPECT_EQ(batches, 1u);
+    EXPECT_GT(stats.framesPerSecond(), 0.0);
+
+    TelemetryRecord module;
+    ASSERT_TRUE(registry.read(0x01, module));
+    EXPECT_EQ(module.voltage_mv, 400000);
+    EXPECT_EQ(module.current_ma, 5000);     // the later frame wins
+    ASSERT_TRUE(registry.read(0x02, module));
+    EXPECT_EQ(module.current_ma, 10000);
+}
+
+TEST(CanLogReaderTest, MapsFiles) {
+    char path[] = "/tmp/libmodul_log_XXXXXX";
+    const int fd = ::mkstemp(path);
+    ASSERT_GE(fd, 0);
+
+    // Many lines, so reads cross batch boundaries
+    std::string log;
+    for (int i = 0; i < 1000; ++i) {
+        char line[80];
+        std::snprintf(line, sizeof(line), "(%d.%06d) vcan0 %08X#12620000%08X\n",
+                      i / 1000, i % 1000 * 1000, 0x02200000 | (i % 128) << 14, i);
+        log += line;
+    }
+    ASSERT_EQ(::write(fd, log.data(), log.size()), static_cast<ssize_t>(log.size()));
+    ::close(fd);
+
+    CanLogReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.size(), log.size());
+    CanParser parser;
+    uint32_t expected = 0;
+    const ReplayStats stats = reader.replay(parser, ProtocolType::UUgreen,
+        [&](const TelemetryRecord* records, size_t count) {
+            for (size_t i = 0; i < count; ++i, ++expected) {
+                ASSERT_EQ(records[i].address, expected % 128);
+                ASSERT_EQ(records[i].voltage_mv, expected);
+            }
+        });
+    EXPECT_EQ(stats.frames, 1000u);
+    EXPECT_EQ(stats.parsed, 1000u);
+    EXPECT_EQ(expected, 1000u);
+    reader.close();
+    EXPECT_FALSE(reader.isOpen());
+    ::unlink(path);
+
+    EXPECT_FALSE(reader.open("/nonexistent/candump.log"));
+}
@@ -1,5 +1,7 @@
 /* MIT License Copyright (c) 2025 SmartElectroni*/
 #include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
 #include "../libmodul.h"
 
 class CanParserTest : public ::testing::Test {
@@ -241,4 +243,428 @@ TEST_F(CanParserTest, UnknownProtocol) {
     
     ASSERT_EQ(result, ParseResult::INVALID_FRAME);
     ASSERT_FALSE(data);
-}
\ No newline at end of file
+}
+// Tests for batch parsing
+TEST_F(CanParserTest, ParseBatch_MatchesParse) {
+    std::vector<std::pair<can_frame, ProtocolType>> cases = {
+        {createUUgreenFrame(0x12, 0x00, 123456), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x34, 0x30, 45678), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x56, 0x1E, 25000), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x78, 0x08, 0xABCD1234), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x7F, 0x68, 100000), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x01, 0x99, 0x12345678), ProtocolType::UUgreen},
+        {createMMeetFrame(0x12, 0x0231, 54321), ProtocolType::MMeet},
+        {createMMeetFrame(0x34, 0x0232, 12345), ProtocolType::MMeet},
+        {createMMeetFrame(0x56, 0x020B, 423), ProtocolType::MMeet},
+        {createMMeetFrame(0x78, 0x0218, 0xDEADBEEF), ProtocolType::MMeet},
+        {createMMeetFrame(0x9A, 0x0235, 1100), ProtocolType::MMeet},
+        {createMMeetFrame(0xBC, 0x9999, 0x12345678), ProtocolType::MMeet},
+        {createMMeetFrame(0xBC, 0x0331, 0x12345678), ProtocolType::MMeet},
+    };
+    can_frame invalid{};
+    invalid.can_id = 0x123;
+    invalid.can_dlc = 5;
+    cases.push_back({invalid, ProtocolType::UUgreen});
+    cases.push_back({invalid, ProtocolType::MMeet});
+
+    for (const auto& [frame, protocol] : cases) {
+        uint8_t address = 0xFF, field = 0xFF;
+        uint32_t raw = 0xFFFFFFFF;
+        ParseResult result = ParseResult::OK;
+        const size_t parsed = parser.parseBatch(&frame, 1, protocol, {&address, &field, &raw, &result});
+
+        auto [data, expected] = parser.parse(frame, protocol);
+        ASSERT_EQ(result, expected);
+        EXPECT_EQ(parsed, expected == ParseResult::OK ? 1u : 0u);
+        if (expected != ParseResult::OK) {
+            EXPECT_EQ(field, ParsedData::COUNT);
+            EXPECT_EQ(raw, 0u);
+            continue;
+        }
+        EXPECT_EQ(address, data->address);
+        ASSERT_LT(field, ParsedData::COUNT);
+        EXPECT_TRUE(data->fields.test(field));
+        EXPECT_EQ(raw, (uint32_t(frame.data[4]) << 24) | (uint32_t(frame.data[5]) << 16) |
+                       (uint32_t(frame.data[6]) << 8) | frame.data[7]);
+        if (field == ParsedData::STATUS) {
+            EXPECT_EQ(raw, data->status);
+        }
+    }
+}
+
+TEST_F(CanParserTest, ParseBatch_MultipleFrames) {
+    const can_frame frames[] = {
+        createUUgreenFrame(0x01, 0x62, 400000),
+        createUUgreenFrame(0x02, 0x99, 0),
+        createUUgreenFrame(0x03, 0x30, 20000),
+    };
+    uint8_t address[3], field[3];
+    uint32_t raw[3];
+    ParseResult result[3];
+
+    EXPECT_EQ(parser.parseBatch(frames, 3, ProtocolType::UUgreen, {address, field, raw, result}), 2u);
+    EXPECT_EQ(result[0], ParseResult::OK);
+    EXPECT_EQ(result[1], ParseResult::UNKNOWN_CMD);
+    EXPECT_EQ(result[2], ParseResult::OK);
+    EXPECT_EQ(address[2], 0x03);
+    EXPECT_EQ(field[0], ParsedData::VOLTAGE);
+    EXPECT_EQ(field[2], ParsedData::CURRENT);
+    EXPECT_EQ(raw[0], 400000u);
+
+    EXPECT_EQ(parser.parseBatch(frames, 3, static_cast<ProtocolType>(99), {address, field, raw, result}), 0u);
+    EXPECT_EQ(result[0], ParseResult::INVALID_FRAME);
+}
+
+// Tests for command dispatch tables
+TEST_F(CanParserTest, UUgreen_NegativeTemperature) {
+    auto frame = createUUgreenFrame(0x10, 0x1E, static_cast<uint32_t>(-5000)); // -5.000°C
+
+    auto [data, result] = parser.parse(frame, ProtocolType::UUgreen);
+
+    ASSERT_EQ(result, ParseResult::OK);
+    ASSERT_TRUE(data->fields.test(ParsedData::TEMP));
+    EXPECT_EQ(data->temperature, -5);
+}
+
+TEST_F(CanParserTest, MMeet_UnknownCommandHighByte) {
+    auto frame = createMMeetFrame(0x10, 0x0331, 1000); // known low byte, foreign high byte
+
+    auto [data, result] = parser.parse(frame, ProtocolType::MMeet);
+
+    ASSERT_EQ(result, ParseResult::UNKNOWN_CMD);
+    ASSERT_FALSE(data);
+}
+
+// Frames read from a socket carry the extended frame flag
+TEST_F(CanParserTest, MMeet_ExtendedFrameFlag) {
+    auto frame = createMMeetFrame(0x12, 0x0231, 54321);
+    frame.can_id |= CAN_EFF_FLAG;
+
+    auto [data, result] = parser.parse(frame, ProtocolType::MMeet);
+    ASSERT_EQ(result, ParseResult::OK);
+    EXPECT_FLOAT_EQ(data->voltage, 54.321f);
+
+    TelemetryRecord record;
+    ASSERT_EQ(parser.parseRecords(&frame, 1, ProtocolType::MMeet, &record), 1u);
+    EXPECT_EQ(record.voltage_mv, 54321u);
+    EXPECT_EQ(parser.detectProtocol(frame), ProtocolType::MMeet);
+}
+
+TEST_F(CanParserTest, CommandTables_BuiltFromProtocolConstants) {
+    static_assert(UUGREEN_COMMANDS[UUgreenConstants::TEMP_CMD].field == ParsedData::TEMP, "UUgreen temp");
+    static_assert(MMEET_COMMANDS[MMeetConstants::CURRENT_CAP_CMD & 0xFF].scale == 0.1f, "MMeet capability");
+
+    size_t uugreen_known = 0, mmeet_known = 0;
+    for (const auto& entry : UUGREEN_COMMANDS) uugreen_known += entry.field != ParsedData::COUNT;
+    for (const auto& entry : MMEET_COMMANDS) mmeet_known += entry.field != ParsedData::COUNT;
+    EXPECT_EQ(uugreen_known, 7u);
+    EXPECT_EQ(mmeet_known, 5u);
+}
+
+// Tests for vectorized decode kernels
+TEST_F(CanParserTest, DecodeBatch_KernelsMatchParse) {
+    std::vector<can_frame> uugreen, mmeet;
+    const uint8_t uugreen_cmds[] = {0x00, 0x30, 0x1E, 0x08, 0x68, 0x62, 0x01, 0x99};
+    const uint16_t mmeet_cmds[] = {0x0231, 0x0232, 0x020B, 0x0218, 0x0235, 0x9999, 0x0331};
+    const uint32_t values[] = {0, 1, 423, 25000, 123456, 0x7FFFFFFF, 0x80000000, 0xDEADBEEF, 0xFFFFFFFF,
+                               static_cast<uint32_t>(-5000), 16777217};
+    for (uint32_t i = 0; i < 61; ++i) { // odd count exercises the scalar tail
+        uugreen.push_back(createUUgreenFrame(i % 128, uugreen_cmds[i % 8], values[i % 11]));
+        mmeet.push_back(createMMeetFrame(i % 256, mmeet_cmds[i % 7], values[(i + 3) % 11]));
+    }
+    uugreen[13].can_dlc = 5;
+    mmeet[7].can_id = 0x123;
+
+    for (auto kernel : {DecodeKernel::Scalar, DecodeKernel::SSE4, DecodeKernel::AVX2}) {
+        if (!CanParser::isDecodeKernelSupported(kernel)) continue;
+        for (auto protocol : {ProtocolType::UUgreen, ProtocolType::MMeet}) {
+            const auto& frames = protocol == ProtocolType::UUgreen ? uugreen : mmeet;
+            const size_t count = frames.size();
+            std::vector<uint8_t> address(count), field(count);
+            std::vector<uint32_t> raw(count);
+            std::vector<float> value(count);
+            std::vector<ParseResult> result(count);
+            const ParsedBatch out{address.data(), field.data(), raw.data(), result.data(), value.data()};
+
+            size_t expected_parsed = 0;
+            const size_t parsed = parser.decodeBatch(frames.data(), count, protocol, out, kernel);
+            for (size_t i = 0; i < count; ++i) {
+                SCOPED_TRACE(testing::Message() << "kernel " << int(kernel) << " frame " << i);
+                auto [data, expected] = parser.parse(frames[i], protocol);
+                ASSERT_EQ(result[i], expected);
+                if (expected != ParseResult::OK) {
+                    EXPECT_EQ(field[i], ParsedData::COUNT);
+                    EXPECT_EQ(raw[i], 0u);
+                    EXPECT_EQ(value[i], 0.0f);
+                    continue;
+                }
+                ++expected_parsed;
+                EXPECT_EQ(address[i], data->address);
+                ASSERT_TRUE(data->fields.test(field[i]));
+                float reference = value[i];
+                switch (field[i]) {
+                    case ParsedData::VOLTAGE: reference = data->voltage; break;
+                    case ParsedData::CURRENT: reference = data->current; break;
+                    case ParsedData::CAPABILITY: reference = data->current_capability; break;
+                    case ParsedData::TEMP: EXPECT_EQ(static_cast<int16_t>(value[i]), data->temperature); break;
+                    case ParsedData::STATUS: EXPECT_EQ(raw[i], data->status); break;
+                }
+                EXPECT_EQ(std::memcmp(&reference, &value[i], sizeof(float)), 0) << reference << " vs " << value[i];
+            }
+            EXPECT_EQ(parsed, expected_parsed);
+        }
+    }
+}
+
+TEST_F(CanParserTest, DecodeBatch_KernelSelection) {
+    EXPECT_TRUE(CanParser::isDecodeKernelSupported(DecodeKernel::Scalar));
+    EXPECT_TRUE(CanParser::isDecodeKernelSupported(CanParser::bestDecodeKernel()));
+
+    const can_frame frame = createUUgreenFrame(0x05, 0x62, 400000);
+    uint8_t address, field;
+    uint32_t raw;
+    float value;
+    ParseResult result;
+    EXPECT_EQ(parser.decodeBatch(&frame, 1, ProtocolType::UUgreen, {&address, &field, &raw, &result, &value}), 1u);
+    EXPECT_EQ(address, 0x05);
+    EXPECT_EQ(field, ParsedData::VOLTAGE);
+    EXPECT_FLOAT_EQ(value, 400.0f);
+
+    EXPECT_EQ(parser.decodeBatch(&frame, 1, static_cast<ProtocolType>(99), {&address, &field, &raw, &result, &value}), 0u);
+    EXPECT_EQ(result, ParseResult::INVALID_FRAME);
+}
+
+// Tests for protocol auto-detection
+TEST_F(CanParserTest, DetectProtocol) {
+    EXPECT_EQ(CanParser::detectProtocol(createUUgreenFrame(0x12, 0x62, 0)), ProtocolType::UUgreen);
+    // MMEET_ID carries the UUgreen bit too, MMeet must win
+    EXPECT_EQ(CanParser::detectProtocol(createMMeetFrame(0x12, 0x0231, 0)), ProtocolType::MMeet);
+
+    can_frame foreign{};
+    foreign.can_id = 0x123;
+    EXPECT_FALSE(CanParser::detectProtocol(foreign));
+}
+
+TEST_F(CanParserTest, ParseAny_MatchesParse) {
+    const std::pair<can_frame, ProtocolType> cases[] = {
+        {createUUgreenFrame(0x12, 0x62, 400000), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x34, 0x99, 0), ProtocolType::UUgreen},
+        {createMMeetFrame(0x56, 0x0231, 54321), ProtocolType::MMeet},
+        {createMMeetFrame(0x78, 0x9999, 0), ProtocolType::MMeet},
+    };
+    for (const auto& [frame, protocol] : cases) {
+        auto [data, result, detected] = parser.parseAny(frame);
+        auto [expected_data, expected_result] = parser.parse(frame, protocol);
+
+        ASSERT_EQ(detected, protocol);
+        EXPECT_EQ(result, expected_result);
+        ASSERT_EQ(data.has_value(), expected_data.has_value());
+        if (data) {
+            EXPECT_EQ(data->address, expected_data->address);
+            EXPECT_EQ(data->fields, expected_data->fields);
+            EXPECT_FLOAT_EQ(data->voltage, expected_data->voltage);
+        }
+    }
+
+    can_frame foreign{};
+    foreign.can_id = 0x123;
+    foreign.can_dlc = CAN_INV_DLC;
+    auto [data, result, detected] = parser.parseAny(foreign);
+    EXPECT_FALSE(data);
+    EXPECT_EQ(result, ParseResult::INVALID_FRAME);
+    EXPECT_FALSE(detected);
+}
+
+TEST_F(CanParserTest, SplitByProtocol) {
+    can_frame foreign{};
+    foreign.can_id = 0x123;
+    const can_frame frames[] = {
+        createMMeetFrame(0x01, 0x0231, 1),
+        createUUgreenFrame(0x02, 0x62, 2),
+        foreign,
+        createUUgreenFrame(0x03, 0x30, 3),
+        createMMeetFrame(0x04, 0x0232, 4),
+        createMMeetFrame(0x05, 0x020B, 5),
+    };
+    can_frame uugreen[6], mmeet[6];
+
+    const ProtocolSplit split = parser.splitByProtocol(frames, 6, uugreen, mmeet);
+
+    EXPECT_EQ(split.uugreen, 2u);
+    EXPECT_EQ(split.mmeet, 3u);
+    EXPECT_EQ(split.unknown, 1u);
+    EXPECT_EQ(uugreen[0].data[7], 2);
+    EXPECT_EQ(uugreen[1].data[7], 3);
+    EXPECT_EQ(mmeet[0].data[7], 1);
+    EXPECT_EQ(mmeet[1].data[7], 4);
+    EXPECT_EQ(mmeet[2].data[7], 5);
+
+    uint8_t address[6], field[6];
+    uint32_t raw[6];
+    ParseResult result[6];
+    EXPECT_EQ(parser.parseBatch(mmeet, split.mmeet, ProtocolType::MMeet, {address, field, raw, result}), 3u);
+    EXPECT_EQ(parser.parseBatch(uugreen, split.uugreen, ProtocolType::UUgreen, {address, field, raw, result}), 2u);
+}
+
+// Tests for compact telemetry records
+TEST_F(CanParserTest, TelemetryRecord_Layout) {
+    static_assert(sizeof(TelemetryRecord) == 32, "record size");
+    static_assert(alignof(TelemetryRecord) == 32, "record alignment");
+    TelemetryRecord records[2];
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&records[1]) - reinterpret_cast<uintptr_t>(&records[0]), 32u);
+}
+
+TEST_F(CanParserTest, ParseRecord_MatchesParse) {
+    const std::pair<can_frame, ProtocolType> cases[] = {
+        {createUUgreenFrame(0x12, 0x62, 400123), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x13, 0x01, 45678), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x14, 0x1E, static_cast<uint32_t>(-5500)), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x15, 0x08, 0xABCD1234), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x16, 0x68, 100000), ProtocolType::UUgreen},
+        {createMMeetFrame(0x21, 0x0231, 754321), ProtocolType::MMeet},
+        {createMMeetFrame(0x22, 0x0232, 12345), ProtocolType::MMeet},
+        {createMMeetFrame(0x23, 0x020B, static_cast<uint32_t>(-423)), ProtocolType::MMeet},
+        {createMMeetFrame(0x24, 0x0218, 0xDEADBEEF), ProtocolType::MMeet},
+        {createMMeetFrame(0x25, 0x0235, 1100), ProtocolType::MMeet},
+    };
+    for (const auto& [frame, protocol] : cases) {
+        auto [record, result] = parser.parseRecord(frame, protocol);
+        auto [data, expected] = parser.parse(frame, protocol);
+        ASSERT_EQ(result, expected);
+        ASSERT_TRUE(record);
+
+        const ParsedData converted = record->toParsedData();
+        EXPECT_EQ(converted.fields, data->fields);
+        EXPECT_EQ(converted.address, data->address);
+        EXPECT_EQ(converted.voltage, data->voltage);
+        EXPECT_EQ(converted.current, data->current);
+        EXPECT_EQ(converted.temperature, data->temperature);
+        EXPECT_EQ(converted.status, data->status);
+        EXPECT_FLOAT_EQ(converted.current_capability, data->current_capability);
+    }
+
+    EXPECT_EQ(parser.parseRecord(createUUgreenFrame(0x01, 0x99, 0), ProtocolType::UUgreen).second, ParseResult::UNKNOWN_CMD);
+    EXPECT_EQ(parser.parseRecord(createUUgreenFrame(0x01, 0x62, 0), ProtocolType::MMeet).second, ParseResult::INVALID_FRAME);
+}
+
+namespace {
+    // Rebuilds a record from the handler calls
+    struct RecordVisitor {
+        TelemetryRecord record;
+        int calls = 0;
+
+        void set(uint8_t address, ParsedData::Field field) {
+            record.address = address;
+            record.fields = static_cast<uint8_t>((1u << ParsedData::ADDR) | (1u << field));
+            ++calls;
+        }
+        void onVoltage(uint8_t address, uint32_t mv) { record.voltage_mv = mv; set(address, ParsedData::VOLTAGE); }
+        void onCurrent(uint8_t address, uint32_t ma) { record.current_ma = ma; set(address, ParsedData::CURRENT); }
+        void onTemperature(uint8_t address, int32_t mdeg) { record.temperature_mdeg = mdeg; set(address, ParsedData::TEMP); }
+        void onStatus(uint8_t address, uint32_t bits) { record.status = bits; set(address, ParsedData::STATUS); }
+        void onCapability(uint8_t address, uint32_t milli) { record.capability_milli = milli; set(address, ParsedData::CAPABILITY); }
+    };
+
+    struct VoltageOnly : TelemetryVisitor {
+        uint32_t voltage_mv[MODULE_ADDRESS_COUNT] = {};
+
+        void onVoltage(uint8_t address, uint32_t mv) { voltage_mv[address] = mv; }
+    };
+}
+
+TEST_F(CanParserTest, Dispatch_MatchesParseRecord) {
+    const std::pair<can_frame, ProtocolType> cases[] = {
+        {createUUgreenFrame(0x12, 0x62, 400123), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x13, 0x01, 45678), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x14, 0x1E, static_cast<uint32_t>(-5500)), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x15, 0x08, 0xABCD1234), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x16, 0x68, 100000), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x17, 0x99, 1), ProtocolType::UUgreen},
+        {createMMeetFrame(0x21, 0x0231, 754321), ProtocolType::MMeet},
+        {createMMeetFrame(0x22, 0x0232, 12345), ProtocolType::MMeet},
+        {createMMeetFrame(0x23, 0x020B, static_cast<uint32_t>(-423)), ProtocolType::MMeet},
+        {createMMeetFrame(0x24, 0x0218, 0xDEADBEEF), ProtocolType::MMeet},
+        {createMMeetFrame(0x25, 0x0235, 1100), ProtocolType::MMeet},
+        {createMMeetFrame(0x26, 0x0331, 1), ProtocolType::MMeet},
+        {createMMeetFrame(0x27, 0x0231, 1), ProtocolType::UUgreen},
+        {createUUgreenFrame(0x28, 0x62, 1), ProtocolType::MMeet},
+    };
+    for (const auto& [frame, protocol] : cases) {
+        const can_frame before = frame;
+        RecordVisitor visitor;
+        const ParseResult result = parser.dispatch(frame, protocol, visitor);
+        const auto [record, expected] = parser.parseRecord(frame, protocol);
+        ASSERT_EQ(result, expected);
+        EXPECT_EQ(std::memcmp(&before, &frame, sizeof(can_frame)), 0);
+        EXPECT_EQ(visitor.calls, result == ParseResult::OK ? 1 : 0);
+        if (result != ParseResult::OK) continue;
+        EXPECT_EQ(visitor.record.address, record->address);
+        EXPECT_EQ(visitor.record.fields, record->fields);
+        EXPECT_EQ(visitor.record.voltage_mv, record->voltage_mv);
+        EXPECT_EQ(visitor.record.current_ma, record->current_ma);
+        EXPECT_EQ(visitor.record.temperature_mdeg, record->temperature_mdeg);
+        EXPECT_EQ(visitor.record.status, record->status);
+        EXPECT_EQ(visitor.record.capability_milli, record->capability_milli);
+    }
+}
+
+TEST_F(CanParserTest, Dispatch_DetectsProtocolAndSkipsMissingHandlers) {
+    VoltageOnly visitor;
+    EXPECT_EQ(parser.dispatch(createUUgreenFrame(0x10, 0x62, 400500), visitor), ParseResult::OK);
+    EXPECT_EQ(parser.dispatch(createMMeetFrame(0x11, 0x0231, 750125), visitor), ParseResult::OK);
+    EXPECT_EQ(parser.dispatch(createMMeetFrame(0x11, 0x020B, 250), visitor), ParseResult::OK);  // No handler
+    EXPECT_EQ(visitor.voltage_mv[0x10], 400500u);
+    EXPECT_EQ(visitor.voltage_mv[0x11], 750125u);
+
+    can_frame foreign = createUUgreenFrame(0x10, 0x62, 1);
+    foreign.can_id = 0x18FF50E5;
+    EXPECT_EQ(parser.dispatch(foreign, visitor), ParseResult::INVALID_FRAME);
+    EXPECT_EQ(visitor.voltage_mv[0x10], 400500u);
+}
+
+TEST_F(CanParserTest, ParseRecords_Batch) {
+    const can_frame frames[] = {
+        createMMeetFrame(0x05, 0x020B, 255),    // 25.5 degC
+        createMMeetFrame(0x06, 0x9999, 0),
+        createMMeetFrame(0x07, 0x0235, 1100),   // 110.0
+    };
+    TelemetryRecord records[3];
+
+    EXPECT_EQ(parser.parseRecords(frames, 3, ProtocolType::MMeet, records), 2u);
+    EXPECT_EQ(records[0].address, 0x05);
+    EXPECT_TRUE(records[0].has(ParsedData::TEMP));
+    EXPECT_EQ(records[0].temperature_mdeg, 25500);
+    EXPECT_EQ(records[1].fields, 0);
+    EXPECT_TRUE(records[2].has(ParsedData::CAPABILITY));
+    EXPECT_EQ(records[2].capability_milli, 110000u);
+}
+
+TEST_F(CanParserTest, TelemetryRecord_ParsedDataRoundTrip) {
+    ParsedData data;
+    data.address = 0x42;
+    data.voltage = 750.125f;
+    data.current = 12.5f;
+    data.temperature = -12;
+    data.status = 0x80000001;
+    data.current_capability = 98.7f;
+    data.fields.set();
+
+    const TelemetryRecord record = TelemetryRecord::fromParsedData(data);
+    EXPECT_EQ(record.voltage_mv, 750125u);
+    EXPECT_EQ(record.current_ma, 12500u);
+    EXPECT_EQ(record.capability_milli, 98700u);
+    EXPECT_EQ(record.temperature_mdeg, -12000);
+    EXPECT_EQ(record.fields, 0x3F);
+
+    const ParsedData back = record.toParsedData();
+    EXPECT_EQ(back.address, data.address);
+    EXPECT_FLOAT_EQ(back.voltage, data.voltage);
+    EXPECT_FLOAT_EQ(back.current, data.current);
+    EXPECT_EQ(back.temperature, data.temperature);
+    EXPECT_EQ(back.status, data.status);
+    EXPECT_FLOAT_EQ(back.current_capability, data.current_capability);
+    EXPECT_EQ(back.fields, data.fields);
+
+    const TelemetryRecord again = TelemetryRecord::fromParsedData(back);
+    EXPECT_EQ(std::memcmp(&again, &record, sizeof(record)), 0);
+}
@@ -0,0 +1,197 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include "../include/CanTransport.h"
+
+TEST(SpscQueueTest, PushPopWrapAround) {
+    SpscQueue<int, 8> queue;
+    int out[8];
+    for (int round = 0; round < 5; ++round) {
+        const int items[6] = {round, round + 1, round + 2, round + 3, round + 4, round + 5};
+        EXPECT_EQ(queue.push(items, 6), 6u);
+        EXPECT_EQ(queue.push(items, 6), 2u); // full
+        EXPECT_EQ(queue.size(), 8u);
+        EXPECT_EQ(queue.pop(out, 8), 8u);
+        EXPECT_EQ(out[0], round);
+        EXPECT_EQ(out[6], round);
+        EXPECT_FALSE(queue.pop(out[0]));
+    }
+}
+
+TEST(SpscQueueTest, ConcurrentProducerConsumer) {
+    constexpr int COUNT = 200000;
+    static SpscQueue<int, 256> queue;
+    std::thread producer([] {
+        for (int i = 0; i < COUNT;) i += queue.push(i) ? 1 : 0;
+    });
+    int expected = 0;
+    int value;
+    while (expected < COUNT) {
+        if (queue.pop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+    }
+    producer.join();
+}
+
+#ifdef __linux__
+#include <chrono>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+    // A SOCK_SEQPACKET pair keeps frame boundaries like a CAN socket
+    bool makeFramePair(int fds[2]) {
+        return ::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) == 0;
+    }
+}
+
+class CanTransportModeTest : public ::testing::TestWithParam<CanTransport::IoMode> {};
+
+TEST_P(CanTransportModeTest, SendsAndReceivesThroughSocket) {
+    int fds[2];
+    ASSERT_TRUE(makeFramePair(fds));
+    CanTransport local(fds[0], GetParam());
+    CanTransport remote(fds[1], GetParam());
+    ASSERT_TRUE(local.start());
+    ASSERT_TRUE(remote.start());
+
+    can_frame frames[MODULE_ADDRESS_COUNT];
+    ASSERT_EQ(build_request_range<ProtocolType::UUgreen>(RequestType::Voltage, 0, MODULE_ADDRESS_COUNT, frames),
+              MODULE_ADDRESS_COUNT);
+    EXPECT_EQ(local.send(frames, MODULE_ADDRESS_COUNT), MODULE_ADDRESS_COUNT);
+
+    can_frame received[MODULE_ADDRESS_COUNT];
+    size_t total = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (total < MODULE_ADDRESS_COUNT && std::chrono::steady_clock::now() < deadline) {
+        total += remote.receive(received + total, MODULE_ADDRESS_COUNT - total, 100);
+    }
+    ASSERT_EQ(total, MODULE_ADDRESS_COUNT);
+    for (size_t i = 0; i < total; ++i) {
+        EXPECT_EQ(std::memcmp(&received[i], &frames[i], sizeof(can_frame)), 0) << "frame " << i;
+    }
+    EXPECT_EQ(local.stats().tx_frames, MODULE_ADDRESS_COUNT);
+    EXPECT_EQ(remote.stats().rx_frames, MODULE_ADDRESS_COUNT);
+    EXPECT_EQ(remote.stats().rx_dropped, 0u);
+
+    if (GetParam() == CanTransport::IoMode::Batched) {
+        // Whole bursts per syscall instead of one per frame
+        EXPECT_LT(local.stats().syscalls, MODULE_ADDRESS_COUNT / 4);
+    }
+
+    local.stop();
+    remote.stop();
+    EXPECT_FALSE(local.isRunning());
+}
+
+INSTANTIATE_TEST_SUITE_P(IoModes, CanTransportModeTest,
+                         ::testing::Values(CanTransport::IoMode::Single, CanTransport::IoMode::Batched));
+
+TEST(FrameBurstTest, GeneratorsWriteIntoBurst) {
+    int fds[2];
+    ASSERT_TRUE(makeFramePair(fds));
+    FrameBurst<MODULE_ADDRESS_COUNT> tx;
+    FrameBurst<MODULE_ADDRESS_COUNT> rx;
+    CanProtocolManager manager(ProtocolType::MMeet);
+
+    tx.resize(manager.generateRequestRange(RequestType::Temp, 0, 32, tx.frames()));
+    ASSERT_EQ(tx.size(), 32u);
+    EXPECT_EQ(tx.send(fds[0], 0, 0), 32);
+    EXPECT_EQ(rx.receive(fds[1]), 32);
+    ASSERT_EQ(rx.size(), 32u);
+    EXPECT_EQ(std::memcmp(rx.frames(), tx.frames(), 32 * sizeof(can_frame)), 0);
+
+    EXPECT_EQ(tx.send(fds[0], 32), 0);
+    EXPECT_EQ(rx.receive(fds[1]), -1); // nothing queued, MSG_DONTWAIT
+    EXPECT_EQ(rx.size(), 0u);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(CanTransportTest, ReceiveRecordsParsesFrames) {
+    int fds[2];
+    ASSERT_TRUE(makeFramePair(fds));
+    CanTransport transport(fds[0]);
+    ASSERT_TRUE(transport.start());
+
+    // Module side writes responses straight into the socket
+    const can_frame responses[] = {
+        FrameBuilder<ProtocolType::UUgreen>::create_command_frame(0x03, 0x12, UUgreenConstants::VOLTAGE_CMD, 750000),
+        FrameBuilder<ProtocolType::UUgreen>::create_command_frame(0x04, 0x12, 0x99, 0),
+    };
+    for (const auto& frame : responses) ASSERT_EQ(::write(fds[1], &frame, sizeof(frame)), ssize_t(sizeof(frame)));
+
+    CanParser parser;
+    TelemetryRecord records[2];
+    size_t total = 0;
+    for (int attempt = 0; attempt < 50 && total < 2; ++attempt) {
+        total += transport.receiveRecords(parser, ProtocolType::UUgreen, records + total, 2 - total, 100);
+    }
+    ASSERT_EQ(total, 2u);
+    EXPECT_EQ(records[0].address, 0x03);
+    EXPECT_EQ(records[0].voltage_mv, 750000u);
+    EXPECT_EQ(records[1].fields, 0);
+
+    // Peer hang-up must not leave the I/O thread spinning on a dead socket
+    ::close(fds[1]);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_LT(transport.stats().wakeups, 10u);
+}
+
+TEST(CanTransportTest, ReceiveTimesOut) {
+    int fds[2];
+    ASSERT_TRUE(makeFramePair(fds));
+    CanTransport transport(fds[0]);
+    ASSERT_TRUE(transport.start());
+
+    can_frame frame;
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(transport.receive(&frame, 1, 50), 0u);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(45));
+    ::close(fds[1]);
+}
+
+TEST(CanTransportTest, InvalidInterface) {
+    EXPECT_EQ(CanTransport::open("nonexistent0"), nullptr);
+    CanTransport invalid(-1);
+    EXPECT_FALSE(invalid.start());
+}
+
+// Round-trip latency and throughput between two sockets on a virtual bus
+TEST(CanTransportTest, VcanLatencyAndThroughput) {
+    auto sender = CanTransport::open("vcan0");
+    auto receiver = CanTransport::open("vcan0");
+    if (!sender || !receiver) GTEST_SKIP() << "vcan0 not available";
+    ASSERT_TRUE(sender->start());
+    ASSERT_TRUE(receiver->start());
+
+    can_frame frame = FrameBuilder<ProtocolType::UUgreen>::create_request_frame(0x01, UUgreenConstants::VOLTAGE_CMD);
+    can_frame received;
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(sender->send(frame));
+    ASSERT_EQ(receiver->receive(&received, 1, 1000), 1u);
+    const auto latency = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(received.can_id, frame.can_id);
+    EXPECT_EQ(received.can_dlc, frame.can_dlc);
+    EXPECT_LT(latency, std::chrono::milliseconds(100));
+
+    constexpr size_t BURST = 1024;
+    can_frame frames[BURST];
+    can_frame sink[BURST];
+    for (size_t i = 0; i < BURST; ++i) frames[i] = frame;
+    const auto burst_start = std::chrono::steady_clock::now();
+    size_t sent = 0, total = 0;
+    while (total < BURST && std::chrono::steady_clock::now() - burst_start < std::chrono::seconds(5)) {
+        sent += sender->send(frames + sent, BURST - sent);
+        total += receiver->receive(sink, BURST, 10);
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - burst_start).count();
+    EXPECT_EQ(sent, BURST);
+    EXPECT_EQ(total, BURST);
+    EXPECT_LT(elapsed, 1.0);
+    RecordProperty("round_trip_us",
+                   static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(latency).count()));
+    RecordProperty("frames_per_second", static_cast<int>(total / elapsed));
+}
+#endif
@@ -0,0 +1,114 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include <limits>
+#include "../libmodul.h"
+#include "../include/ModuleSimulator.h"
+
+namespace {
+    using Clock = ModuleSimulator::Clock;
+
+    constexpr uint32_t MAX_MILLIVOLTS = 1000000;   // 1000 V, full module range
+    constexpr uint32_t MAX_MILLIAMPS = 200000;     // 200 A
+
+    uint32_t payload(const can_frame& frame) {
+        return uint32_t(frame.data[4]) << 24 | uint32_t(frame.data[5]) << 16 | uint32_t(frame.data[6]) << 8 | frame.data[7];
+    }
+
+    // Set frame to the simulated module, telemetry back through parseRecord
+    class RoundTrip {
+    public:
+        explicit RoundTrip(ProtocolType protocol)
+            : _protocol(protocol), _manager(protocol), _simulator(protocol, ADDRESS, 1) {
+            const can_frame enable = _manager.generateEnable(ADDRESS);
+            _simulator.receive(&enable, 1, Clock::time_point{});
+        }
+
+        std::optional<TelemetryRecord> apply(const can_frame& set, RequestType request) {
+            can_frame frames[2] = {set};
+            _manager.generateRequestRange(request, ADDRESS, 1, frames + 1);
+            _simulator.receive(frames, 2, Clock::time_point{});
+            if (_simulator.transmit(Clock::time_point::max(), frames, 1) != 1) return std::nullopt;
+            return _parser.parseRecord(frames[0], _protocol).first;
+        }
+
+        CanProtocolManager& manager() { return _manager; }
+
+        static constexpr uint8_t ADDRESS = 0x21;
+
+    private:
+        ProtocolType _protocol;
+        CanProtocolManager _manager;
+        ModuleSimulator _simulator;
+        CanParser _parser;
+    };
+}
+
+class FixedPointTest : public ::testing::TestWithParam<ProtocolType> {};
+
+// Every millivolt from 0 to 1000 V survives generator, module and parser unchanged
+TEST_P(FixedPointTest, VoltageRoundTripIsExact) {
+    RoundTrip trip(GetParam());
+    size_t mismatches = 0;
+    uint32_t first_mismatch = 0;
+
+    for (uint32_t mv = 0; mv <= MAX_MILLIVOLTS; ++mv) {
+        const can_frame set = trip.manager().generateVoltageSet(RoundTrip::ADDRESS, Millivolts{mv});
+        const std::optional<TelemetryRecord> record = trip.apply(set, RequestType::Voltage);
+        const bool exact = payload(set) == mv && record && record->voltage_mv == mv;
+        if (!exact && mismatches++ == 0) first_mismatch = mv;
+    }
+    EXPECT_EQ(mismatches, 0u) << "first at " << first_mismatch << " mV";
+}
+
+TEST_P(FixedPointTest, CurrentRoundTripIsExact) {
+    RoundTrip trip(GetParam());
+    size_t mismatches = 0;
+    uint32_t first_mismatch = 0;
+
+    for (uint32_t ma = 0; ma <= MAX_MILLIAMPS; ++ma) {
+        const can_frame set = trip.manager().generateCurrentSet(RoundTrip::ADDRESS, Milliamps{ma});
+        const std::optional<TelemetryRecord> record = trip.apply(set, RequestType::Current);
+        const bool exact = payload(set) == ma && record && record->current_ma == ma;
+        if (!exact && mismatches++ == 0) first_mismatch = ma;
+    }
+    EXPECT_EQ(mismatches, 0u) << "first at " << first_mismatch << " mA";
+}
+
+// The float overloads round to the nearest unit instead of truncating
+TEST_P(FixedPointTest, FloatSetpointsMatchIntegerPath) {
+    CanProtocolManager manager(GetParam());
+    size_t mismatches = 0;
+    uint32_t first_mismatch = 0;
+
+    for (uint32_t mv = 0; mv <= MAX_MILLIVOLTS; ++mv) {
+        const float volts = static_cast<float>(mv) / 1000.0f;
+        if (payload(manager.generateVoltageSet(0, volts)) != mv && mismatches++ == 0) first_mismatch = mv;
+    }
+    EXPECT_EQ(mismatches, 0u) << "first at " << first_mismatch << " mV";
+
+    const can_frame group = manager.generateGroupCurrentSet(BROADCAST_GROUP, Milliamps{12345});
+    EXPECT_EQ(payload(group), 12345u);
+    EXPECT_EQ(group.can_id, manager.generateGroupCurrentSet(BROADCAST_GROUP, 12.345f).can_id);
+}
+
+INSTANTIATE_TEST_SUITE_P(Protocols, FixedPointTest,
+                         ::testing::Values(ProtocolType::UUgreen, ProtocolType::MMeet));
+
+TEST(FixedPointStandaloneTest, RoundsAndSaturates) {
+    static_assert(round_to_milli(12.34f) == 12340, "nearest, not truncated");
+    static_assert(round_to_milli(0.0004f) == 0 && round_to_milli(0.0005f) == 1, "half up");
+    static_assert(round_to_milli(-5.0f) == 0, "negative clamps to 0");
+    static_assert(round_to_milli(1e9f) == UINT32_MAX, "saturates");
+    static_assert(Millivolts::fromVolts(400.0f).value == 400000, "V to mV");
+    static_assert(Milliamps::fromAmps(0.001f).value == 1, "A to mA");
+
+    constexpr can_frame frame = FrameBuilder<ProtocolType::UUgreen>::generateVoltageSet(0x01, Millivolts{750125});
+    static_assert(frame.data[5] == 0x0B && frame.data[6] == 0x72 && frame.data[7] == 0x2D, "0x000B722D");
+    EXPECT_EQ(round_to_milli(std::numeric_limits<float>::quiet_NaN()), 0u);
+
+    // Values that truncation used to lose a unit on
+    UUgreenFrameGenerator generator;
+    for (uint32_t mv : {251u, 1009u, 2001u}) {
+        EXPECT_EQ(payload(generator.generateVoltageSet(0, static_cast<float>(mv) / 1000.0f)), mv) << mv;
+    }
+}
@@ -0,0 +1,153 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../include/Metrics.h"
+#include "../include/ModuleSimulator.h"
+#include "../include/PollScheduler.h"
+#include "TestFrames.h"
+
+namespace {
+    // Counters are process-wide, so every check compares two snapshots
+    struct SnapshotPair {
+        std::unique_ptr<Metrics::Snapshot> before{new Metrics::Snapshot()};
+        std::unique_ptr<Metrics::Snapshot> after{new Metrics::Snapshot()};
+
+        SnapshotPair() { Metrics::snapshot(*before); }
+        void take() { Metrics::snapshot(*after); }
+        uint64_t frames(ProtocolType protocol, ParseResult result) const {
+            return after->frames(protocol, result) - before->frames(protocol, result);
+        }
+        uint64_t command(ProtocolType protocol, uint8_t key) const {
+            const size_t index = static_cast<size_t>(protocol);
+            return after->commands[index][key] - before->commands[index][key];
+        }
+    };
+}
+
+TEST(MetricsTest, BucketsAreLogLinear) {
+    using namespace Metrics::Buckets;
+    for (uint64_t value = 0; value < SUB_COUNT; ++value) EXPECT_EQ(index(value), value);
+    EXPECT_EQ(index(UINT64_MAX), COUNT - 1);
+    EXPECT_EQ(index(uint64_t(1) << MAX_BITS), COUNT - 1);
+
+    for (size_t bucket = 0; bucket + 1 < COUNT; ++bucket) {
+        ASSERT_EQ(index(lower(bucket)), bucket);
+        ASSERT_EQ(index(upper(bucket)), bucket);
+        ASSERT_EQ(upper(bucket) + 1, lower(bucket + 1));
+        // Bucket width at most 1/8 of its values
+        ASSERT_LE((upper(bucket) - lower(bucket)) * SUB_COUNT, lower(bucket)) << bucket;
+    }
+}
+
+TEST(MetricsTest, HistogramPercentiles) {
+    Metrics::Histogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0u);
+    for (uint64_t value = 1; value <= 1000; ++value) histogram.record(value);
+    EXPECT_EQ(histogram.count, 1000u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 500.5);
+    EXPECT_EQ(histogram.max, 1000u);
+    EXPECT_EQ(histogram.percentile(1.0), 1000u);
+    EXPECT_EQ(histogram.percentile(0.0), 1u);
+    for (double quantile : {0.5, 0.9, 0.99}) {
+        const double exact = quantile * 1000;
+        EXPECT_GE(histogram.percentile(quantile), exact);
+        EXPECT_LE(histogram.percentile(quantile), exact * 1.125 + 1);
+    }
+}
+
+TEST(MetricsTest, CountsParseOutcomesOnEveryPath) {
+    if (!Metrics::ENABLED) GTEST_SKIP() << "built without LIBMODUL_METRICS";
+    CanParser parser;
+    SnapshotPair metrics;
+
+    const can_frame voltage = uugreenResponse(1, UUgreenConstants::VOLTAGE_CMD, 0x100);
+    const can_frame unknown = uugreenResponse(1, 0x99, 0x100);
+    const can_frame invalid = make_frame(CAN_INV_EFF_FLAG | 0x123, 0);
+    parser.parse(voltage, ProtocolType::UUgreen);
+    parser.parse(unknown, ProtocolType::UUgreen);
+    parser.parse(invalid, ProtocolType::UUgreen);
+    parser.parseAny(voltage);
+    parser.parseRecord(unknown, ProtocolType::UUgreen);
+    parser.dispatch(voltage, ProtocolType::UUgreen, TelemetryVisitor{});
+    parser.dispatch(unknown, TelemetryVisitor{});
+    parser.dispatch(invalid, TelemetryVisitor{});   // No protocol, not counted
+
+    const can_frame batch[] = {voltage, voltage, unknown, invalid};
+    TelemetryRecord records[4];
+    uint8_t address[4], field[4];
+    uint32_t raw[4];
+    ParseResult result[4];
+    float value[4];
+    parser.parseRecords(batch, 4, ProtocolType::UUgreen, records);
+    parser.parseBatch(batch, 4, ProtocolType::UUgreen, {address, field, raw, result});
+    parser.decodeBatch(batch, 4, ProtocolType::UUgreen, {address, field, raw, result, value});
+
+    metrics.take();
+    EXPECT_EQ(metrics.frames(ProtocolType::UUgreen, ParseResult::OK), 3u + 3 * 2);
+    EXPECT_EQ(metrics.frames(ProtocolType::UUgreen, ParseResult::UNKNOWN_CMD), 3u + 3);
+    EXPECT_EQ(metrics.frames(ProtocolType::UUgreen, ParseResult::INVALID_FRAME), 1u + 3);
+    EXPECT_EQ(metrics.command(ProtocolType::UUgreen, UUgreenConstants::VOLTAGE_CMD), 9u);
+    EXPECT_EQ(metrics.command(ProtocolType::UUgreen, 0x99), 6u);
+    EXPECT_EQ(metrics.frames(ProtocolType::MMeet, ParseResult::OK), 0u);
+    EXPECT_EQ(metrics.after->parse_ns.count - metrics.before->parse_ns.count, 3u);
+}
+
+TEST(MetricsTest, SumsThreadsAfterTheyExit) {
+    if (!Metrics::ENABLED) GTEST_SKIP() << "built without LIBMODUL_METRICS";
+    SnapshotPair metrics;
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; ++thread) {
+        threads.emplace_back([] {
+            CanParser parser;
+            const can_frame frame = uugreenResponse(2, UUgreenConstants::TEMP_CMD, 0x100);
+            for (int i = 0; i < 1000; ++i) parser.parse(frame, ProtocolType::UUgreen);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    metrics.take();
+    EXPECT_EQ(metrics.frames(ProtocolType::UUgreen, ParseResult::OK), 4000u);
+    EXPECT_EQ(metrics.command(ProtocolType::UUgreen, UUgreenConstants::TEMP_CMD), 4000u);
+}
+
+// Latency per module from the scheduler, in the caller's simulated time
+TEST(MetricsTest, RecordsPollLatencyPerModule) {
+    if (!Metrics::ENABLED) GTEST_SKIP() << "built without LIBMODUL_METRICS";
+    ModuleSimulator::Config config;
+    config.latency = std::chrono::milliseconds(3);
+    ModuleSimulator simulator(ProtocolType::UUgreen, 0, 4, config);
+    PollScheduler scheduler(ProtocolType::UUgreen, 64, std::chrono::milliseconds(50));
+    CanParser parser;
+    SnapshotPair metrics;
+
+    const PollScheduler::Clock::time_point start{};
+    can_frame frames[64];
+    TelemetryRecord records[64];
+    scheduler.enqueueSweep(0, 4);
+    simulator.receive(frames, scheduler.nextFrames(start, frames, 64), start);
+    const auto now = *simulator.nextResponse();
+    const size_t count = simulator.transmit(now, frames, 64);
+    parser.parseRecords(frames, count, ProtocolType::UUgreen, records);
+    EXPECT_EQ(scheduler.onResponses(records, count, now), 4 * REQUEST_TYPE_COUNT);
+
+    metrics.take();
+    for (uint8_t address = 0; address < 4; ++address) {
+        const Metrics::Histogram& before = metrics.before->latency_us[address];
+        const Metrics::Histogram& after = metrics.after->latency_us[address];
+        const size_t bucket = Metrics::Buckets::index(3000);
+        EXPECT_EQ(after.count - before.count, REQUEST_TYPE_COUNT);
+        EXPECT_EQ(after.counts[bucket] - before.counts[bucket], REQUEST_TYPE_COUNT);
+        EXPECT_EQ(after.sum - before.sum, 3000u * REQUEST_TYPE_COUNT);
+    }
+}
+
+TEST(MetricsTest, DisabledBuildStaysZero) {
+    if (Metrics::ENABLED) GTEST_SKIP() << "built with LIBMODUL_METRICS";
+    CanParser parser;
+    parser.parse(uugreenResponse(1, UUgreenConstants::VOLTAGE_CMD, 0x100), ProtocolType::UUgreen);
+    auto snapshot = std::make_unique<Metrics::Snapshot>();
+    Metrics::snapshot(*snapshot);
+    EXPECT_EQ(snapshot->frames(ProtocolType::UUgreen, ParseResult::OK), 0u);
+    EXPECT_EQ(snapshot->parse_ns.count, 0u);
+}
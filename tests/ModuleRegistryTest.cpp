@@ -0,0 +1,117 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "../libmodul.h"
+
+class ModuleRegistryTest : public ::testing::Test {
+protected:
+    ModuleRegistry registry;
+    CanParser parser;
+
+    TelemetryRecord parseUUgreen(uint8_t address, uint8_t cmd, uint32_t value) {
+        const can_frame frame = FrameBuilder<ProtocolType::UUgreen>::create_command_frame(address, 0x12, cmd, value);
+        return *parser.parseRecord(frame, ProtocolType::UUgreen).first;
+    }
+};
+
+TEST_F(ModuleRegistryTest, EmptySlot) {
+    TelemetryRecord record;
+    EXPECT_FALSE(registry.read(0x10, record));
+    EXPECT_FALSE(registry.get(0x10));
+    EXPECT_EQ(registry.version(0x10), 0u);
+}
+
+TEST_F(ModuleRegistryTest, MergesFields) {
+    registry.update(parseUUgreen(0x10, UUgreenConstants::VOLTAGE_CMD, 750000));
+    registry.update(parseUUgreen(0x10, UUgreenConstants::CURRENT_CMD, 12500));
+    registry.update(parseUUgreen(0x10, UUgreenConstants::TEMP_CMD, 41000));
+    registry.update(parseUUgreen(0x10, UUgreenConstants::VOLTAGE_CMD, 751000));
+
+    TelemetryRecord record;
+    ASSERT_TRUE(registry.read(0x10, record));
+    EXPECT_EQ(record.address, 0x10);
+    EXPECT_EQ(record.voltage_mv, 751000u);
+    EXPECT_EQ(record.current_ma, 12500u);
+    EXPECT_EQ(record.temperature_mdeg, 41000);
+    EXPECT_TRUE(record.has(ParsedData::TEMP));
+    EXPECT_FALSE(record.has(ParsedData::STATUS));
+    EXPECT_EQ(registry.version(0x10), 4u);
+
+    auto data = registry.get(0x10);
+    ASSERT_TRUE(data);
+    EXPECT_FLOAT_EQ(data->voltage, 751.0f);
+    EXPECT_EQ(data->temperature, 41);
+
+    EXPECT_FALSE(registry.get(0x11));
+}
+
+TEST_F(ModuleRegistryTest, ParsedDataAndBatchUpdate) {
+    ParsedData data;
+    data.address = 0x85; // masked to 0x05
+    data.status = 0x1234;
+    data.fields.set(ParsedData::ADDR);
+    data.fields.set(ParsedData::STATUS);
+    registry.update(data);
+
+    TelemetryRecord records[3] = {
+        parseUUgreen(0x05, UUgreenConstants::VOLTAGE_CMD, 700000),
+        TelemetryRecord{},
+        parseUUgreen(0x06, UUgreenConstants::CURRENT_CMD, 3000),
+    };
+    EXPECT_EQ(registry.update(records, 3), 2u);
+
+    auto module5 = registry.get(0x05);
+    ASSERT_TRUE(module5);
+    EXPECT_EQ(module5->address, 0x05);
+    EXPECT_EQ(module5->status, 0x1234u);
+    EXPECT_FLOAT_EQ(module5->voltage, 700.0f);
+    EXPECT_TRUE(registry.get(0x06));
+
+    registry.clear();
+    EXPECT_FALSE(registry.get(0x05));
+}
+
+TEST_F(ModuleRegistryTest, ConcurrentReadersSeeConsistentSnapshots) {
+    constexpr uint32_t UPDATES = 200000;
+    std::atomic<bool> done{false};
+
+    // Every write keeps voltage, current and status derived from one counter
+    std::thread writer([&] {
+        for (uint32_t i = 1; i <= UPDATES; ++i) {
+            TelemetryRecord record;
+            record.address = static_cast<uint8_t>(i % 4);
+            record.voltage_mv = i;
+            record.current_ma = i * 3;
+            record.status = ~i;
+            record.fields = (1u << ParsedData::ADDR) | (1u << ParsedData::VOLTAGE)
+                          | (1u << ParsedData::CURRENT) | (1u << ParsedData::STATUS);
+            registry.update(record);
+        }
+        done = true;
+    });
+
+    std::vector<std::thread> readers;
+    std::atomic<size_t> torn{0};
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            TelemetryRecord record;
+            while (!done) {
+                for (uint8_t address = 0; address < 4; ++address) {
+                    if (!registry.read(address, record)) continue;
+                    if (record.current_ma != record.voltage_mv * 3 || record.status != ~record.voltage_mv ||
+                        record.address != record.voltage_mv % 4) {
+                        ++torn;
+                    }
+                }
+            }
+        });
+    }
+    writer.join();
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(torn.load(), 0u);
+    TelemetryRecord last;
+    ASSERT_TRUE(registry.read(UPDATES % 4, last));
+    EXPECT_EQ(last.voltage_mv, UPDATES);
+}
@@ -0,0 +1,304 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include "../include/ModuleSimulator.h"
+#include "../include/PollScheduler.h"
+
+namespace {
+    using Clock = ModuleSimulator::Clock;
+    using std::chrono::milliseconds;
+
+    ModuleSimulator::Config withLatency(Clock::duration latency) {
+        ModuleSimulator::Config config;
+        config.latency = latency;
+        return config;
+    }
+}
+
+class ModuleSimulatorTest : public ::testing::TestWithParam<ProtocolType> {};
+
+TEST_P(ModuleSimulatorTest, AnswersWithParsableTelemetry) {
+    const ProtocolType protocol = GetParam();
+    CanProtocolManager manager(protocol);
+    CanParser parser;
+    ModuleSimulator simulator(protocol, 0x10, 4, withLatency(milliseconds(2)));
+    const Clock::time_point start{};
+
+    const can_frame setup[] = {
+        manager.generateVoltageSet(0x11, 400.0f),
+        manager.generateCurrentSet(0x11, 10.5f),
+        manager.generateHighModeSet(0x11),
+        manager.generateEnable(0x11),
+    };
+    EXPECT_EQ(simulator.receive(setup, 4, start), 4u);
+    const auto module = simulator.state(0x11);
+    ASSERT_TRUE(module);
+    EXPECT_EQ(module->voltage_set_mv, 400000u);
+    EXPECT_EQ(module->current_set_ma, 10500u);
+    EXPECT_EQ(module->mode, ModuleSimulator::Mode::High);
+    EXPECT_TRUE(module->enabled);
+
+    can_frame requests[REQUEST_TYPE_COUNT];
+    ASSERT_EQ(manager.generateRequestRange(RequestType::Voltage, 0x11, 1, requests), 1u);
+    requests[1] = manager.generateCurrentRequest(0x11);
+    requests[2] = manager.generateTempRequest(0x11);
+    requests[3] = manager.generateCurrentCapabilityRequest(0x11);
+    requests[4] = manager.generateFlagsRequest(0x11);
+    EXPECT_EQ(simulator.receive(requests, REQUEST_TYPE_COUNT, start), REQUEST_TYPE_COUNT);
+
+    can_frame responses[8];
+    EXPECT_EQ(simulator.transmit(start + milliseconds(1), responses, 8), 0u);
+    ASSERT_EQ(simulator.nextResponse(), start + milliseconds(2));
+    ASSERT_EQ(simulator.transmit(start + milliseconds(2), responses, 8), REQUEST_TYPE_COUNT);
+
+    ParsedData merged;
+    for (size_t i = 0; i < REQUEST_TYPE_COUNT; ++i) {
+        auto [data, result, detected] = parser.parseAny(responses[i]);
+        ASSERT_EQ(result, ParseResult::OK) << i;
+        EXPECT_EQ(*detected, protocol);
+        EXPECT_EQ(data->address, 0x11);
+        merged.fields |= data->fields;
+        if (data->fields.test(ParsedData::VOLTAGE)) merged.voltage = data->voltage;
+        if (data->fields.test(ParsedData::CURRENT)) merged.current = data->current;
+        if (data->fields.test(ParsedData::TEMP)) merged.temperature = data->temperature;
+        if (data->fields.test(ParsedData::CAPABILITY)) merged.current_capability = data->current_capability;
+        if (data->fields.test(ParsedData::STATUS)) merged.status = data->status;
+    }
+    EXPECT_FLOAT_EQ(merged.voltage, 400.0f);
+    EXPECT_FLOAT_EQ(merged.current, 10.5f);
+    EXPECT_NEAR(merged.temperature, 26, 1);
+    EXPECT_FLOAT_EQ(merged.current_capability, 50.0f);
+    EXPECT_EQ(merged.status, 0u);
+
+    // Disabled output reads zero and sets the off bit
+    const can_frame disable = manager.generateDisable(0x11);
+    simulator.receive(&disable, 1, start);
+    simulator.receive(&requests[0], 1, start);
+    simulator.receive(&requests[4], 1, start);
+    ASSERT_EQ(simulator.transmit(start + milliseconds(2), responses, 8), 2u);
+    EXPECT_FLOAT_EQ(parser.parse(responses[0], protocol).first->voltage, 0.0f);
+    EXPECT_EQ(parser.parse(responses[1], protocol).first->status, 1u);
+}
+
+TEST_P(ModuleSimulatorTest, IgnoresForeignAndOfflineModules) {
+    const ProtocolType protocol = GetParam();
+    CanProtocolManager manager(protocol);
+    ModuleSimulator simulator(protocol, 0x10, 4);
+    const Clock::time_point now{};
+
+    const can_frame outside = manager.generateVoltageRequest(0x20);
+    const can_frame foreign = make_frame(CAN_INV_EFF_FLAG | 0x18FF50E5, 1, 2, 3);
+    EXPECT_EQ(simulator.receive(&outside, 1, now), 0u);
+    EXPECT_EQ(simulator.receive(&foreign, 1, now), 0u);
+
+    // Our own responses on the bus are not requests
+    const can_frame request = manager.generateVoltageRequest(0x12);
+    ASSERT_EQ(simulator.receive(&request, 1, now), 1u);
+    can_frame response;
+    ASSERT_EQ(simulator.transmit(now + milliseconds(5), &response, 1), 1u);
+    EXPECT_EQ(simulator.receive(&response, 1, now), 0u);
+
+    EXPECT_TRUE(simulator.setOnline(0x12, false));
+    EXPECT_FALSE(simulator.setOnline(0x14, false));
+    EXPECT_EQ(simulator.receive(&request, 1, now), 0u);
+    EXPECT_EQ(simulator.pending(), 0u);
+    EXPECT_EQ(simulator.stats().ignored, 4u);
+    EXPECT_FALSE(simulator.state(0x0F));
+}
+
+TEST_P(ModuleSimulatorTest, GroupFramesReachTheWholeGroup) {
+    const ProtocolType protocol = GetParam();
+    CanProtocolManager manager(protocol);
+    ModuleSimulator simulator(protocol, 0, MODULE_ADDRESS_COUNT);
+    const Clock::time_point now{};
+
+    for (uint8_t address = 0; address < MODULE_ADDRESS_COUNT; ++address) {
+        simulator.setGroup(address, address < 64 ? 1 : 2);
+    }
+    simulator.setOnline(10, false);
+
+    // One frame per setting instead of one per module
+    const can_frame broadcast[] = {
+        manager.generateGroupVoltageSet(BROADCAST_GROUP, 400.0f),
+        manager.generateGroupCurrentSet(BROADCAST_GROUP, 20.0f),
+        manager.generateGroupHighModeSet(BROADCAST_GROUP),
+        manager.generateGroupEnable(BROADCAST_GROUP),
+    };
+    EXPECT_EQ(simulator.receive(broadcast, 4, now), 4u);
+    for (uint8_t address = 0; address < MODULE_ADDRESS_COUNT; ++address) {
+        const auto module = simulator.state(address);
+        if (address == 10) {
+            EXPECT_FALSE(module->enabled);
+            continue;
+        }
+        EXPECT_EQ(module->voltage_set_mv, 400000u) << int(address);
+        EXPECT_EQ(module->current_set_ma, 20000u);
+        EXPECT_EQ(module->mode, ModuleSimulator::Mode::High);
+        EXPECT_TRUE(module->enabled);
+    }
+
+    const can_frame second[] = {
+        manager.generateGroupVoltageSet(2, 200.0f),
+        manager.generateGroupDisable(2),
+    };
+    EXPECT_EQ(simulator.receive(second, 2, now), 2u);
+    EXPECT_EQ(simulator.state(63)->voltage_set_mv, 400000u);
+    EXPECT_TRUE(simulator.state(63)->enabled);
+    EXPECT_EQ(simulator.state(64)->voltage_set_mv, 200000u);
+    EXPECT_FALSE(simulator.state(127)->enabled);
+    EXPECT_EQ(simulator.stats().controls, 6u);
+
+    // Point-to-point frames still reach one module, empty groups nobody
+    const can_frame single = manager.generateVoltageSet(64, 300.0f);
+    EXPECT_EQ(simulator.receive(&single, 1, now), 1u);
+    EXPECT_EQ(simulator.state(64)->voltage_set_mv, 300000u);
+    EXPECT_EQ(simulator.state(65)->voltage_set_mv, 200000u);
+    const can_frame empty = manager.generateGroupEnable(5);
+    EXPECT_EQ(simulator.receive(&empty, 1, now), 0u);
+    EXPECT_EQ(simulator.pending(), 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(Protocols, ModuleSimulatorTest,
+                         ::testing::Values(ProtocolType::UUgreen, ProtocolType::MMeet));
+
+TEST(ModuleSimulatorStandaloneTest, DropRateAndJitterAreSeeded) {
+    CanProtocolManager manager(ProtocolType::UUgreen);
+    ModuleSimulator::Config config;
+    config.latency = milliseconds(1);
+    config.jitter = milliseconds(4);
+    config.drop_rate = 0.25;
+    config.seed = 18;
+    ModuleSimulator first(ProtocolType::UUgreen, 0, 128, config);
+    ModuleSimulator second(ProtocolType::UUgreen, 0, 128, config);
+
+    can_frame requests[128];
+    manager.generateRequestRange(RequestType::Voltage, 0, 128, requests);
+    const Clock::time_point now{};
+    for (int round = 0; round < 10; ++round) {
+        first.receive(requests, 128, now);
+        second.receive(requests, 128, now);
+    }
+    const auto stats = first.stats();
+    EXPECT_EQ(stats.requests, 1280u);
+    EXPECT_NEAR(static_cast<double>(stats.dropped), 320.0, 60.0);
+    EXPECT_EQ(first.pending() + stats.dropped, 1280u);
+    EXPECT_EQ(second.stats().dropped, stats.dropped);
+
+    // Responses come out in due order, all within latency + jitter
+    std::vector<can_frame> out(first.pending());
+    EXPECT_EQ(first.transmit(now + milliseconds(1) - Clock::duration(1), out.data(), out.size()), 0u);
+    Clock::time_point last = now;
+    while (auto due = first.nextResponse()) {
+        EXPECT_GE(*due, last);
+        last = *due;
+        first.transmit(*due, out.data(), 1);
+    }
+    EXPECT_LE(last, now + milliseconds(5));
+}
+
+// A full fleet polled through the scheduler, two modules offline
+TEST(ModuleSimulatorStandaloneTest, FleetSweepWithPollScheduler) {
+    ModuleSimulator::Config config;
+    config.latency = milliseconds(3);
+    config.jitter = milliseconds(2);
+    ModuleSimulator simulator(ProtocolType::MMeet, 0, 128, config);
+    simulator.setOnline(5, false);
+    simulator.setOnline(77, false);
+    PollScheduler scheduler(ProtocolType::MMeet, 32, milliseconds(50));
+    CanParser parser;
+    ModuleRegistry registry;
+    ASSERT_EQ(scheduler.enqueueSweep(0, 128), 640u);
+
+    Clock::time_point now{};
+    can_frame frames[64];
+    TelemetryRecord records[64];
+    PollRequest expired[64];
+    size_t timed_out = 0;
+    for (;;) {
+        size_t count = scheduler.nextFrames(now, frames, 64);
+        simulator.receive(frames, count, now);
+        count = simulator.transmit(now, frames, 64);
+        parser.parseRecords(frames, count, ProtocolType::MMeet, records);
+        scheduler.onResponses(records, count);
+        registry.update(records, count);
+        for (size_t n; (n = scheduler.expire(now, expired, 64)) > 0;) {
+            for (size_t i = 0; i < n; ++i) EXPECT_TRUE(expired[i].address == 5 || expired[i].address == 77);
+            timed_out += n;
+        }
+        if (scheduler.idle()) break;
+
+        Clock::time_point next = now + milliseconds(100);
+        if (auto due = simulator.nextResponse()) next = std::min(next, *due);
+        if (auto deadline = scheduler.nextDeadline()) next = std::min(next, *deadline);
+        now = std::max(next, now + std::chrono::microseconds(1));
+    }
+    EXPECT_EQ(timed_out, 2 * REQUEST_TYPE_COUNT);
+    EXPECT_EQ(scheduler.stats().completed, 640u - 2 * REQUEST_TYPE_COUNT);
+    EXPECT_LT(now - Clock::time_point{}, milliseconds(200));
+
+    TelemetryRecord module;
+    ASSERT_TRUE(registry.read(100, module));
+    for (auto field : {ParsedData::VOLTAGE, ParsedData::CURRENT, ParsedData::TEMP,
+                       ParsedData::STATUS, ParsedData::CAPABILITY})
+        EXPECT_TRUE(module.has(field)) << field;
+    EXPECT_FALSE(registry.read(5, module));
+}
+
+#ifdef __linux__
+// Controller and simulated fleet on two ends of a socket
+TEST(ModuleSimulatorStandaloneTest, ServesOverTransport) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+    CanTransport controller(fds[0]);
+    CanTransport bus(fds[1]);
+    ASSERT_TRUE(controller.start());
+    ASSERT_TRUE(bus.start());
+    ModuleSimulator simulator(ProtocolType::UUgreen, 0, 128, withLatency(Clock::duration::zero()));
+
+    CanProtocolManager manager(ProtocolType::UUgreen);
+    can_frame requests[128];
+    manager.generateRequestRange(RequestType::Temp, 0, 128, requests);
+    ASSERT_EQ(controller.send(requests, 128), 128u);
+
+    CanParser parser;
+    TelemetryRecord records[128];
+    size_t received = 0;
+    const auto deadline = Clock::now() + std::chrono::seconds(5);
+    while (received < 128 && Clock::now() < deadline) {
+        simulator.serve(bus, Clock::now());
+        received += controller.receiveRecords(parser, ProtocolType::UUgreen, records + received, 128 - received, 1);
+    }
+    ASSERT_EQ(received, 128u);
+    for (size_t i = 0; i < 128; ++i) {
+        EXPECT_TRUE(records[i].has(ParsedData::TEMP));
+        EXPECT_EQ(records[i].temperature_mdeg, 25000);
+    }
+}
+
+// Responses the full TX queue refuses stay pending and are not counted
+TEST(ModuleSimulatorStandaloneTest, ServeKeepsRefusedResponsesPending) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+    CanTransport controller(fds[0]);
+    CanTransport bus(fds[1]);       // Not started, so nothing drains the TX queue
+    ModuleSimulator simulator(ProtocolType::UUgreen, 0, 128, withLatency(Clock::duration::zero()));
+
+    std::vector<can_frame> filler(CanTransport::QUEUE_CAPACITY - 10);
+    ASSERT_EQ(bus.send(filler.data(), filler.size()), filler.size());
+
+    CanProtocolManager manager(ProtocolType::UUgreen);
+    can_frame requests[128];
+    manager.generateRequestRange(RequestType::Voltage, 0, 128, requests);
+    const auto now = Clock::now();
+    simulator.receive(requests, 128, now);
+
+    EXPECT_EQ(simulator.serve(bus, now), 10u);
+    EXPECT_EQ(simulator.stats().responses, 10u);
+    EXPECT_EQ(simulator.pending(), 118u);
+
+    // Refused responses keep their order: the next one out answers address 10
+    can_frame next;
+    ASSERT_EQ(simulator.transmit(now, &next, 1), 1u);
+    EXPECT_EQ((next.can_id >> 14) & 0x7F, 10u);
+}
+#endif
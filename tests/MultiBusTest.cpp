@@ -0,0 +1,128 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include "../include/ModuleSimulator.h"
+#include "../include/MultiBus.h"
+
+#ifdef __linux__
+#include <chrono>
+#include <sched.h>
+#include <sys/socket.h>
+
+namespace {
+    constexpr size_t BUS_COUNT = 4;
+    constexpr size_t MODULES_PER_BUS = 8;
+
+    // Local transport for the manager, remote transport playing the modules
+    std::unique_ptr<CanTransport> makeBusPair(std::unique_ptr<CanTransport>& remote) {
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) != 0) return nullptr;
+        remote = std::make_unique<CanTransport>(fds[1]);
+        return std::make_unique<CanTransport>(fds[0]);
+    }
+
+    // Responses of every module of a simulated fleet, current set to 1 A per bus index + 1
+    size_t fleetResponses(ProtocolType protocol, size_t bus, can_frame* frames) {
+        CanProtocolManager manager(protocol);
+        ModuleSimulator::Config config;
+        config.latency = ModuleSimulator::Clock::duration::zero();
+        ModuleSimulator fleet(protocol, 0, MODULES_PER_BUS, config);
+        const ModuleSimulator::Clock::time_point now{};
+
+        for (uint8_t address = 0; address < MODULES_PER_BUS; ++address) {
+            const can_frame setup[] = {
+                manager.generateVoltageSet(address, Millivolts{400000}),
+                manager.generateCurrentSet(address, Milliamps{static_cast<uint32_t>(1000 * (bus + 1))}),
+                manager.generateEnable(address),
+                manager.generateVoltageRequest(address),
+                manager.generateCurrentRequest(address),
+            };
+            fleet.receive(setup, 5, now);
+        }
+        return fleet.transmit(now, frames, 2 * MODULES_PER_BUS);
+    }
+
+    bool waitForFrames(const MultiBusManager& buses, size_t bus, uint64_t frames) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (buses.stats(bus).frames < frames) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+}
+
+TEST(MultiBusTest, IngestsEveryBusIntoItsOwnShard) {
+    MultiBusManager buses;
+    std::unique_ptr<CanTransport> remotes[BUS_COUNT];
+    for (size_t bus = 0; bus < BUS_COUNT; ++bus) {
+        const ProtocolType protocol = bus % 2 ? ProtocolType::MMeet : ProtocolType::UUgreen;
+        ASSERT_EQ(buses.addBus(makeBusPair(remotes[bus]), protocol), static_cast<int>(bus));
+        ASSERT_TRUE(remotes[bus]->start());
+    }
+    ASSERT_TRUE(buses.start());
+    std::unique_ptr<CanTransport> spare;
+    EXPECT_EQ(buses.addBus(makeBusPair(spare), ProtocolType::UUgreen), -1);  // Fixed while running
+
+    for (size_t bus = 0; bus < BUS_COUNT; ++bus) {
+        can_frame frames[2 * MODULES_PER_BUS];
+        const size_t count = fleetResponses(buses.protocol(bus), bus, frames);
+        ASSERT_EQ(count, 2 * MODULES_PER_BUS);
+        EXPECT_EQ(remotes[bus]->send(frames, count), count);
+    }
+    for (size_t bus = 0; bus < BUS_COUNT; ++bus) {
+        ASSERT_TRUE(waitForFrames(buses, bus, 2 * MODULES_PER_BUS)) << "bus " << bus;
+        EXPECT_EQ(buses.stats(bus).rejected, 0u);
+
+        const MultiBusManager::Totals totals = buses.totals(bus);
+        EXPECT_EQ(totals.modules, MODULES_PER_BUS);
+        EXPECT_EQ(totals.current_ma, MODULES_PER_BUS * 1000 * (bus + 1));
+        EXPECT_EQ(totals.power_mw, MODULES_PER_BUS * 400 * 1000 * (bus + 1));
+
+        TelemetryRecord record;
+        ASSERT_TRUE(buses.read(bus, MODULES_PER_BUS - 1, record));
+        EXPECT_EQ(record.voltage_mv, 400000u);
+        EXPECT_EQ(record.current_ma, 1000 * (bus + 1));
+        EXPECT_FALSE(buses.read(bus, MODULES_PER_BUS, record));
+    }
+
+    const MultiBusManager::Totals totals = buses.totals();
+    EXPECT_EQ(totals.modules, BUS_COUNT * MODULES_PER_BUS);
+    EXPECT_EQ(totals.current_ma, MODULES_PER_BUS * 1000 * (1 + 2 + 3 + 4));
+    EXPECT_EQ(buses.transport(0).receive(nullptr, 0), 0u);  // Nothing left in the RX queue
+    buses.stop();
+}
+
+TEST(MultiBusTest, CountsFramesOfOtherProtocols) {
+    MultiBusManager buses;
+    std::unique_ptr<CanTransport> remote;
+    ASSERT_EQ(buses.addBus(makeBusPair(remote), ProtocolType::MMeet), 0);
+    ASSERT_TRUE(remote->start());
+    ASSERT_TRUE(buses.start());
+
+    can_frame frames[2 * MODULES_PER_BUS];
+    const size_t count = fleetResponses(ProtocolType::UUgreen, 0, frames);
+    EXPECT_EQ(remote->send(frames, count), count);
+    ASSERT_TRUE(waitForFrames(buses, 0, count));
+    EXPECT_EQ(buses.stats(0).rejected, count);
+    EXPECT_EQ(buses.totals().modules, 0u);
+}
+
+TEST(MultiBusTest, PinsIoThreads) {
+    MultiBusManager buses;
+    std::unique_ptr<CanTransport> remotes[2];
+    ASSERT_EQ(buses.addBus(makeBusPair(remotes[0]), ProtocolType::UUgreen, 0), 0);
+    ASSERT_TRUE(buses.start());
+    EXPECT_TRUE(buses.transport(0).isRunning());
+    buses.stop();
+    EXPECT_FALSE(buses.transport(0).isRunning());
+
+    // A CPU that cannot exist fails the whole start
+    ASSERT_EQ(buses.addBus(makeBusPair(remotes[1]), ProtocolType::UUgreen, CPU_SETSIZE), 1);
+    EXPECT_FALSE(buses.start());
+    EXPECT_FALSE(buses.isRunning());
+    EXPECT_FALSE(buses.transport(0).isRunning());
+    EXPECT_EQ(buses.addBus(nullptr, ProtocolType::UUgreen), -1);
+    EXPECT_EQ(buses.open("nonexistent_can", ProtocolType::UUgreen), -1);
+}
+
+#endif
@@ -0,0 +1,160 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include <vector>
+#include "../include/PollScheduler.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+    // Module side: answer a request frame with the matching telemetry command
+    can_frame answer(const can_frame& request, ProtocolType protocol) {
+        can_frame response = request;
+        if (protocol == ProtocolType::UUgreen) {
+            response.can_id = UUGREEN_MASK | (request.can_id & 0x1FC000);
+        } else {
+            const uint32_t address = (request.can_id >> 11) & 0x7F;
+            response.can_id = MMEET_ID | (address << 3);
+        }
+        response.data[7] = 0x42;
+        return response;
+    }
+
+    uint8_t request_address(const can_frame& request, ProtocolType protocol) {
+        return static_cast<uint8_t>(protocol == ProtocolType::UUgreen ? (request.can_id >> 14) & 0x7F
+                                                                      : (request.can_id >> 11) & 0x7F);
+    }
+}
+
+TEST(PollSchedulerTest, KeepsWindowOfRequestsInFlight) {
+    PollScheduler scheduler(ProtocolType::UUgreen, 4, 100ms);
+    const auto now = PollScheduler::Clock::time_point{};
+    EXPECT_EQ(scheduler.enqueueSweep(0, 2), 2 * REQUEST_TYPE_COUNT);
+    EXPECT_FALSE(scheduler.enqueue({0, RequestType::Voltage}));  // already pending
+
+    can_frame frames[16];
+    EXPECT_EQ(scheduler.nextFrames(now, frames, 16), 4u);
+    EXPECT_EQ(scheduler.inFlight(), 4u);
+    EXPECT_EQ(scheduler.nextFrames(now, frames, 16), 0u);
+    EXPECT_FALSE(scheduler.enqueue({0, RequestType::Temp}));      // in flight
+
+    // Request frames come from the generator tables
+    CanProtocolManager manager(ProtocolType::UUgreen);
+    const can_frame expected = manager.generateTempRequest(0);
+    EXPECT_EQ(std::memcmp(&frames[0], &expected, sizeof(can_frame)), 0);
+
+    const auto done = scheduler.onResponse(answer(frames[0], ProtocolType::UUgreen));
+    ASSERT_TRUE(done);
+    EXPECT_EQ(done->address, 0);
+    EXPECT_EQ(done->request, RequestType::Temp);
+    EXPECT_EQ(scheduler.inFlight(), 3u);
+    EXPECT_FALSE(scheduler.onResponse(answer(frames[0], ProtocolType::UUgreen)));  // duplicate
+    EXPECT_EQ(scheduler.stats().unmatched, 1u);
+
+    EXPECT_EQ(scheduler.nextFrames(now, frames, 16), 1u);
+}
+
+TEST(PollSchedulerTest, MatchesAlternativeResponseCommand) {
+    PollScheduler scheduler(ProtocolType::UUgreen, 8, 100ms);
+    ASSERT_TRUE(scheduler.enqueue({0x21, RequestType::Voltage}));
+    can_frame frame;
+    ASSERT_EQ(scheduler.nextFrames({}, &frame, 1), 1u);
+
+    can_frame response = answer(frame, ProtocolType::UUgreen);
+    response.data[1] = UUgreenConstants::VOLTAGE_ALT_CMD;
+    const auto done = scheduler.onResponse(response);
+    ASSERT_TRUE(done);
+    EXPECT_EQ(done->address, 0x21);
+    EXPECT_TRUE(scheduler.idle());
+}
+
+TEST(PollSchedulerTest, ExpiresUnansweredRequests) {
+    PollScheduler scheduler(ProtocolType::MMeet, 8, 100ms);
+    const auto start = PollScheduler::Clock::time_point{};
+    scheduler.enqueue({0x05, RequestType::Voltage});
+    scheduler.enqueue({0x06, RequestType::Current});
+    can_frame frames[2];
+    ASSERT_EQ(scheduler.nextFrames(start, frames, 2), 2u);
+    ASSERT_TRUE(scheduler.onResponse(answer(frames[1], ProtocolType::MMeet)));
+
+    EXPECT_EQ(scheduler.nextDeadline(), start + 100ms);
+    PollRequest timed_out[4];
+    EXPECT_EQ(scheduler.expire(start + 99ms, timed_out, 4), 0u);
+    ASSERT_EQ(scheduler.expire(start + 100ms, timed_out, 4), 1u);
+    EXPECT_EQ(timed_out[0].address, 0x05);
+    EXPECT_EQ(timed_out[0].request, RequestType::Voltage);
+    EXPECT_FALSE(scheduler.nextDeadline());
+    EXPECT_TRUE(scheduler.idle());
+
+    // A late answer no longer matches, the request can be queued again
+    EXPECT_FALSE(scheduler.onResponse(answer(frames[0], ProtocolType::MMeet)));
+    EXPECT_TRUE(scheduler.enqueue({0x05, RequestType::Voltage}));
+}
+
+// Simulated sweep: 1 ms per frame on the bus, 5 ms module turnaround, 10 modules offline
+TEST(PollSchedulerTest, PipelinedSweepIsBandwidthBound) {
+    const auto frame_time = 1ms;
+    const auto turnaround = 5ms;
+    const auto timeout = 100ms;
+
+    auto sweep = [&](size_t window) {
+        PollScheduler scheduler(ProtocolType::UUgreen, window, timeout);
+        scheduler.enqueueSweep(0, MODULE_ADDRESS_COUNT);
+        auto now = PollScheduler::Clock::time_point{};
+        std::vector<std::pair<PollScheduler::Clock::time_point, can_frame>> answers;
+        can_frame frames[MODULE_ADDRESS_COUNT];
+        PollRequest timed_out[MODULE_ADDRESS_COUNT];
+
+        while (!scheduler.idle()) {
+            const size_t issued = scheduler.nextFrames(now, frames, MODULE_ADDRESS_COUNT);
+            for (size_t i = 0; i < issued; ++i) {
+                now += frame_time;
+                if (request_address(frames[i], ProtocolType::UUgreen) % 13 != 0) {
+                    answers.push_back({now + turnaround, answer(frames[i], ProtocolType::UUgreen)});
+                }
+            }
+            // Advance to the next event: an answer or a deadline
+            auto next = scheduler.nextDeadline().value_or(PollScheduler::Clock::time_point::max());
+            for (const auto& pending : answers) next = std::min(next, pending.first);
+            if (issued == 0 && next != PollScheduler::Clock::time_point::max()) now = std::max(now, next);
+
+            for (auto it = answers.begin(); it != answers.end();) {
+                if (it->first <= now) {
+                    EXPECT_TRUE(scheduler.onResponse(it->second));
+                    it = answers.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            scheduler.expire(now, timed_out, MODULE_ADDRESS_COUNT);
+        }
+        EXPECT_EQ(scheduler.stats().completed + scheduler.stats().timed_out, PollScheduler::KEY_COUNT);
+        EXPECT_EQ(scheduler.stats().timed_out, 10u * REQUEST_TYPE_COUNT);
+        return now;
+    };
+
+    const auto stop_and_wait = sweep(1);
+    const auto pipelined = sweep(16);
+    // Stop-and-wait pays every turnaround and timeout in series
+    EXPECT_GT(stop_and_wait - PollScheduler::Clock::time_point{}, 8s);
+    // Pipelined sweep is close to 640 frames x 1 ms of bus time
+    EXPECT_LT(pipelined - PollScheduler::Clock::time_point{}, 800ms);
+}
+
+TEST(PollSchedulerTest, BatchResponsesAndDiscardedTimeouts) {
+    PollScheduler scheduler(ProtocolType::UUgreen, 64, 10ms);
+    const auto start = PollScheduler::Clock::time_point{};
+    scheduler.enqueueSweep(0, 4);
+    can_frame frames[32];
+    const size_t issued = scheduler.nextFrames(start, frames, 32);
+    ASSERT_EQ(issued, 4 * REQUEST_TYPE_COUNT);
+
+    CanParser parser;
+    TelemetryRecord records[32];
+    for (size_t i = 0; i < issued; ++i) frames[i] = answer(frames[i], ProtocolType::UUgreen);
+    parser.parseRecords(frames, issued / 2, ProtocolType::UUgreen, records);
+    EXPECT_EQ(scheduler.onResponses(records, issued / 2), issued / 2);
+
+    EXPECT_EQ(scheduler.expire(start + 10ms, nullptr, 0), 0u);
+    EXPECT_EQ(scheduler.stats().timed_out, issued - issued / 2);
+    EXPECT_TRUE(scheduler.idle());
+}
@@ -0,0 +1,143 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include <cstring>
+#include "../include/SetpointCache.h"
+#include "../include/ModuleSimulator.h"
+
+namespace {
+    using Clock = SetpointCache::Clock;
+    using std::chrono::milliseconds;
+    using std::chrono::seconds;
+}
+
+class SetpointCacheTest : public ::testing::TestWithParam<ProtocolType> {};
+
+TEST_P(SetpointCacheTest, SuppressesAndCoalesces) {
+    const ProtocolType protocol = GetParam();
+    SetpointCache cache(protocol, seconds(1));
+    CanProtocolManager manager(protocol);
+    const Clock::time_point start{};
+    can_frame frames[8];
+
+    EXPECT_TRUE(cache.setVoltage(3, 400.0f));
+    EXPECT_TRUE(cache.setCurrent(3, 10.0f));
+    ASSERT_EQ(cache.flush(start, frames, 8), 2u);
+    const can_frame expected = manager.generateVoltageSet(3, 400.0f);
+    EXPECT_EQ(std::memcmp(&frames[0], &expected, sizeof(can_frame)), 0);
+
+    // Same encoded value, including float noise below 1 mV
+    EXPECT_FALSE(cache.setVoltage(3, 400.0f));
+    EXPECT_FALSE(cache.setVoltage(3, 400.0001f));
+    EXPECT_FALSE(cache.setCurrent(3, 10.0f));
+    EXPECT_EQ(cache.flush(start + milliseconds(20), frames, 8), 0u);
+
+    // Several updates in one tick, only the latest goes out
+    cache.setVoltage(3, 401.0f);
+    cache.setVoltage(3, 402.0f);
+    cache.setVoltage(3, 403.5f);
+    EXPECT_EQ(cache.dirty(), 1u);
+    ASSERT_EQ(cache.flush(start + milliseconds(40), frames, 8), 1u);
+    const can_frame latest = manager.generateVoltageSet(3, 403.5f);
+    EXPECT_EQ(std::memcmp(&frames[0], &latest, sizeof(can_frame)), 0);
+
+    // Changed and changed back before the flush: the bus already has it
+    cache.setCurrent(3, 11.0f);
+    cache.setCurrent(3, 10.0f);
+    EXPECT_EQ(cache.dirty(), 0u);
+    EXPECT_EQ(cache.flush(start + milliseconds(60), frames, 8), 0u);
+
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.updates, 10u);
+    EXPECT_EQ(stats.suppressed, 3u);
+    EXPECT_EQ(stats.coalesced, 3u);
+    EXPECT_EQ(stats.sent, 3u);
+    EXPECT_EQ(stats.refreshed, 0u);
+}
+
+TEST_P(SetpointCacheTest, RefreshesAndInvalidates) {
+    const ProtocolType protocol = GetParam();
+    SetpointCache cache(protocol, seconds(1));
+    const Clock::time_point start{};
+    can_frame frames[8];
+
+    cache.setVoltage(1, 48.0f);
+    cache.setVoltage(2, 48.0f);
+    ASSERT_EQ(cache.flush(start, frames, 1), 1u);               // No room: module 2 waits
+    ASSERT_EQ(cache.flush(start + milliseconds(500), frames, 8), 1u);
+    EXPECT_FALSE(cache.lastSent(1, SetpointCache::Setpoint::Current));
+    ASSERT_TRUE(cache.lastSent(2, SetpointCache::Setpoint::Voltage));
+
+    EXPECT_EQ(cache.flush(start + milliseconds(999), frames, 8), 0u);
+    ASSERT_EQ(cache.flush(start + seconds(1), frames, 8), 1u);  // Module 1 refresh
+    ASSERT_EQ(cache.flush(start + milliseconds(1500), frames, 8), 1u);
+    EXPECT_EQ(cache.stats().refreshed, 2u);
+
+    // A module back from a restart gets its setpoints at once
+    cache.invalidate(2);
+    EXPECT_FALSE(cache.lastSent(2, SetpointCache::Setpoint::Voltage));
+    EXPECT_EQ(cache.dirty(), 1u);
+    EXPECT_EQ(cache.flush(start + milliseconds(1520), frames, 8), 1u);
+    cache.invalidateAll();
+    EXPECT_EQ(cache.flush(start + milliseconds(1540), frames, 8), 2u);
+}
+
+// Refreshes skipped for lack of room, or re-armed by a setpoint changed back, are not lost
+TEST_P(SetpointCacheTest, KeepsRefreshDeadlines) {
+    const ProtocolType protocol = GetParam();
+    SetpointCache cache(protocol, seconds(1));
+    const Clock::time_point start{};
+    can_frame frames[8];
+
+    cache.setVoltage(1, 48.0f);
+    cache.setVoltage(2, 48.0f);
+    cache.setVoltage(7, 48.0f);
+    ASSERT_EQ(cache.flush(start, frames, 8), 3u);
+    ASSERT_EQ(cache.flush(start + seconds(1), frames, 1), 1u);
+    ASSERT_EQ(cache.flush(start + milliseconds(1001), frames, 8), 2u);
+    EXPECT_EQ(cache.flush(start + milliseconds(1002), frames, 8), 0u);
+
+    // Module 7 changes and the flush has room for module 6 only
+    cache.setVoltage(7, 50.0f);
+    cache.setVoltage(6, 48.0f);
+    ASSERT_EQ(cache.flush(start + milliseconds(1900), frames, 1), 1u);
+    EXPECT_EQ(cache.dirty(), 1u);
+
+    // Back to the value sent at 1.001 s: refreshed from then, not from 2.9 s
+    EXPECT_FALSE(cache.setVoltage(7, 48.0f));
+    EXPECT_EQ(cache.flush(start + milliseconds(1950), frames, 8), 0u);
+    ASSERT_EQ(cache.flush(start + milliseconds(2001), frames, 8), 3u);
+    EXPECT_EQ(cache.stats().refreshed, 6u);
+}
+
+INSTANTIATE_TEST_SUITE_P(Protocols, SetpointCacheTest,
+                         ::testing::Values(ProtocolType::UUgreen, ProtocolType::MMeet));
+
+// 50 Hz control loop over a full bus for 10 s: two modules ramp, the rest hold
+TEST(SetpointCacheStandaloneTest, SteadyStateBusLoad) {
+    SetpointCache cache(ProtocolType::UUgreen, seconds(1));
+    ModuleSimulator fleet(ProtocolType::UUgreen, 0, MODULE_ADDRESS_COUNT);
+    const Clock::time_point start{};
+    can_frame frames[2 * MODULE_ADDRESS_COUNT];
+    size_t cached_frames = 0;
+    size_t raw_frames = 0;
+
+    for (int tick = 0; tick < 500; ++tick) {
+        const Clock::time_point now = start + milliseconds(20) * tick;
+        for (uint8_t address = 0; address < MODULE_ADDRESS_COUNT; ++address) {
+            const float ramp = address < 2 ? 0.1f * static_cast<float>(tick) : 0.0f;
+            cache.setVoltage(address, 400.0f + ramp);
+            cache.setCurrent(address, 20.0f);
+            raw_frames += 2;
+        }
+        const size_t count = cache.flush(now, frames, 2 * MODULE_ADDRESS_COUNT);
+        fleet.receive(frames, count, now);
+        cached_frames += count;
+    }
+    EXPECT_LT(cached_frames * 10, raw_frames);
+
+    // The modules still end up with the latest setpoints
+    EXPECT_EQ(fleet.state(0)->voltage_set_mv, static_cast<uint32_t>((400.0f + 49.9f) * 1000));
+    EXPECT_EQ(fleet.state(100)->voltage_set_mv, 400000u);
+    EXPECT_EQ(fleet.state(100)->current_set_ma, 20000u);
+    EXPECT_EQ(fleet.stats().controls, cached_frames);
+}
@@ -0,0 +1,14 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#pragma once
+#include "../libmodul.h"
+
+// Frames as the modules send them, shared by the tests
+
+inline canid_t uugreenResponseId(uint8_t address) {
+    return CAN_INV_EFF_FLAG | UUGREEN_MASK | uint32_t(address & UUgreenConstants::MAX_ADDRESS) << 14;
+}
+
+inline can_frame uugreenResponse(uint8_t address, uint8_t command, uint32_t raw) {
+    return make_frame(uugreenResponseId(address), UUgreenConstants::PREAMBLE, command, 0, 0,
+                      byte_of(raw, 24), byte_of(raw, 16), byte_of(raw, 8), byte_of(raw, 0));
+}
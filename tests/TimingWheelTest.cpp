@@ -0,0 +1,123 @@
+/* MIT License Copyright (c) 2025 SmartElectroni*/
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "../include/TimingWheel.h"
+
+using namespace std::chrono_literals;
+using TimePoint = TimingWheel::Clock::time_point;
+
+TEST(TimingWheelTest, ExpiresAtDeadlineNotBefore) {
+    TimingWheel wheel(1ms, 16);
+    const TimePoint start{};
+    wheel.arm(start + 5ms, 1);
+    wheel.arm(start + 5500us, 2);
+    wheel.arm(start + 40ms, 3);     // beyond one revolution
+    EXPECT_EQ(wheel.size(), 3u);
+    EXPECT_EQ(wheel.nextDeadline(), start + 5ms);
+
+    std::vector<uint32_t> fired;
+    auto record = [&](uint32_t tag, TimePoint) { fired.push_back(tag); };
+    EXPECT_EQ(wheel.advance(start + 4ms, record), 0u);
+    EXPECT_EQ(wheel.advance(start + 5ms, record), 1u);
+    EXPECT_EQ(wheel.advance(start + 5999us, record), 0u);  // 5.5 ms rounds up to tick 6
+    EXPECT_EQ(wheel.advance(start + 6ms, record), 1u);
+    EXPECT_EQ(wheel.nextDeadline(), start + 40ms);
+    EXPECT_EQ(wheel.advance(start + 39ms, record), 0u);
+    EXPECT_EQ(wheel.advance(start + 40ms, record), 1u);
+    EXPECT_EQ(fired, (std::vector<uint32_t>{1, 2, 3}));
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_FALSE(wheel.nextDeadline());
+}
+
+TEST(TimingWheelTest, CancelAndReuse) {
+    TimingWheel wheel(1ms, 8);
+    const TimePoint start{};
+    const auto first = wheel.arm(start + 3ms, 1);
+    const auto second = wheel.arm(start + 3ms, 2);
+    EXPECT_TRUE(wheel.cancel(first));
+    EXPECT_FALSE(wheel.cancel(first));
+    EXPECT_FALSE(wheel.cancel(TimingWheel::INVALID_TIMER));
+
+    // The freed node is reused, the stale id must not cancel the new timer
+    const auto third = wheel.arm(start + 3ms, 3);
+    EXPECT_NE(third, first);
+    EXPECT_FALSE(wheel.cancel(first));
+
+    std::vector<uint32_t> fired;
+    wheel.advance(start + 3ms, [&](uint32_t tag, TimePoint) { fired.push_back(tag); });
+    EXPECT_EQ(fired.size(), 2u);
+    EXPECT_FALSE(wheel.cancel(second));
+    EXPECT_FALSE(wheel.cancel(third));
+}
+
+TEST(TimingWheelTest, LongGapAndPastDeadlines) {
+    TimingWheel wheel(1ms, 8);
+    const TimePoint start{};
+    for (uint32_t i = 0; i < 100; ++i) wheel.arm(start + std::chrono::milliseconds(i), i);
+    size_t fired = 0;
+    EXPECT_EQ(wheel.advance(start + 1s, [&](uint32_t, TimePoint) { ++fired; }), 100u);
+    EXPECT_EQ(fired, 100u);
+
+    // Deadline already passed: fires on the next tick
+    wheel.arm(start + 10ms, 7);
+    EXPECT_EQ(wheel.advance(start + 1s, [](uint32_t, TimePoint) {}), 0u);
+    EXPECT_EQ(wheel.advance(start + 1001ms, [](uint32_t, TimePoint) {}), 1u);
+}
+
+TEST(TimingWheelTest, CallbackMayArmAndCancel) {
+    TimingWheel wheel(1ms, 8);
+    const TimePoint start{};
+    TimingWheel::TimerId victim = 0;
+    wheel.arm(start + 1ms, 1);
+    victim = wheel.arm(start + 1ms, 2);
+    size_t fired = 0;
+    wheel.advance(start + 1ms, [&](uint32_t tag, TimePoint) {
+        ++fired;
+        if (tag == 1) {
+            wheel.cancel(victim);   // already collected: keeps firing
+            wheel.arm(start + 9ms, 3);
+        }
+    });
+    EXPECT_EQ(fired, 2u);
+    EXPECT_EQ(wheel.size(), 1u);
+    EXPECT_EQ(wheel.nextDeadline(), start + 9ms);
+}
+
+TEST(TimingWheelTest, MatchesReferenceUnderRandomLoad) {
+    TimingWheel wheel(100us, 64);
+    std::mt19937 random(7);
+    TimePoint now{};
+    std::vector<std::pair<TimingWheel::TimerId, TimePoint>> armed(1000);
+    std::vector<bool> live(armed.size(), false);
+
+    for (int step = 0; step < 20000; ++step) {
+        const uint32_t tag = random() % armed.size();
+        if (live[tag] && random() % 2) {
+            EXPECT_TRUE(wheel.cancel(armed[tag].first));
+            live[tag] = false;
+        } else if (!live[tag]) {
+            const TimePoint deadline = now + std::chrono::microseconds(random() % 20000);
+            armed[tag] = {wheel.arm(deadline, tag), deadline};
+            live[tag] = true;
+        }
+        now += std::chrono::microseconds(random() % 50);
+        wheel.advance(now, [&](uint32_t expired, TimePoint deadline) {
+            ASSERT_TRUE(live[expired]);
+            EXPECT_EQ(deadline, armed[expired].second);
+            EXPECT_LE(deadline, now);
+            EXPECT_GT(deadline + wheel.tick() + 50us, now);   // at most a tick plus one step late
+            live[expired] = false;
+        });
+    }
+}
+
+TEST(TimingWheelTest, NextExpiryIsTickBoundary) {
+    TimingWheel wheel(2ms, 8);
+    const TimePoint start{};
+    wheel.arm(start + 3ms, 1);
+    EXPECT_EQ(wheel.nextDeadline(), start + 3ms);
+    EXPECT_EQ(wheel.nextExpiry(), start + 4ms);
+    EXPECT_EQ(wheel.advance(start + 3ms, [](uint32_t, TimePoint) {}), 0u);
+    EXPECT_EQ(wheel.advance(*wheel.nextExpiry(), [](uint32_t, TimePoint) {}), 1u);
+}